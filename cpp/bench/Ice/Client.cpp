@@ -0,0 +1,416 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Bench.h>
+#include <PerfI.h>
+#include <Histogram.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+using namespace Bench;
+
+//
+// The benchmark client runs each of the configured invocation modes over
+// each of the configured transports and prints one result per line, either
+// as a JSON object (the default) or as text:
+//
+// --Bench.Transports   tcp ws ssl udp collocated (ssl requires IceSSL.CertFile)
+// --Bench.Modes        twoway oneway batch ami sequence contention
+// --Bench.Iterations   number of recorded invocations (default 10000)
+// --Bench.Warmup       number of invocations before recording (default 1000)
+// --Bench.BatchSize    number of batch oneway requests per flush (default 100)
+// --Bench.Window       maximum number of outstanding AMI requests (default 64)
+// --Bench.SequenceSize byte sequence size of the sequence mode (default 1MB)
+// --Bench.SequenceIterations number of sequence invocations (default 500)
+// --Bench.Threads      number of threads of the contention mode (default 64)
+// --Bench.Output       json or text
+// --Bench.Label        label added to each result (default none)
+// --Bench.Shutdown     shutdown the server once done (default 1)
+//
+// Latencies are in microseconds. The batch mode records the latency of a
+// whole batch, from the first queued request to the flush completion. The
+// contention mode sends twoway requests from many threads over the same
+// connection.
+//
+
+namespace
+{
+
+Ice::Long
+now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class Runner
+{
+public:
+
+    Runner(const Ice::PropertiesPtr& properties) :
+        _batchSize(max(properties->getPropertyAsIntWithDefault("Bench.BatchSize", 100), 1)),
+        _window(max(properties->getPropertyAsIntWithDefault("Bench.Window", 64), 1)),
+        _sequenceSize(max(properties->getPropertyAsIntWithDefault("Bench.SequenceSize", 1024 * 1024), 0)),
+        _threads(max(properties->getPropertyAsIntWithDefault("Bench.Threads", 64), 1))
+    {
+    }
+
+    void
+    run(const string& transport, const string& mode, const PerfPrxPtr& perf, int count, Histogram& histogram)
+    {
+        if(mode == "twoway")
+        {
+            twoway(perf, count, histogram);
+        }
+        else if(mode == "oneway")
+        {
+            oneway(transport, perf, count, histogram);
+        }
+        else if(mode == "batch")
+        {
+            batch(transport, perf, count, histogram);
+        }
+        else if(mode == "ami")
+        {
+            ami(perf, count, histogram);
+        }
+        else if(mode == "sequence")
+        {
+            sequence(perf, count, histogram);
+        }
+        else if(mode == "contention")
+        {
+            contention(perf, count, histogram);
+        }
+        else
+        {
+            throw invalid_argument("unknown benchmark mode `" + mode + "'");
+        }
+    }
+
+    int
+    size(const string& mode) const
+    {
+        return mode == "sequence" ? _sequenceSize : 0;
+    }
+
+private:
+
+    void
+    twoway(const PerfPrxPtr& perf, int count, Histogram& histogram)
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            Ice::Long start = now();
+            perf->ping();
+            histogram.record(now() - start);
+        }
+    }
+
+    void
+    oneway(const string& transport, const PerfPrxPtr& perf, int count, Histogram& histogram)
+    {
+        PerfPrxPtr p = transport == "udp" ? perf->ice_datagram() : perf->ice_oneway();
+        for(int i = 0; i < count; ++i)
+        {
+            Ice::Long start = now();
+            p->ping();
+            histogram.record(now() - start);
+        }
+        sync(transport, perf);
+    }
+
+    void
+    batch(const string& transport, const PerfPrxPtr& perf, int count, Histogram& histogram)
+    {
+        PerfPrxPtr p = transport == "udp" ? perf->ice_batchDatagram() : perf->ice_batchOneway();
+        Ice::Long start = now();
+        for(int i = 0; i < count; ++i)
+        {
+            p->ping();
+            if((i + 1) % _batchSize == 0 || i + 1 == count)
+            {
+                p->ice_flushBatchRequests();
+                Ice::Long end = now();
+                histogram.record(end - start);
+                start = end;
+            }
+        }
+        sync(transport, perf);
+    }
+
+    void
+    ami(const PerfPrxPtr& perf, int count, Histogram& histogram)
+    {
+        mutex m;
+        condition_variable cond;
+        int outstanding = 0;
+        exception_ptr error;
+        for(int i = 0; i < count; ++i)
+        {
+            {
+                unique_lock<mutex> lock(m);
+                cond.wait(lock, [&] { return outstanding < _window; });
+                ++outstanding;
+            }
+
+            Ice::Long start = now();
+            perf->pingAsync(
+                [&, start]()
+                {
+                    Ice::Long end = now();
+                    lock_guard<mutex> lock(m);
+                    histogram.record(end - start);
+                    --outstanding;
+                    cond.notify_one();
+                },
+                [&](exception_ptr ex)
+                {
+                    lock_guard<mutex> lock(m);
+                    error = ex;
+                    --outstanding;
+                    cond.notify_one();
+                });
+        }
+
+        unique_lock<mutex> lock(m);
+        cond.wait(lock, [&] { return outstanding == 0; });
+        if(error)
+        {
+            rethrow_exception(error);
+        }
+    }
+
+    void
+    sequence(const PerfPrxPtr& perf, int count, Histogram& histogram)
+    {
+        ByteSeq seq(static_cast<size_t>(_sequenceSize));
+        pair<const Ice::Byte*, const Ice::Byte*> bytes(seq.data(), seq.data() + seq.size());
+        for(int i = 0; i < count; ++i)
+        {
+            Ice::Long start = now();
+            perf->sendBytes(bytes);
+            histogram.record(now() - start);
+        }
+    }
+
+    void
+    contention(const PerfPrxPtr& perf, int count, Histogram& histogram)
+    {
+        vector<Histogram> histograms(static_cast<size_t>(_threads));
+        vector<exception_ptr> errors(static_cast<size_t>(_threads));
+        vector<thread> threads;
+        for(int t = 0; t < _threads; ++t)
+        {
+            int n = count / _threads + (t < count % _threads ? 1 : 0);
+            size_t i = static_cast<size_t>(t);
+            threads.push_back(thread([&, n, i]()
+                                     {
+                                         try
+                                         {
+                                             twoway(perf, n, histograms[i]);
+                                         }
+                                         catch(...)
+                                         {
+                                             errors[i] = current_exception();
+                                         }
+                                     }));
+        }
+        for(size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+        for(size_t i = 0; i < histograms.size(); ++i)
+        {
+            if(errors[i])
+            {
+                rethrow_exception(errors[i]);
+            }
+            histogram.add(histograms[i]);
+        }
+    }
+
+    void
+    sync(const string& transport, const PerfPrxPtr& perf)
+    {
+        //
+        // Wait for the server to process the oneway requests, twoway requests
+        // are dispatched in order over the same connection. This isn't possible
+        // with UDP.
+        //
+        if(transport != "udp")
+        {
+            perf->ice_ping();
+        }
+    }
+
+    const int _batchSize;
+    const int _window;
+    const int _sequenceSize;
+    const int _threads;
+};
+
+void
+report(bool json, const string& label, const string& transport, const string& mode, int size, Ice::Long operations,
+       Ice::Long duration, const Histogram& histogram)
+{
+    double seconds = static_cast<double>(duration) / 1000000000.0;
+    double opsPerSecond = seconds > 0 ? static_cast<double>(operations) / seconds : 0.0;
+    const double percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+    const char* names[] = { "p50", "p90", "p99", "p999" };
+
+    ostringstream os;
+    os << fixed << setprecision(3);
+    if(json)
+    {
+        os << "{";
+        if(!label.empty())
+        {
+            os << "\"label\":\"" << label << "\",";
+        }
+        os << "\"transport\":\"" << transport << "\",\"mode\":\"" << mode << "\",\"size\":" << size
+           << ",\"operations\":" << operations << ",\"seconds\":" << seconds
+           << ",\"opsPerSecond\":" << opsPerSecond << ",\"latency\":{\"unit\":\"us\",\"count\":" << histogram.count()
+           << ",\"min\":" << histogram.min() / 1000.0 << ",\"mean\":" << histogram.mean() / 1000.0;
+        for(size_t i = 0; i < sizeof(percentiles) / sizeof(double); ++i)
+        {
+            os << ",\"" << names[i] << "\":" << histogram.valueAtPercentile(percentiles[i]) / 1000.0;
+        }
+        os << ",\"max\":" << histogram.max() / 1000.0 << "}}";
+    }
+    else
+    {
+        if(!label.empty())
+        {
+            os << setw(12) << left << label;
+        }
+        os << setw(10) << left << transport << setw(10) << mode << setw(9) << right << size << " "
+           << setw(12) << setprecision(0) << opsPerSecond << " ops/s" << setprecision(3);
+        for(size_t i = 0; i < sizeof(percentiles) / sizeof(double); ++i)
+        {
+            os << " " << names[i] << "=" << histogram.valueAtPercentile(percentiles[i]) / 1000.0 << "us";
+        }
+        os << " max=" << histogram.max() / 1000.0 << "us";
+    }
+    cout << os.str() << endl;
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+    Ice::StringSeq args = Ice::argsToStringSeq(argc, argv);
+    args = properties->parseCommandLineOptions("Bench", args);
+    Ice::stringSeqToArgs(args, argc, argv);
+
+    properties->setProperty("Ice.Warn.Connections", "0");
+    if(properties->getProperty("Ice.MessageSizeMax").empty())
+    {
+        properties->setProperty("Ice.MessageSizeMax", "0"); // No limit for the large sequence benchmarks.
+    }
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+
+    Ice::StringSeq transports = properties->getPropertyAsListWithDefault("Bench.Transports",
+                                                                         { "tcp", "ws", "ssl", "udp", "collocated" });
+    Ice::StringSeq modes = properties->getPropertyAsListWithDefault("Bench.Modes",
+                                                                    { "twoway", "oneway", "batch", "ami", "sequence",
+                                                                      "contention" });
+    int iterations = max(properties->getPropertyAsIntWithDefault("Bench.Iterations", 10000), 1);
+    int warmup = max(properties->getPropertyAsIntWithDefault("Bench.Warmup", 1000), 0);
+    int sequenceIterations = max(properties->getPropertyAsIntWithDefault("Bench.SequenceIterations", 500), 1);
+    bool json = properties->getPropertyWithDefault("Bench.Output", "json") != "text";
+    string label = properties->getProperty("Bench.Label");
+
+    Runner runner(properties);
+    Histogram histogram;
+
+    Ice::ObjectAdapterPtr collocated;
+    for(Ice::StringSeq::const_iterator t = transports.begin(); t != transports.end(); ++t)
+    {
+        PerfPrxPtr perf;
+        if(*t == "collocated")
+        {
+            if(!collocated)
+            {
+                collocated = communicator->createObjectAdapter("");
+                collocated->add(std::make_shared<PerfI>(), Ice::stringToIdentity("perf"));
+                collocated->activate();
+            }
+            perf = Ice::uncheckedCast<PerfPrx>(collocated->createProxy(Ice::stringToIdentity("perf")));
+        }
+        else
+        {
+            int port;
+            if(*t == "tcp")
+            {
+                port = 0;
+            }
+            else if(*t == "ws")
+            {
+                port = 1;
+            }
+            else if(*t == "udp")
+            {
+                port = 2;
+            }
+            else if(*t == "ssl")
+            {
+                if(properties->getProperty("IceSSL.CertFile").empty())
+                {
+                    cerr << "skipping ssl benchmarks, IceSSL isn't configured" << endl;
+                    continue;
+                }
+                port = 3;
+            }
+            else
+            {
+                throw invalid_argument("unknown benchmark transport `" + *t + "'");
+            }
+            perf = Ice::uncheckedCast<PerfPrx>(communicator->stringToProxy("perf:" + getTestEndpoint(port, *t)));
+        }
+
+        for(Ice::StringSeq::const_iterator m = modes.begin(); m != modes.end(); ++m)
+        {
+            if(*t == "udp" && *m != "oneway" && *m != "batch")
+            {
+                continue; // Only oneway requests can be sent over UDP.
+            }
+
+            int count = *m == "sequence" ? sequenceIterations : iterations;
+            if(warmup > 0)
+            {
+                runner.run(*t, *m, perf, *m == "sequence" ? min(warmup, count) : warmup, histogram);
+            }
+            histogram.reset();
+
+            Ice::Long start = now();
+            runner.run(*t, *m, perf, count, histogram);
+            report(json, label, *t, *m, runner.size(*m), count, now() - start, histogram);
+        }
+    }
+
+    if(properties->getPropertyAsIntWithDefault("Bench.Shutdown", 1) > 0)
+    {
+        Ice::uncheckedCast<PerfPrx>(communicator->stringToProxy("perf:" + getTestEndpoint(0, "tcp")))->shutdown();
+    }
+}
+
+DEFINE_TEST(Client)
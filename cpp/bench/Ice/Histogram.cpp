@@ -0,0 +1,182 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Histogram.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace
+{
+
+int
+log2Ceiling(Ice::Long value)
+{
+    int magnitude = 0;
+    while((Ice::Long(1) << magnitude) < value)
+    {
+        ++magnitude;
+    }
+    return magnitude;
+}
+
+int
+bitLength(Ice::Long value)
+{
+    int length = 0;
+    while(value)
+    {
+        value >>= 1;
+        ++length;
+    }
+    return length;
+}
+
+}
+
+Histogram::Histogram(Ice::Long highestTrackableValue, int significantDigits) :
+    _highestTrackableValue(highestTrackableValue)
+{
+    assert(significantDigits > 0 && significantDigits <= 5);
+
+    //
+    // The sub-bucket count is the smallest power of two which provides the
+    // requested number of significant digits over a power of two range.
+    //
+    Ice::Long largestSingleUnitResolution = 2;
+    for(int i = 0; i < significantDigits; ++i)
+    {
+        largestSingleUnitResolution *= 10;
+    }
+    int subBucketCountMagnitude = log2Ceiling(largestSingleUnitResolution);
+    _subBucketHalfCountMagnitude = subBucketCountMagnitude - 1;
+    _subBucketHalfCount = Ice::Long(1) << _subBucketHalfCountMagnitude;
+    _subBucketMask = (Ice::Long(1) << subBucketCountMagnitude) - 1;
+
+    int bucketCount = 1;
+    Ice::Long smallestUntrackableValue = Ice::Long(1) << subBucketCountMagnitude;
+    while(smallestUntrackableValue <= _highestTrackableValue)
+    {
+        if(smallestUntrackableValue > numeric_limits<Ice::Long>::max() / 2)
+        {
+            ++bucketCount;
+            break;
+        }
+        smallestUntrackableValue <<= 1;
+        ++bucketCount;
+    }
+    _counts.resize(static_cast<size_t>((bucketCount + 1) * _subBucketHalfCount));
+    reset();
+}
+
+void
+Histogram::record(Ice::Long value)
+{
+    value = std::max(value, Ice::Long(0));
+    value = std::min(value, _highestTrackableValue);
+    ++_counts[countsIndex(value)];
+    ++_count;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    _total += static_cast<double>(value);
+}
+
+void
+Histogram::add(const Histogram& other)
+{
+    assert(_counts.size() == other._counts.size());
+    for(size_t i = 0; i < _counts.size(); ++i)
+    {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+    _total += other._total;
+}
+
+void
+Histogram::reset()
+{
+    fill(_counts.begin(), _counts.end(), 0);
+    _count = 0;
+    _min = numeric_limits<Ice::Long>::max();
+    _max = 0;
+    _total = 0;
+}
+
+Ice::Long
+Histogram::count() const
+{
+    return _count;
+}
+
+Ice::Long
+Histogram::min() const
+{
+    return _count ? _min : 0;
+}
+
+Ice::Long
+Histogram::max() const
+{
+    return _max;
+}
+
+double
+Histogram::mean() const
+{
+    return _count ? _total / static_cast<double>(_count) : 0.0;
+}
+
+Ice::Long
+Histogram::valueAtPercentile(double percentile) const
+{
+    if(_count == 0)
+    {
+        return 0;
+    }
+
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    Ice::Long countAtPercentile = static_cast<Ice::Long>(ceil(percentile / 100.0 * static_cast<double>(_count)));
+    countAtPercentile = std::max(countAtPercentile, Ice::Long(1));
+
+    Ice::Long total = 0;
+    for(size_t i = 0; i < _counts.size(); ++i)
+    {
+        total += _counts[i];
+        if(total >= countAtPercentile)
+        {
+            return std::min(highestEquivalentValue(i), _max);
+        }
+    }
+    return _max;
+}
+
+size_t
+Histogram::countsIndex(Ice::Long value) const
+{
+    int bucketIndex = bitLength(value | _subBucketMask) - (_subBucketHalfCountMagnitude + 1);
+    Ice::Long subBucketIndex = value >> bucketIndex;
+    return static_cast<size_t>((Ice::Long(bucketIndex + 1) << _subBucketHalfCountMagnitude) +
+                               (subBucketIndex - _subBucketHalfCount));
+}
+
+Ice::Long
+Histogram::highestEquivalentValue(size_t index) const
+{
+    int bucketIndex = static_cast<int>(index >> _subBucketHalfCountMagnitude) - 1;
+    Ice::Long subBucketIndex = static_cast<Ice::Long>(index & static_cast<size_t>(_subBucketHalfCount - 1)) +
+        _subBucketHalfCount;
+    if(bucketIndex < 0)
+    {
+        subBucketIndex -= _subBucketHalfCount;
+        bucketIndex = 0;
+    }
+    return (subBucketIndex << bucketIndex) + (Ice::Long(1) << bucketIndex) - 1;
+}
@@ -0,0 +1,49 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <Ice/Config.h>
+#include <vector>
+
+//
+// A latency histogram using the HdrHistogram bucketing: values are
+// recorded with a fixed number of significant digits in log-linear
+// buckets, so percentiles are exact to the recorded precision and
+// recording is constant time with a fixed memory footprint.
+//
+class Histogram
+{
+public:
+
+    Histogram(Ice::Long = 60 * 1000000000LL, int = 3);
+
+    void record(Ice::Long);
+    void add(const Histogram&);
+    void reset();
+
+    Ice::Long count() const;
+    Ice::Long min() const;
+    Ice::Long max() const;
+    double mean() const;
+    Ice::Long valueAtPercentile(double) const;
+
+private:
+
+    size_t countsIndex(Ice::Long) const;
+    Ice::Long highestEquivalentValue(size_t) const;
+
+    const Ice::Long _highestTrackableValue;
+    int _subBucketHalfCountMagnitude;
+    Ice::Long _subBucketHalfCount;
+    Ice::Long _subBucketMask;
+    std::vector<Ice::Long> _counts;
+    Ice::Long _count;
+    Ice::Long _min;
+    Ice::Long _max;
+    double _total;
+};
+
+#endif
@@ -0,0 +1,9 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs        = client server
+$(test)_client_sources  = Bench.ice Client.cpp PerfI.cpp Histogram.cpp
+$(test)_server_sources  = Bench.ice Server.cpp PerfI.cpp
+
+tests += $(test)
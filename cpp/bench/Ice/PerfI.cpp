@@ -0,0 +1,30 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <PerfI.h>
+
+using namespace std;
+
+void
+PerfI::ping(const Ice::Current&)
+{
+}
+
+void
+PerfI::sendBytes(pair<const Ice::Byte*, const Ice::Byte*>, const Ice::Current&)
+{
+}
+
+Bench::ByteSeq
+PerfI::receiveBytes(int size, const Ice::Current&)
+{
+    return Bench::ByteSeq(static_cast<size_t>(size));
+}
+
+void
+PerfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
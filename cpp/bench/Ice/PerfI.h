@@ -0,0 +1,20 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef PERF_I_H
+#define PERF_I_H
+
+#include <Bench.h>
+
+class PerfI : public Bench::Perf
+{
+public:
+
+    virtual void ping(const Ice::Current&);
+    virtual void sendBytes(std::pair<const Ice::Byte*, const Ice::Byte*>, const Ice::Current&);
+    virtual Bench::ByteSeq receiveBytes(int, const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
@@ -0,0 +1,48 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <PerfI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+    properties->setProperty("Ice.Warn.Connections", "0");
+    if(properties->getProperty("Ice.MessageSizeMax").empty())
+    {
+        properties->setProperty("Ice.MessageSizeMax", "0"); // No limit for the large sequence benchmarks.
+    }
+
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+
+    //
+    // The client expects the tcp, ws, udp and ssl endpoints on consecutive
+    // ports. The ssl endpoint is only enabled if IceSSL is configured.
+    //
+    string endpoints = getTestEndpoint(0, "tcp") + ":" + getTestEndpoint(1, "ws") + ":" + getTestEndpoint(2, "udp");
+    if(!properties->getProperty("IceSSL.CertFile").empty())
+    {
+        endpoints += ":" + getTestEndpoint(3, "ssl");
+    }
+    communicator->getProperties()->setProperty("BenchAdapter.Endpoints", endpoints);
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("BenchAdapter");
+    adapter->add(std::make_shared<PerfI>(), Ice::stringToIdentity("perf"));
+    adapter->activate();
+
+    serverReady();
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
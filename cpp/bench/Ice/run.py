@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# Starts the benchmark server, runs the benchmark client against it and
+# forwards the client results (one JSON object per line by default) to
+# stdout. Arguments are passed to the client, for example:
+#
+#   run.py --Bench.Transports="tcp ssl" --Bench.Modes=twoway --Bench.Output=text
+#
+# Use --bindir=<dir> to select the directory of the client and server
+# executables, the most recent build/<platform>/<config> directory is used
+# otherwise. Use --no-ssl to run without IceSSL.
+#
+# Use --metrics=<configurations> to compare the cost of IceMX metrics: the
+# benchmark runs once for each of the comma separated configurations, off
+# (no metrics), on (metrics enabled) or shards (metrics enabled with per
+# thread counter shards), and each result is labeled with its configuration.
+#
+
+import os, sys, glob, subprocess
+
+benchdir = os.path.dirname(os.path.abspath(__file__))
+toplevel = os.path.normpath(os.path.join(benchdir, "..", "..", ".."))
+
+def findBinDir(args):
+    for a in args:
+        if a.startswith("--bindir="):
+            return a[len("--bindir="):]
+    clients = glob.glob(os.path.join(benchdir, "build", "*", "*", "client*"))
+    if not clients:
+        sys.stderr.write("couldn't find the benchmark executables, build the bench target first\n")
+        sys.exit(1)
+    return os.path.dirname(max(clients, key=os.path.getmtime))
+
+def sslProperties(name):
+    return ["--Ice.Plugin.IceSSL=IceSSL:createIceSSL",
+            "--IceSSL.DefaultDir={0}".format(os.path.join(toplevel, "certs")),
+            "--IceSSL.CAs=cacert.pem",
+            "--IceSSL.CertFile={0}.p12".format(name),
+            "--IceSSL.Password=password",
+            "--IceSSL.VerifyPeer={0}".format(0 if name == "client" else 1)]
+
+def metricsProperties(config):
+    if config == "off":
+        return []
+    properties = ["--Ice.Admin.Enabled=1",
+                  "--Ice.Admin.Facets=Metrics",
+                  "--IceMX.Metrics.Bench.GroupBy=operation"]
+    if config == "shards":
+        properties.append("--IceMX.Metrics.Bench.Shards=16")
+    elif config != "on":
+        sys.stderr.write("unknown metrics configuration `{0}'\n".format(config))
+        sys.exit(1)
+    return properties
+
+def run(bindir, ssl, args, env):
+    serverArgs = ["--Ice.PrintAdapterReady=1"] + (sslProperties("server") if ssl else [])
+    serverArgs += [a for a in args if a.startswith("--Ice.") or a.startswith("--IceMX.") or a.startswith("--Test.")]
+    server = subprocess.Popen([os.path.join(bindir, "server")] + serverArgs, env=env, stdout=subprocess.PIPE,
+                              universal_newlines=True)
+    try:
+        while True:
+            line = server.stdout.readline()
+            if not line:
+                sys.stderr.write("benchmark server failed to start\n")
+                return 1
+            if line.strip() == "BenchAdapter ready":
+                break
+
+        clientArgs = sslProperties("client") if ssl else []
+        status = subprocess.call([os.path.join(bindir, "client")] + clientArgs + args, env=env)
+        if status != 0:
+            server.terminate()
+        server.wait()
+        return status
+    except:
+        server.terminate()
+        raise
+
+def main(args):
+    bindir = findBinDir(args)
+    ssl = "--no-ssl" not in args
+    metrics = None
+    for a in args:
+        if a.startswith("--metrics="):
+            metrics = a[len("--metrics="):].split(",")
+    args = [a for a in args if not a.startswith("--bindir=") and a != "--no-ssl" and not a.startswith("--metrics=")]
+
+    env = os.environ.copy()
+    libdirs = [os.path.join(toplevel, "cpp", "lib"), os.path.join(toplevel, "cpp", "lib64")]
+    env["LD_LIBRARY_PATH"] = os.pathsep.join(libdirs + [env.get("LD_LIBRARY_PATH", "")])
+    env["DYLD_LIBRARY_PATH"] = os.pathsep.join(libdirs + [env.get("DYLD_LIBRARY_PATH", "")])
+
+    if not metrics:
+        return run(bindir, ssl, args, env)
+
+    for config in metrics:
+        status = run(bindir, ssl, metricsProperties(config) + ["--Bench.Label=metrics-" + config] + args, env)
+        if status != 0:
+            return status
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,197 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <TestHelper.h>
+#include <Event.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+using namespace Bench;
+
+//
+// The IceStorm benchmark client measures the fan-out throughput of a topic:
+// it subscribes a number of subscribers to a topic, publishes events to the
+// topic and prints one result per line for each number of subscribers,
+// either as a JSON object (the default) or as text:
+//
+// --Bench.TopicManager topic manager proxy (default IceStorm/TopicManager:tcp -h 127.0.0.1 -p 10000)
+// --Bench.Subscribers  numbers of subscribers (default 10 100 500)
+// --Bench.Events       number of published events (default 1000)
+// --Bench.Output       json or text
+// --Bench.Label        label added to each result (default none)
+//
+// The duration is the time from the first published event to the last event
+// received by all the subscribers.
+//
+
+namespace
+{
+
+Ice::Long
+now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class Deliveries
+{
+public:
+
+    Deliveries(Ice::Long expected) : _expected(expected), _received(0)
+    {
+    }
+
+    void
+    received()
+    {
+        lock_guard<mutex> lg(_mutex);
+        if(++_received == _expected)
+        {
+            _condVar.notify_one();
+        }
+    }
+
+    void
+    wait()
+    {
+        unique_lock<mutex> lock(_mutex);
+        _condVar.wait(lock, [this] { return _received == _expected; });
+    }
+
+private:
+
+    const Ice::Long _expected;
+    Ice::Long _received;
+    mutex _mutex;
+    condition_variable _condVar;
+};
+
+class EventI final : public Event
+{
+public:
+
+    EventI(Deliveries& deliveries) : _deliveries(deliveries)
+    {
+    }
+
+    void
+    pub(int, const Ice::Current&) override
+    {
+        _deliveries.received();
+    }
+
+private:
+
+    Deliveries& _deliveries;
+};
+
+void
+report(bool json, const string& label, int subscribers, int events, Ice::Long duration)
+{
+    double seconds = static_cast<double>(duration) / 1000000000.0;
+    double eventsPerSecond = seconds > 0 ? static_cast<double>(events) / seconds : 0.0;
+    double deliveriesPerSecond = eventsPerSecond * subscribers;
+
+    ostringstream os;
+    os << fixed << setprecision(3);
+    if(json)
+    {
+        os << "{";
+        if(!label.empty())
+        {
+            os << "\"label\":\"" << label << "\",";
+        }
+        os << "\"subscribers\":" << subscribers << ",\"events\":" << events << ",\"seconds\":" << seconds
+           << ",\"eventsPerSecond\":" << eventsPerSecond << ",\"deliveriesPerSecond\":" << deliveriesPerSecond
+           << "}";
+    }
+    else
+    {
+        if(!label.empty())
+        {
+            os << setw(12) << left << label;
+        }
+        os << setw(6) << right << subscribers << " subscribers " << setprecision(0) << setw(12) << eventsPerSecond
+           << " events/s " << setw(12) << deliveriesPerSecond << " deliveries/s";
+    }
+    cout << os.str() << endl;
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+    Ice::StringSeq args = Ice::argsToStringSeq(argc, argv);
+    args = properties->parseCommandLineOptions("Bench", args);
+    Ice::stringSeqToArgs(args, argc, argv);
+
+    properties->setProperty("Ice.Warn.Connections", "0");
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+
+    string topicManager = properties->getPropertyWithDefault("Bench.TopicManager",
+                                                             "IceStorm/TopicManager:tcp -h 127.0.0.1 -p 10000");
+    Ice::StringSeq subscribers = properties->getPropertyAsListWithDefault("Bench.Subscribers",
+                                                                          { "10", "100", "500" });
+    int events = max(properties->getPropertyAsIntWithDefault("Bench.Events", 1000), 1);
+    bool json = properties->getPropertyWithDefault("Bench.Output", "json") != "text";
+    string label = properties->getProperty("Bench.Label");
+
+    auto manager = Ice::checkedCast<IceStorm::TopicManagerPrx>(communicator->stringToProxy(topicManager));
+    if(!manager)
+    {
+        throw invalid_argument("`" + topicManager + "' is not a topic manager");
+    }
+
+    auto adapter = communicator->createObjectAdapterWithEndpoints("Subscribers", "tcp -h 127.0.0.1");
+    adapter->activate();
+
+    for(Ice::StringSeq::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        int count = max(atoi(p->c_str()), 1);
+        Deliveries deliveries(static_cast<Ice::Long>(count) * events);
+
+        auto topic = manager->create(Ice::generateUUID());
+        vector<Ice::ObjectPrxPtr> proxies;
+        for(int i = 0; i < count; ++i)
+        {
+            proxies.push_back(adapter->addWithUUID(std::make_shared<EventI>(deliveries))->ice_oneway());
+            topic->subscribeAndGetPublisher(IceStorm::QoS(), proxies.back());
+        }
+
+        auto publisher = Ice::uncheckedCast<EventPrx>(topic->getPublisher()->ice_oneway());
+        Ice::Long start = now();
+        for(int i = 0; i < events; ++i)
+        {
+            publisher->pub(i);
+        }
+        deliveries.wait();
+        report(json, label, count, events, now() - start);
+
+        for(vector<Ice::ObjectPrxPtr>::const_iterator q = proxies.begin(); q != proxies.end(); ++q)
+        {
+            topic->unsubscribe(*q);
+            adapter->remove((*q)->ice_getIdentity());
+        }
+        topic->destroy();
+    }
+}
+
+DEFINE_TEST(Client)
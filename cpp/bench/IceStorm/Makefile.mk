@@ -0,0 +1,9 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs        = client
+$(test)_dependencies    = IceStorm Ice TestCommon
+$(test)_client_sources  = Event.ice Client.cpp
+
+tests += $(test)
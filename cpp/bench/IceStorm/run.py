@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# Starts a transient IceStorm service in IceBox, runs the IceStorm benchmark
+# client against it and forwards the client results (one JSON object per
+# line by default) to stdout. Arguments are passed to the client, for
+# example:
+#
+#   run.py --Bench.Subscribers="10 100 500" --Bench.Events=1000 --Bench.Output=text
+#
+# Use --bindir=<dir> to select the directory of the client executable, the
+# most recent build/<platform>/<config> directory is used otherwise.
+#
+# Use --workers=<numbers> to compare the IceStorm publish workers: the
+# benchmark runs once for each of the comma separated numbers of workers
+# (IceStorm.Publish.Workers) and each result is labeled with its
+# configuration.
+#
+
+import os, sys, glob, subprocess
+
+benchdir = os.path.dirname(os.path.abspath(__file__))
+toplevel = os.path.normpath(os.path.join(benchdir, "..", "..", ".."))
+
+def findBinDir(args):
+    for a in args:
+        if a.startswith("--bindir="):
+            return a[len("--bindir="):]
+    clients = glob.glob(os.path.join(benchdir, "build", "*", "*", "client*"))
+    if not clients:
+        sys.stderr.write("couldn't find the benchmark executables, build the bench target first\n")
+        sys.exit(1)
+    return os.path.dirname(max(clients, key=os.path.getmtime))
+
+def serviceProperties():
+    return ["--IceBox.Service.IceStorm=IceStormService:createIceStorm",
+            "--IceBox.PrintServicesReady=IceStorm",
+            "--IceStorm.InstanceName=IceStorm",
+            "--IceStorm.Transient=1",
+            "--IceStorm.TopicManager.Endpoints=tcp -h 127.0.0.1 -p 10000",
+            "--IceStorm.Publish.Endpoints=tcp -h 127.0.0.1 -p 10001"]
+
+def run(bindir, args, env):
+    serviceArgs = serviceProperties()
+    serviceArgs += [a for a in args if a.startswith("--Ice.") or a.startswith("--IceStorm.")]
+    service = subprocess.Popen([os.path.join(toplevel, "cpp", "bin", "icebox")] + serviceArgs, env=env,
+                               stdout=subprocess.PIPE, universal_newlines=True)
+    try:
+        while True:
+            line = service.stdout.readline()
+            if not line:
+                sys.stderr.write("IceStorm service failed to start\n")
+                return 1
+            if line.strip() == "IceStorm ready":
+                break
+
+        clientArgs = [a for a in args if not a.startswith("--IceStorm.")]
+        status = subprocess.call([os.path.join(bindir, "client")] + clientArgs, env=env)
+        service.terminate()
+        service.wait()
+        return status
+    except:
+        service.terminate()
+        raise
+
+def main(args):
+    bindir = findBinDir(args)
+    workers = None
+    for a in args:
+        if a.startswith("--workers="):
+            workers = a[len("--workers="):].split(",")
+    args = [a for a in args if not a.startswith("--bindir=") and not a.startswith("--workers=")]
+
+    env = os.environ.copy()
+    libdirs = [os.path.join(toplevel, "cpp", "lib"), os.path.join(toplevel, "cpp", "lib64")]
+    env["LD_LIBRARY_PATH"] = os.pathsep.join(libdirs + [env.get("LD_LIBRARY_PATH", "")])
+    env["DYLD_LIBRARY_PATH"] = os.pathsep.join(libdirs + [env.get("DYLD_LIBRARY_PATH", "")])
+
+    if not workers:
+        return run(bindir, args, env)
+
+    for n in workers:
+        status = run(bindir, ["--IceStorm.Publish.Workers=" + n, "--Bench.Label=workers-" + n] + args, env)
+        if status != 0:
+            return status
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
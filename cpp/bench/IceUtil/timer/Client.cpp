@@ -0,0 +1,204 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/Timer.h>
+#include <TestHelper.h>
+
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+
+using namespace std;
+
+//
+// The timer benchmark measures the cost of canceling and rescheduling tasks
+// while the timer holds a given number of pending tasks, for the timing wheel
+// of IceUtil::Timer and for the sorted set bookkeeping of the previous timer
+// implementation:
+//
+// --Bench.Pending      numbers of pending tasks (default 1000 10000 100000 1000000)
+// --Bench.Iterations   number of cancel and schedule pairs (default 1000000)
+// --Bench.Output       json or text
+//
+// The pending tasks are scheduled with delays between one minute and one day
+// so that none of them runs during the benchmark.
+//
+
+namespace
+{
+
+Ice::Long
+now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class Task : public IceUtil::TimerTask
+{
+public:
+
+    virtual void runTimerTask()
+    {
+    }
+};
+
+//
+// The scheduling and canceling of the previous IceUtil::Timer implementation,
+// without the timer thread which stays idle during the benchmark.
+//
+class SetTimer
+{
+public:
+
+    void schedule(const IceUtil::TimerTaskPtr& task, const IceUtil::Time& delay)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+        IceUtil::Time time = IceUtil::Time::now(IceUtil::Time::Monotonic) + delay;
+        if(!_tasks.insert(make_pair(task, time)).second)
+        {
+            throw IceUtil::IllegalArgumentException(__FILE__, __LINE__, "task is already scheduled");
+        }
+        _tokens.insert(Token(time, task));
+        if(_wakeUpTime == IceUtil::Time() || time < _wakeUpTime)
+        {
+            _monitor.notify();
+        }
+    }
+
+    bool cancel(const IceUtil::TimerTaskPtr& task)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+        map<IceUtil::TimerTaskPtr, IceUtil::Time>::iterator p = _tasks.find(task);
+        if(p == _tasks.end())
+        {
+            return false;
+        }
+        _tokens.erase(Token(p->second, p->first));
+        _tasks.erase(p);
+        return true;
+    }
+
+private:
+
+    struct Token
+    {
+        Token(const IceUtil::Time& t, const IceUtil::TimerTaskPtr& tt) :
+            scheduledTime(t), task(tt)
+        {
+        }
+
+        bool operator<(const Token& r) const
+        {
+            if(scheduledTime != r.scheduledTime)
+            {
+                return scheduledTime < r.scheduledTime;
+            }
+            return task.get() < r.task.get();
+        }
+
+        IceUtil::Time scheduledTime;
+        IceUtil::TimerTaskPtr task;
+    };
+
+    IceUtil::Monitor<IceUtil::Mutex> _monitor;
+    set<Token> _tokens;
+    map<IceUtil::TimerTaskPtr, IceUtil::Time> _tasks;
+    IceUtil::Time _wakeUpTime;
+};
+
+template<typename T> Ice::Long
+churn(T& timer, int pending, int iterations)
+{
+    mt19937 rng(pending);
+    uniform_int_distribution<int> delays(60, 86400);
+    uniform_int_distribution<int> indexes(0, pending - 1);
+
+    vector<IceUtil::TimerTaskPtr> tasks;
+    tasks.reserve(static_cast<size_t>(pending));
+    for(int i = 0; i < pending; ++i)
+    {
+        tasks.push_back(make_shared<Task>());
+        timer.schedule(tasks.back(), IceUtil::Time::seconds(delays(rng)));
+    }
+
+    Ice::Long start = now();
+    for(int i = 0; i < iterations; ++i)
+    {
+        const IceUtil::TimerTaskPtr& task = tasks[static_cast<size_t>(indexes(rng))];
+        timer.cancel(task);
+        timer.schedule(task, IceUtil::Time::seconds(delays(rng)));
+    }
+    Ice::Long duration = now() - start;
+
+    for(vector<IceUtil::TimerTaskPtr>::const_iterator p = tasks.begin(); p != tasks.end(); ++p)
+    {
+        timer.cancel(*p);
+    }
+    return duration;
+}
+
+void
+report(bool json, const string& implementation, int pending, int iterations, Ice::Long duration)
+{
+    double seconds = static_cast<double>(duration) / 1000000000.0;
+    double opsPerSecond = seconds > 0 ? static_cast<double>(iterations) / seconds : 0.0;
+    double nsPerOp = static_cast<double>(duration) / iterations;
+
+    ostringstream os;
+    os << fixed << setprecision(3);
+    if(json)
+    {
+        os << "{\"implementation\":\"" << implementation << "\",\"pending\":" << pending
+           << ",\"operations\":" << iterations << ",\"seconds\":" << seconds
+           << ",\"opsPerSecond\":" << opsPerSecond << ",\"nsPerOperation\":" << nsPerOp << "}";
+    }
+    else
+    {
+        os << setw(8) << left << implementation << setw(9) << right << pending << " pending "
+           << setw(12) << setprecision(0) << opsPerSecond << " ops/s " << setprecision(1) << nsPerOp << "ns/op";
+    }
+    cout << os.str() << endl;
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+    Ice::StringSeq args = Ice::argsToStringSeq(argc, argv);
+    properties->parseCommandLineOptions("Bench", args);
+
+    Ice::StringSeq pending = properties->getPropertyAsListWithDefault("Bench.Pending",
+                                                                      { "1000", "10000", "100000", "1000000" });
+    int iterations = max(properties->getPropertyAsIntWithDefault("Bench.Iterations", 1000000), 1);
+    bool json = properties->getPropertyWithDefault("Bench.Output", "json") != "text";
+
+    for(Ice::StringSeq::const_iterator p = pending.begin(); p != pending.end(); ++p)
+    {
+        int count = max(atoi(p->c_str()), 1);
+        {
+            IceUtil::TimerPtr timer = new IceUtil::Timer();
+            report(json, "wheel", count, iterations, churn(*timer, count, iterations));
+            timer->destroy();
+        }
+        {
+            SetTimer timer;
+            report(json, "set", count, iterations, churn(timer, count, iterations));
+        }
+    }
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,8 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs        = client
+$(test)_client_sources  = Client.cpp
+
+tests += $(test)
@@ -6,6 +6,7 @@
 #define ICE_BUFFER_H
 
 #include <Ice/Config.h>
+#include <Ice/BufferPoolF.h>
 
 namespace IceInternal
 {
@@ -78,13 +79,30 @@ public:
 
         void clear();
 
+        //
+        // Sets the pool used to allocate the buffer memory. The pool is
+        // only used for new allocations, the memory is returned to the
+        // pool when the buffer is cleared, shrunk or destroyed.
+        //
+        void setPool(const BufferPoolPtr&);
+
+        //
+        // Shares the ownership of the buffer memory, for example to return
+        // a sequence which references the memory without copying it. The
+        // buffer remains readable but it's no longer modified: it gets new
+        // memory when resized and the shared memory is released once the
+        // buffer and all the returned pointers are gone. Returns null if
+        // the buffer doesn't own its memory.
+        //
+        std::shared_ptr<value_type> share();
+
         void resize(size_type n) // Inlined for performance reasons.
         {
             if(n == 0)
             {
                 clear();
             }
-            else if(n > _capacity)
+            else if(n > _capacity || _shared)
             {
                 reserve(n);
             }
@@ -137,12 +155,16 @@ public:
         Container(const Container&);
         void operator=(const Container&);
         void reserve(size_type);
+        void release(pointer, size_type);
 
         pointer _buf;
         size_type _size;
         size_type _capacity;
         int _shrinkCounter;
         bool _owned;
+        bool _pooled;
+        BufferPoolPtr _pool;
+        std::shared_ptr<value_type> _shared;
     };
 
     Container b;
@@ -0,0 +1,21 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_BUFFER_POOL_F_H
+#define ICE_BUFFER_POOL_F_H
+
+#include <IceUtil/Shared.h>
+
+#include <Ice/Handle.h>
+
+namespace IceInternal
+{
+
+class BufferPool;
+ICE_API IceUtil::Shared* upCast(BufferPool*);
+typedef Handle<BufferPool> BufferPoolPtr;
+
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include <Ice/SlicedDataF.h>
 #include <Ice/UserExceptionFactory.h>
 #include <Ice/StreamHelpers.h>
+#include <Ice/SharedByteSeq.h>
 #include <Ice/FactoryTable.h>
 
 namespace Ice
@@ -753,6 +754,14 @@ public:
      */
     void read(std::pair<const Byte*, const Byte*>& v);
 
+    /**
+     * Reads a sequence of bytes from the stream. A large sequence shares the
+     * ownership of the internal marshaling buffer instead of copying the bytes,
+     * the buffer is kept alive as long as the sequence references it.
+     * @param v The sequence holding or referencing the bytes.
+     */
+    void read(SharedByteSeq& v);
+
     /**
      * Reads a bool from the stream.
      * @param v The extracted bool.
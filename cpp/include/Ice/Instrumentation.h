@@ -53,6 +53,7 @@ class ChildInvocationObserver;
 class RemoteObserver;
 class CollocatedObserver;
 class InvocationObserver;
+class BufferPoolObserver;
 class ObserverUpdater;
 class CommunicatorObserver;
 
@@ -314,6 +315,29 @@ public:
     virtual ::std::shared_ptr<::Ice::Instrumentation::CollocatedObserver> getCollocatedObserver(const ::std::shared_ptr<::Ice::ObjectAdapter>& adapter, int requestId, int size) = 0;
 };
 
+/**
+ * The buffer pool observer to instrument a size class of the
+ * communicator message buffer pool.
+ * \headerfile Ice/Ice.h
+ */
+class ICE_CLASS(ICE_API) BufferPoolObserver : public virtual ::Ice::Instrumentation::Observer
+{
+public:
+
+    ICE_MEMBER(ICE_API) virtual ~BufferPoolObserver();
+
+    /**
+     * Notification of a buffer allocation served by a cached buffer.
+     */
+    virtual void hit() = 0;
+
+    /**
+     * Notification of a buffer allocation which required allocating
+     * new memory.
+     */
+    virtual void miss() = 0;
+};
+
 /**
  * The observer updater interface. This interface is implemented by
  * the Ice run-time and an instance of this interface is provided by
@@ -355,6 +379,18 @@ public:
      * possibility to return an updated observer if necessary.
      */
     virtual void updateThreadObservers() = 0;
+
+    /**
+     * Update buffer pool observers associated with each size class
+     * of the communicator message buffer pool.
+     *
+     * When called, this method goes through all the size classes and
+     * for each size class {@link CommunicatorObserver#getBufferPoolObserver}
+     * is called. The implementation of getBufferPoolObserver has the
+     * possibility to return an updated observer if necessary. The
+     * default implementation does nothing.
+     */
+    virtual void updateBufferPoolObservers();
 };
 
 /**
@@ -446,6 +482,20 @@ public:
      */
     virtual ::std::shared_ptr<::Ice::Instrumentation::DispatchObserver> getDispatchObserver(const ::Ice::Current& c, int size) = 0;
 
+    /**
+     * This method should return a buffer pool observer for the given
+     * size class of the communicator message buffer pool. The Ice
+     * run-time calls this method for each size class when the
+     * communicator is initialized and when
+     * {@link ObserverUpdater#updateBufferPoolObservers} is called.
+     * @param id The ID of the size class to observe.
+     * @param o The old buffer pool observer if one is already set or
+     * a null reference otherwise.
+     * @return The buffer pool observer to instrument the size class.
+     * The default implementation returns a null reference.
+     */
+    virtual ::std::shared_ptr<::Ice::Instrumentation::BufferPoolObserver> getBufferPoolObserver(const ::std::string& id, const ::std::shared_ptr<BufferPoolObserver>& o);
+
     /**
      * The Ice run-time calls this method when the communicator is
      * initialized. The add-in implementing this interface can use
@@ -491,6 +541,8 @@ using CollocatedObserverPtr = ::std::shared_ptr<CollocatedObserver>;
 
 using InvocationObserverPtr = ::std::shared_ptr<InvocationObserver>;
 
+using BufferPoolObserverPtr = ::std::shared_ptr<BufferPoolObserver>;
+
 using ObserverUpdaterPtr = ::std::shared_ptr<ObserverUpdater>;
 
 using CommunicatorObserverPtr = ::std::shared_ptr<CommunicatorObserver>;
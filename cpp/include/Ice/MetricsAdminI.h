@@ -13,6 +13,8 @@
 
 #include <regex>
 #include <list>
+#include <atomic>
+#include <typeinfo>
 
 namespace IceMX
 {
@@ -20,6 +22,21 @@ namespace IceMX
 /// \cond INTERNAL
 class Updater;
 template<typename T> class MetricsHelperT;
+
+//
+// Adds the counters of a metrics object to the counters of another metrics
+// object of the same type, the other members are ignored. Each metrics type
+// with counters of its own provides an overload which also adds the counters
+// of its base type, the overload is found by argument-dependent lookup.
+//
+ICE_API void addMetrics(Metrics&, const Metrics&);
+ICE_API void addMetrics(ThreadMetrics&, const ThreadMetrics&);
+ICE_API void addMetrics(DispatchMetrics&, const DispatchMetrics&);
+ICE_API void addMetrics(ChildInvocationMetrics&, const ChildInvocationMetrics&);
+ICE_API void addMetrics(InvocationMetrics&, const InvocationMetrics&);
+ICE_API void addMetrics(ConnectionMetrics&, const ConnectionMetrics&);
+ICE_API void addMetrics(BufferPoolMetrics&, const BufferPoolMetrics&);
+ICE_API void addMetrics(WebSocketDeflateMetrics&, const WebSocketDeflateMetrics&);
 /// \endcond
 
 }
@@ -82,12 +99,20 @@ public:
 
     const Ice::PropertyDict& getProperties() const;
 
+    //
+    // Returns the index of the calling thread, used to select the counter
+    // shard updated by the thread.
+    //
+    static size_t threadShard();
+
 protected:
 
     const Ice::PropertyDict _properties;
     const std::vector<std::string> _groupByAttributes;
     const std::vector<std::string> _groupBySeparators;
     const int _retain;
+    const int _shards;
+    const bool _histogram;
     const std::vector<RegExpPtr> _accept;
     const std::vector<RegExpPtr> _reject;
 };
@@ -110,6 +135,46 @@ private:
 };
 ICE_DEFINE_PTR(MetricsMapFactoryPtr, MetricsMapFactory);
 
+//
+// A log-linear histogram of durations in microseconds. Durations under 16us
+// have their own bucket and each following power of two range is divided in
+// 8 buckets, the relative error is therefore under 12.5%. The buckets are
+// only allocated up to the longest recorded duration.
+//
+class ICE_API LifetimeHistogram
+{
+public:
+
+    LifetimeHistogram();
+
+    void add(Ice::Long);
+    void get(IceMX::LatencyHistogram&) const;
+
+private:
+
+    static Ice::Long lowerBound(size_t);
+
+    static const int subBucketBits = 3;
+    static const int subBuckets = 1 << subBucketBits;
+    static const int linearBuckets = 2 * subBuckets;
+
+    std::vector<Ice::Long> _counts;
+};
+
+//
+// The map mutex protects the map of metrics objects and the detached
+// queue, each entry has its own mutex to protect its metrics object. The
+// map mutex must be locked before an entry mutex if both are needed.
+//
+// If the map is configured with counter shards, the updates of the
+// observers and the failures are recorded in the shard of the calling
+// thread instead of the entry metrics object. The shards are only added to
+// the entry metrics when the metrics are retrieved.
+//
+// If the map is configured with histograms, each entry also records the
+// lifetime of its detached objects in a histogram, one per counter shard if
+// the map has shards.
+//
 template<class MetricsType> class MetricsMapT : public MetricsMapI, private IceUtil::Mutex
 {
 public:
@@ -132,6 +197,18 @@ public:
         EntryT(MetricsMapTPtr map, const TPtr& object, const typename std::list<EntryTPtr>::iterator& p) :
             _map(map), _object(object), _detachedPos(p)
         {
+            for(int i = 0; i < _map->_shards; ++i)
+            {
+                _shards.push_back(std::unique_ptr<Shard>(new Shard()));
+                if(_map->_histogram)
+                {
+                    _shards.back()->histogram.reset(new LifetimeHistogram());
+                }
+            }
+            if(_map->_histogram && _shards.empty())
+            {
+                _histogram.reset(new LifetimeHistogram());
+            }
         }
 
         ~EntryT()
@@ -147,9 +224,19 @@ public:
         void
         failed(const std::string& exceptionName)
         {
-            IceUtil::Mutex::Lock sync(*_map);
-            ++_object->failures;
-            ++_failures[exceptionName];
+            if(_shards.empty())
+            {
+                IceUtil::Mutex::Lock sync(_mutex);
+                ++_object->failures;
+                ++_failures[exceptionName];
+            }
+            else
+            {
+                Shard& shard = getShard();
+                IceUtil::Mutex::Lock sync(shard.mutex);
+                ++shard.getObject()->failures;
+                ++shard.failures[exceptionName];
+            }
         }
 
         template<typename MemberMetricsType> typename MetricsMapT<MemberMetricsType>::EntryTPtr
@@ -157,7 +244,7 @@ public:
         {
             MetricsMapIPtr m;
             {
-                IceUtil::Mutex::Lock sync(*_map);
+                IceUtil::Mutex::Lock sync(_mutex);
                 typename std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> >::iterator p =
                     _subMaps.find(mapName);
                 if(p == _subMaps.end())
@@ -183,19 +270,41 @@ public:
         void
         detach(Ice::Long lifetime)
         {
-            IceUtil::Mutex::Lock sync(*_map);
-            _object->totalLifetime += lifetime;
-            if(--_object->current == 0)
+            if(_map->_histogram && !_shards.empty())
+            {
+                Shard& shard = getShard();
+                IceUtil::Mutex::Lock sync(shard.mutex);
+                shard.histogram->add(lifetime);
+            }
             {
-                _map->detached(this->shared_from_this());
+                IceUtil::Mutex::Lock sync(_mutex);
+                _object->totalLifetime += lifetime;
+                if(_histogram)
+                {
+                    _histogram->add(lifetime);
+                }
+                if(--_object->current > 0)
+                {
+                    return;
+                }
             }
+            _map->detached(this->shared_from_this());
         }
 
         template<typename Function> void
         execute(Function func)
         {
-            IceUtil::Mutex::Lock sync(*_map);
-            func(_object);
+            if(_shards.empty())
+            {
+                IceUtil::Mutex::Lock sync(_mutex);
+                func(_object);
+            }
+            else
+            {
+                Shard& shard = getShard();
+                IceUtil::Mutex::Lock sync(shard.mutex);
+                func(shard.getObject());
+            }
         }
 
         MetricsMapT*
@@ -206,19 +315,85 @@ public:
 
     private:
 
+        //
+        // The shards are padded to prevent false sharing between the threads
+        // updating the shards of an entry. The shard metrics object is created
+        // by the first thread updating the shard. If the map is configured
+        // with histograms, the lifetimes are also recorded in the shard
+        // histogram and the shard histograms are merged on retrieval.
+        //
+        struct Shard
+        {
+            const TPtr&
+            getObject()
+            {
+                if(!object)
+                {
+                    object = std::make_shared<T>();
+                }
+                return object;
+            }
+
+            char padding1[64];
+            IceUtil::Mutex mutex;
+            TPtr object;
+            IceMX::StringIntDict failures;
+            std::unique_ptr<LifetimeHistogram> histogram;
+            char padding2[64];
+        };
+
+        Shard&
+        getShard()
+        {
+            return *_shards[MetricsMapI::threadShard() % _shards.size()];
+        }
+
         IceMX::MetricsFailures
         getFailures() const
         {
+            IceUtil::Mutex::Lock sync(_mutex);
             IceMX::MetricsFailures f;
             f.id = _object->id;
             f.failures = _failures;
+            for(typename std::vector<std::unique_ptr<Shard> >::const_iterator p = _shards.begin();
+                p != _shards.end(); ++p)
+            {
+                IceUtil::Mutex::Lock syncShard((*p)->mutex);
+                for(IceMX::StringIntDict::const_iterator q = (*p)->failures.begin(); q != (*p)->failures.end(); ++q)
+                {
+                    f.failures[q->first] += q->second;
+                }
+            }
             return f;
         }
 
         IceMX::MetricsPtr
         clone() const
         {
+            IceUtil::Mutex::Lock sync(_mutex);
             TPtr metrics = ICE_DYNAMIC_CAST(T, _object->ice_clone());
+            IceMX::LatencyHistogram histogram;
+            for(typename std::vector<std::unique_ptr<Shard> >::const_iterator p = _shards.begin();
+                p != _shards.end(); ++p)
+            {
+                IceUtil::Mutex::Lock syncShard((*p)->mutex);
+                if((*p)->object)
+                {
+                    addMetrics(*metrics, *(*p)->object);
+                }
+                if((*p)->histogram)
+                {
+                    (*p)->histogram->get(histogram);
+                }
+            }
+            if(_histogram)
+            {
+                _histogram->get(histogram);
+            }
+            if(_map->_histogram)
+            {
+                metrics->lifetimeHistogram = histogram;
+            }
             for(typename std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> >::const_iterator p =
                     _subMaps.begin(); p != _subMaps.end(); ++p)
             {
@@ -230,12 +405,14 @@ public:
         bool
         isDetached() const
         {
+            IceUtil::Mutex::Lock sync(_mutex);
             return _object->current == 0;
         }
 
         void
         attach(const IceMX::MetricsHelperT<T>& helper)
         {
+            IceUtil::Mutex::Lock sync(_mutex);
             ++_object->total;
             ++_object->current;
             helper.initMetrics(_object);
@@ -243,8 +420,11 @@ public:
 
         friend class MetricsMapT;
         MetricsMapTPtr _map;
+        mutable IceUtil::Mutex _mutex;
         TPtr _object;
         IceMX::StringIntDict _failures;
+        std::vector<std::unique_ptr<Shard> > _shards;
+        std::unique_ptr<LifetimeHistogram> _histogram;
         std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> > _subMaps;
         typename std::list<EntryTPtr>::iterator _detachedPos;
     };
@@ -252,7 +432,7 @@ public:
     MetricsMapT(const std::string& mapPrefix,
                 const Ice::PropertiesPtr& properties,
                 const std::map<std::string, std::pair<SubMapMember, MetricsMapFactoryPtr> >& subMaps) :
-        MetricsMapI(mapPrefix, properties), _destroyed(false)
+        MetricsMapI(mapPrefix, properties), _groupBy(0), _destroyed(false)
     {
         std::vector<std::string> subMapNames;
         typename std::map<std::string, std::pair<SubMapMember, MetricsMapFactoryPtr> >::const_iterator p;
@@ -282,10 +462,16 @@ public:
         :
         MetricsMapI(other),
         IceUtil::Mutex(),
+        _groupBy(0),
         _destroyed(false)
     {
     }
 
+    ~MetricsMapT()
+    {
+        delete _groupBy.load();
+    }
+
     std::shared_ptr<MetricsMapT> shared_from_this()
     {
         return std::static_pointer_cast<MetricsMapT>(MetricsMapI::shared_from_this());
@@ -382,24 +568,22 @@ public:
         std::string key;
         try
         {
+            const GroupBy* groupBy = getGroupBy(helper);
             if(_groupByAttributes.size() == 1)
             {
-                key = helper(_groupByAttributes.front());
+                key = resolve(helper, groupBy, 0);
             }
             else
             {
-                std::ostringstream os;
                 std::vector<std::string>::const_iterator q = _groupBySeparators.begin();
-                for(std::vector<std::string>::const_iterator p = _groupByAttributes.begin();
-                    p != _groupByAttributes.end(); ++p)
+                for(size_t i = 0; i < _groupByAttributes.size(); ++i)
                 {
-                    os << helper(*p);
+                    key += resolve(helper, groupBy, i);
                     if(q != _groupBySeparators.end())
                     {
-                        os << *q++;
+                        key += *q++;
                     }
                 }
-                key = os.str();
             }
         }
         catch(const std::exception&)
@@ -438,6 +622,58 @@ public:
 
 private:
 
+    //
+    // The resolvers of the GroupBy attributes for a given helper type, a
+    // null resolver means the attribute is resolved by name.
+    //
+    struct GroupBy
+    {
+        const std::type_info* type;
+        std::vector<const typename IceMX::MetricsHelperT<T>::Resolver*> resolvers;
+    };
+
+    const GroupBy*
+    getGroupBy(const IceMX::MetricsHelperT<T>& helper)
+    {
+        //
+        // The resolvers are obtained for the first helper type used with this
+        // map, the attributes of other helper types are resolved by name.
+        //
+        const GroupBy* groupBy = _groupBy.load();
+        if(!groupBy)
+        {
+            GroupBy* newGroupBy = new GroupBy();
+            newGroupBy->type = &typeid(helper);
+            for(std::vector<std::string>::const_iterator p = _groupByAttributes.begin();
+                p != _groupByAttributes.end(); ++p)
+            {
+                newGroupBy->resolvers.push_back(helper.getResolver(*p));
+            }
+
+            GroupBy* expected = 0;
+            if(_groupBy.compare_exchange_strong(expected, newGroupBy))
+            {
+                groupBy = newGroupBy;
+            }
+            else
+            {
+                delete newGroupBy;
+                groupBy = expected;
+            }
+        }
+        return *groupBy->type == typeid(helper) ? groupBy : 0;
+    }
+
+    std::string
+    resolve(const IceMX::MetricsHelperT<T>& helper, const GroupBy* groupBy, size_t i) const
+    {
+        if(groupBy && groupBy->resolvers[i])
+        {
+            return groupBy->resolvers[i]->resolve(&helper);
+        }
+        return helper(_groupByAttributes[i]);
+    }
+
     virtual MetricsMapIPtr clone() const
     {
         return std::make_shared<MetricsMapT<MetricsType>>(*this);
@@ -445,9 +681,13 @@ private:
 
     void detached(EntryTPtr entry)
     {
-        // This is called with the map mutex locked.
+        Lock sync(*this);
 
-        if(_retain == 0 || _destroyed)
+        //
+        // The entry might have been attached again before we locked the map,
+        // entries are only attached with the map locked.
+        //
+        if(_retain == 0 || _destroyed || !entry->isDetached())
         {
             return;
         }
@@ -499,6 +739,7 @@ private:
 
     friend class EntryT;
 
+    std::atomic<GroupBy*> _groupBy;
     bool _destroyed;
     std::map<std::string, EntryTPtr> _objects;
     std::list<EntryTPtr> _detachedQueue;
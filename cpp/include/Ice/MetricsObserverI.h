@@ -25,12 +25,56 @@ template<typename T> class MetricsHelperT
 {
 public:
 
+    //
+    // A resolver for a single attribute of a given helper type. Metrics maps
+    // obtain the resolvers of their attributes once to avoid looking up the
+    // attributes by name each time a metrics object is matched.
+    //
+    class Resolver
+    {
+    public:
+
+        virtual ~Resolver()
+        {
+        }
+
+        virtual std::string resolve(const MetricsHelperT*) const = 0;
+    };
+
+    //
+    // The attributes of a helper type, see AttributeResolverT.
+    //
+    class AttributeResolver
+    {
+    public:
+
+        virtual ~AttributeResolver()
+        {
+        }
+
+        virtual const Resolver* getResolver(const std::string&) const = 0;
+    };
+
+    MetricsHelperT() : _attributes(0)
+    {
+    }
+
     virtual ~MetricsHelperT()
     {
     }
 
     virtual std::string operator()(const std::string&) const = 0;
 
+    //
+    // Returns the resolver for the given attribute or null if the attribute
+    // can only be resolved by name with operator().
+    //
+    const Resolver*
+    getResolver(const std::string& attribute) const
+    {
+        return _attributes ? _attributes->getResolver(attribute) : 0;
+    }
+
     virtual void initMetrics(const std::shared_ptr<T>&) const
     {
         // To be overriden in specialization to initialize state attributes
@@ -38,9 +82,13 @@ public:
 
 protected:
 
-    template<typename Helper> class AttributeResolverT
+    MetricsHelperT(const AttributeResolver& attributes) : _attributes(&attributes)
     {
-        class Resolver
+    }
+
+    template<typename Helper> class AttributeResolverT : public AttributeResolver
+    {
+        class Resolver : public MetricsHelperT::Resolver
         {
         public:
 
@@ -54,6 +102,11 @@ protected:
 
             virtual std::string operator()(const Helper* h) const = 0;
 
+            virtual std::string resolve(const MetricsHelperT* h) const
+            {
+                return (*this)(static_cast<const Helper*>(h));
+            }
+
         protected:
 
             std::string _name;
@@ -91,6 +144,13 @@ protected:
             return (*p->second)(helper);
         }
 
+        virtual const typename MetricsHelperT::Resolver*
+        getResolver(const std::string& attribute) const
+        {
+            typename std::map<std::string, Resolver*>::const_iterator p = _attributes.find(attribute);
+            return p == _attributes.end() ? 0 : p->second;
+        }
+
         void
         setDefault(std::string (Helper::*memberFn)(const std::string&) const)
         {
@@ -291,6 +351,12 @@ protected:
             return s;
         }
 
+        static std::string
+        toString(int v)
+        {
+            return std::to_string(v);
+        }
+
         static std::string
         toString(const ::Ice::EndpointPtr& e)
         {
@@ -312,6 +378,10 @@ protected:
         std::map<std::string, Resolver*> _attributes;
         std::string (Helper::*_default)(const std::string&) const;
     };
+
+private:
+
+    const AttributeResolver* _attributes;
 };
 
 class Updater
@@ -480,6 +550,7 @@ public:
     using ObserverImplPtrType = ::std::shared_ptr<ObserverImplType>;
     using MetricsType = typename ObserverImplType::MetricsType;
     using MetricsMapSeqType = std::vector<::std::shared_ptr<IceInternal::MetricsMapT<MetricsType>>>;
+    using MetricsMapSeqPtrType = ::std::shared_ptr<const MetricsMapSeqType>;
 
     ObserverFactoryT(const IceInternal::MetricsAdminIPtr& metrics, const std::string& name) :
         _metrics(metrics), _name(name), _enabled(0)
@@ -498,14 +569,18 @@ public:
     ObserverImplPtrType
     getObserver(const MetricsHelperT<MetricsType>& helper)
     {
-        IceUtil::Mutex::Lock sync(*this);
-        if(!_metrics)
+        //
+        // The maps are matched without holding the mutex, each map is
+        // responsible for its own synchronization.
+        //
+        MetricsMapSeqPtrType maps = getMaps();
+        if(!maps)
         {
             return nullptr;
         }
 
         typename ObserverImplType::EntrySeqType metricsObjects;
-        for(typename MetricsMapSeqType::const_iterator p = _maps.begin(); p != _maps.end(); ++p)
+        for(typename MetricsMapSeqType::const_iterator p = maps->begin(); p != maps->end(); ++p)
         {
             typename ObserverImplType::EntryPtrType entry = (*p)->getMatching(helper);
             if(entry)
@@ -533,14 +608,15 @@ public:
         {
             return getObserver(helper);
         }
-        IceUtil::Mutex::Lock sync(*this);
-        if(!_metrics)
+
+        MetricsMapSeqPtrType maps = getMaps();
+        if(!maps)
         {
             return nullptr;
         }
 
         typename ObserverImplType::EntrySeqType metricsObjects;
-        for(typename MetricsMapSeqType::const_iterator p = _maps.begin(); p != _maps.end(); ++p)
+        for(typename MetricsMapSeqType::const_iterator p = maps->begin(); p != maps->end(); ++p)
         {
             typename ObserverImplType::EntryPtrType entry = (*p)->getMatching(helper, old->getEntry(p->get()));
             if(entry)
@@ -582,13 +658,14 @@ public:
             }
 
             std::vector<IceInternal::MetricsMapIPtr> maps = _metrics->getMaps(_name);
-            _maps.clear();
+            std::shared_ptr<MetricsMapSeqType> newMaps = std::make_shared<MetricsMapSeqType>();
             for(std::vector<IceInternal::MetricsMapIPtr>::const_iterator p = maps.begin(); p != maps.end(); ++p)
             {
-                _maps.push_back(::std::dynamic_pointer_cast<IceInternal::MetricsMapT<MetricsType>>(*p));
-                assert(_maps.back());
+                newMaps->push_back(::std::dynamic_pointer_cast<IceInternal::MetricsMapT<MetricsType>>(*p));
+                assert(newMaps->back());
             }
-            _enabled.exchange(_maps.empty() ? 0 : 1);
+            _maps = newMaps;
+            _enabled.exchange(_maps->empty() ? 0 : 1);
             updater = _updater;
         }
 
@@ -608,14 +685,24 @@ public:
     {
         IceUtil::Mutex::Lock sync(*this);
         _metrics = 0;
-        _maps.clear();
+        _maps = nullptr;
     }
 
 private:
 
+    MetricsMapSeqPtrType
+    getMaps()
+    {
+        //
+        // The sequence of maps is immutable, update() replaces it.
+        //
+        IceUtil::Mutex::Lock sync(*this);
+        return _metrics ? _maps : nullptr;
+    }
+
     IceInternal::MetricsAdminIPtr _metrics;
     const std::string _name;
-    MetricsMapSeqType _maps;
+    MetricsMapSeqPtrType _maps;
     //
     // TODO: Replace by std::atomic<bool> when it becomes widely
     // available.
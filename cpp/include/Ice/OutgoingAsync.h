@@ -20,6 +20,7 @@
 #include <Ice/UniquePtr.h>
 
 #include <exception>
+#include <atomic>
 
 namespace IceInternal
 {
@@ -27,6 +28,30 @@ namespace IceInternal
 class RetryException;
 class CollocatedRequestHandler;
 
+//
+// A request queued by a connection without locking the connection, see
+// MessageQueue. It's embedded in the request so that queuing a request
+// doesn't allocate. The request holds a reference to itself while queued.
+//
+// The queued flag is set before the request becomes cancelable and until
+// it's popped: a request canceled while it can't be popped yet is flagged
+// as canceled and dropped once popped.
+//
+struct QueuedRequest
+{
+    QueuedRequest() :
+        next(nullptr), compress(false), requestId(0), queued(false), canceled(false)
+    {
+    }
+
+    std::atomic<QueuedRequest*> next;
+    OutgoingAsyncBasePtr outAsync;
+    bool compress;
+    Ice::Int requestId;
+    std::atomic<bool> queued;
+    std::atomic<bool> canceled;
+};
+
 class ICE_API OutgoingAsyncCompletionCallback
 {
 public:
@@ -90,6 +115,11 @@ public:
         return &_is;
     }
 
+    QueuedRequest* getQueuedRequest()
+    {
+        return &_queuedRequest;
+    }
+
 protected:
 
     OutgoingAsyncBase(const InstancePtr&);
@@ -133,6 +163,8 @@ protected:
 
     CancellationHandlerPtr _cancellationHandler;
 
+    QueuedRequest _queuedRequest;
+
     static const unsigned char OK;
     static const unsigned char Sent;
 };
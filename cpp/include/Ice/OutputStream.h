@@ -14,6 +14,7 @@
 #include <Ice/Protocol.h>
 #include <Ice/SlicedDataF.h>
 #include <Ice/StreamHelpers.h>
+#include <Ice/SharedByteSeq.h>
 
 namespace Ice
 {
@@ -542,6 +543,15 @@ public:
      */
     void write(const Byte* start, const Byte* end);
 
+    /**
+     * Writes a byte sequence to the stream.
+     * @param v The sequence to be written.
+     */
+    void write(const SharedByteSeq& v)
+    {
+        write(v.begin(), v.end());
+    }
+
     /**
      * Writes a boolean to the stream.
      * @param v The boolean to write.
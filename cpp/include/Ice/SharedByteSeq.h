@@ -0,0 +1,141 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_SHARED_BYTE_SEQ_H
+#define ICE_SHARED_BYTE_SEQ_H
+
+#include <Ice/Config.h>
+#include <Ice/StreamHelpers.h>
+
+namespace Ice
+{
+
+/**
+ * An immutable byte sequence with shared ownership of its memory. When a
+ * large byte sequence is unmarshaled into a SharedByteSeq, it references
+ * the message buffer it was received in instead of copying the bytes: the
+ * buffer is kept alive for as long as the sequence (or a copy of it) exists,
+ * including after the dispatch or the AMI callback returned.
+ *
+ * Use it with the cpp:type or cpp:view-type metadata on a sequence<byte>
+ * parameter or return value, for example [cpp:type(Ice::SharedByteSeq)].
+ * \headerfile Ice/Ice.h
+ */
+class SharedByteSeq
+{
+public:
+
+    typedef Byte value_type;
+    typedef const Byte* iterator;
+    typedef const Byte* const_iterator;
+    typedef const Byte& reference;
+    typedef const Byte& const_reference;
+    typedef size_t size_type;
+
+    /**
+     * Constructs an empty sequence.
+     */
+    SharedByteSeq() :
+        _size(0)
+    {
+    }
+
+    /**
+     * Constructs a sequence which takes ownership of the given vector.
+     * @param bytes The vector holding the bytes.
+     */
+    SharedByteSeq(std::vector<Byte> bytes) :
+        _size(bytes.size())
+    {
+        if(_size > 0)
+        {
+            std::shared_ptr<std::vector<Byte>> v = std::make_shared<std::vector<Byte>>(std::move(bytes));
+            _data = std::shared_ptr<const Byte>(v, v->data());
+        }
+    }
+
+    /**
+     * Constructs a sequence with a copy of the given bytes.
+     * @param begin The beginning of the bytes.
+     * @param end The end of the bytes.
+     */
+    SharedByteSeq(const Byte* begin, const Byte* end) :
+        SharedByteSeq(std::vector<Byte>(begin, end))
+    {
+    }
+
+    /**
+     * Constructs a sequence which references memory kept alive by the given
+     * pointer.
+     * @param data A pointer to the first byte, it shares the ownership of the
+     * memory holding the bytes.
+     * @param size The number of bytes.
+     */
+    SharedByteSeq(std::shared_ptr<const Byte> data, size_type size) :
+        _data(std::move(data)),
+        _size(size)
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return _data.get();
+    }
+
+    const_iterator end() const
+    {
+        return _data.get() + _size;
+    }
+
+    const Byte* data() const
+    {
+        return _data.get();
+    }
+
+    size_type size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    const_reference operator[](size_type n) const
+    {
+        assert(n < _size);
+        return _data.get()[n];
+    }
+
+    /**
+     * Returns the pointer sharing the ownership of the memory.
+     * @return The pointer to the first byte.
+     */
+    const std::shared_ptr<const Byte>& memory() const
+    {
+        return _data;
+    }
+
+private:
+
+    std::shared_ptr<const Byte> _data;
+    size_type _size;
+};
+
+/**
+ * SharedByteSeq is marshaled like a byte sequence, the streams handle it like a built-in type.
+ * \headerfile Ice/Ice.h
+ */
+template<>
+struct StreamableTraits<SharedByteSeq>
+{
+    static const StreamHelperCategory helper = StreamHelperCategoryBuiltin;
+    static const int minWireSize = 1;
+    static const bool fixedLength = false;
+};
+
+}
+
+#endif
@@ -10,8 +10,10 @@
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Time.h>
 
-#include <set>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace IceUtil
 {
@@ -36,7 +38,9 @@ ICE_DEFINE_PTR(TimerTaskPtr, TimerTask);
 //
 // The timer class is used to schedule tasks for one-time execution or
 // repeated execution. Tasks are executed by the dedicated timer thread
-// sequentially.
+// sequentially, or concurrently by the timer threads if additional threads
+// were started with addThreads(). Tasks run at the earliest on the first
+// millisecond tick following their scheduled time.
 //
 class ICE_API Timer : public virtual IceUtil::Shared, private IceUtil::Thread
 {
@@ -53,8 +57,15 @@ public:
     Timer(int priority);
 
     //
-    // Destroy the timer and detach its execution thread if the calling thread
-    // is the timer thread, join the timer execution thread otherwise.
+    // Start the given number of additional execution threads, with the
+    // priority of the timer thread. Tasks no longer run sequentially once
+    // the timer has more than one thread.
+    //
+    void addThreads(int);
+
+    //
+    // Destroy the timer and detach its execution threads if the calling thread
+    // is a timer thread, join the timer execution threads otherwise.
     //
     void destroy();
 
@@ -82,59 +93,71 @@ protected:
     virtual void run();
     virtual void runTimerTask(const TimerTaskPtr&);
 
+    //
+    // The scheduled tasks are kept in a hierarchical timing wheel with a
+    // one millisecond tick. Each level has 64 slots and a slot of level n
+    // covers 64^n ticks: a token is linked to the slot of the lowest level
+    // which doesn't share its expiration tick with the current tick, and
+    // moves down one level each time the wheel reaches this slot. Scheduling
+    // and canceling a task are therefore O(1), and the occupancy bitmap of
+    // each level gives the next tick to process without scanning the slots.
+    //
+    enum { WheelBits = 6, WheelSlots = 1 << WheelBits, WheelLevels = 9 };
+
     struct Token
     {
-        IceUtil::Time scheduledTime;
         IceUtil::Time delay;
         TimerTaskPtr task;
+        IceUtil::Int64 expiration;
+        bool running;
+        int level; // -1 if in the ready list
+        int slot;
+        Token* prev;
+        Token* next;
+
+        inline Token(const IceUtil::Time&, const TimerTaskPtr&, IceUtil::Int64);
+    };
 
-        inline Token(const IceUtil::Time&, const IceUtil::Time&, const TimerTaskPtr&);
-        inline bool operator<(const Token& r) const;
+    struct TokenList
+    {
+        Token* head;
+        Token* tail;
     };
 
     IceUtil::Monitor<IceUtil::Mutex> _monitor;
     bool _destroyed;
-    std::set<Token> _tokens;
+    const IceUtil::Time _epoch;
+    IceUtil::Int64 _tick;
+    TokenList _wheel[WheelLevels][WheelSlots];
+    unsigned long long _occupied[WheelLevels];
+    TokenList _ready;
+    std::unordered_map<TimerTask*, Token*> _tasks;
+    IceUtil::Time _wakeUpTime;
 
-#if (ICE_CPLUSPLUS >= 201703L)
-    class TimerTaskCompare
-#else
-    class TimerTaskCompare : public std::binary_function<TimerTaskPtr, TimerTaskPtr, bool>
-#endif
-    {
-    public:
+private:
 
-        bool operator()(const TimerTaskPtr& lhs, const TimerTaskPtr& rhs) const
-        {
-            return lhs.get() < rhs.get();
-        }
-    };
-    std::map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare> _tasks;
-    IceUtil::Time _wakeUpTime;
+    class TimerThread;
+
+    void scheduleToken(const TimerTaskPtr&, const IceUtil::Time&, bool);
+    IceUtil::Int64 expirationTick(const IceUtil::Time&) const;
+    void insert(Token*);
+    void unlink(Token*);
+    void advance(IceUtil::Int64);
+    IceUtil::Int64 nextTick(int&) const;
+    void clearWheel();
+
+    bool _hasPriority;
+    int _priority;
+    std::vector<IceUtil::ThreadPtr> _threads;
 };
 typedef IceUtil::Handle<Timer> TimerPtr;
 
 inline
-Timer::Token::Token(const IceUtil::Time& st, const IceUtil::Time& d, const TimerTaskPtr& t) :
-    scheduledTime(st), delay(d), task(t)
+Timer::Token::Token(const IceUtil::Time& d, const TimerTaskPtr& t, IceUtil::Int64 e) :
+    delay(d), task(t), expiration(e), running(false), level(-1), slot(0), prev(0), next(0)
 {
 }
 
-inline bool
-Timer::Token::operator<(const Timer::Token& r) const
-{
-    if(scheduledTime < r.scheduledTime)
-    {
-        return true;
-    }
-    else if(scheduledTime > r.scheduledTime)
-    {
-        return false;
-    }
-
-    return task.get() < r.task.get();
-}
-
 }
 
 #endif
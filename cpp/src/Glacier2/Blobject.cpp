@@ -206,8 +206,9 @@ Glacier2::Blobject::invoke(shared_ptr<ObjectPrx>& proxy,
         bool override;
         try
         {
-            override = _requestQueue->addRequest(make_shared<Request>(proxy, inParams, current, _forwardContext,
-                                                                      _context, move(response), exception));
+            override = _requestQueue->addRequest(_requestQueue->createRequest(proxy, inParams, current, _forwardContext,
+                                                                                _context, move(response),
+                                                                                exception));
         }
         catch(const ObjectNotExistException&)
         {
@@ -17,6 +17,10 @@ const string serverSleepTime = "Glacier2.Server.SleepTime";
 const string clientSleepTime = "Glacier2.Client.SleepTime";
 const string serverBuffered = "Glacier2.Server.Buffered";
 const string clientBuffered = "Glacier2.Client.Buffered";
+const string serverQueueThreads = "Glacier2.Server.QueueThreads";
+const string clientQueueThreads = "Glacier2.Client.QueueThreads";
+const string serverFlushThreshold = "Glacier2.Server.FlushThreshold";
+const string clientFlushThreshold = "Glacier2.Client.FlushThreshold";
 
 }
 
@@ -32,13 +36,19 @@ Glacier2::Instance::Instance(shared_ptr<Ice::Communicator> communicator, shared_
     if(_properties->getPropertyAsIntWithDefault(serverBuffered, 0) > 0)
     {
         auto sleepTime = chrono::milliseconds(_properties->getPropertyAsInt(serverSleepTime));
-        const_cast<shared_ptr<RequestQueueThread>&>(_serverRequestQueueThread) = make_shared<RequestQueueThread>(sleepTime);
+        const_cast<shared_ptr<RequestQueueThread>&>(_serverRequestQueueThread) =
+            make_shared<RequestQueueThread>(sleepTime,
+                                            _properties->getPropertyAsIntWithDefault(serverQueueThreads, 1),
+                                            _properties->getPropertyAsIntWithDefault(serverFlushThreshold, 100));
     }
 
     if(_properties->getPropertyAsIntWithDefault(clientBuffered, 0) > 0)
     {
         auto sleepTime = chrono::milliseconds(_properties->getPropertyAsInt(clientSleepTime));
-        const_cast<shared_ptr<RequestQueueThread>&>(_clientRequestQueueThread) = make_shared<RequestQueueThread>(sleepTime);
+        const_cast<shared_ptr<RequestQueueThread>&>(_clientRequestQueueThread) =
+            make_shared<RequestQueueThread>(sleepTime,
+                                            _properties->getPropertyAsIntWithDefault(clientQueueThreads, 1),
+                                            _properties->getPropertyAsIntWithDefault(clientFlushThreshold, 100));
     }
 
     //
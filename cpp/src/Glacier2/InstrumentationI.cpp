@@ -36,7 +36,8 @@ public:
     static Attributes attributes;
 
     SessionHelper(const string& instanceName, const string& id, shared_ptr<Ice::Connection> connection, int rtSize) :
-        _instanceName(instanceName), _id(id), _connection(move(connection)), _routingTableSize(rtSize)
+        MetricsHelperT(attributes), _instanceName(instanceName), _id(id), _connection(move(connection)),
+        _routingTableSize(rtSize)
     {
     }
 
@@ -135,6 +136,19 @@ struct ForwardedUpdate
 
 }
 
+void
+IceMX::addMetrics(SessionMetrics& to, const SessionMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.forwardedClient += from.forwardedClient;
+    to.forwardedServer += from.forwardedServer;
+    to.routingTableSize += from.routingTableSize;
+    to.queuedClient += from.queuedClient;
+    to.queuedServer += from.queuedServer;
+    to.overriddenClient += from.overriddenClient;
+    to.overriddenServer += from.overriddenServer;
+}
+
 void
 SessionObserverI::forwarded(bool client)
 {
@@ -10,6 +10,13 @@
 #include <Glacier2/Instrumentation.h>
 #include <Glacier2/Metrics.h>
 
+namespace IceMX
+{
+
+void addMetrics(SessionMetrics&, const SessionMetrics&);
+
+}
+
 namespace Glacier2
 {
 
@@ -137,6 +137,53 @@ Glacier2::Request::queued()
     }
 }
 
+Glacier2::RequestPool::RequestPool(size_t max) :
+    _max(max),
+    _blockSize(0)
+{
+}
+
+Glacier2::RequestPool::~RequestPool()
+{
+    for(auto block : _blocks)
+    {
+        ::operator delete(block);
+    }
+}
+
+void*
+Glacier2::RequestPool::allocate(size_t size)
+{
+    {
+        lock_guard<mutex> lg(_mutex);
+        if(_blockSize == 0)
+        {
+            _blockSize = size;
+        }
+        else if(size == _blockSize && !_blocks.empty())
+        {
+            void* block = _blocks.back();
+            _blocks.pop_back();
+            return block;
+        }
+    }
+    return ::operator new(size);
+}
+
+void
+Glacier2::RequestPool::deallocate(void* block, size_t size)
+{
+    {
+        lock_guard<mutex> lg(_mutex);
+        if(size == _blockSize && _blocks.size() < _max)
+        {
+            _blocks.push_back(block);
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
 Glacier2::RequestQueue::RequestQueue(shared_ptr<RequestQueueThread> requestQueueThread,
                                      shared_ptr<Instance> instance,
                                      shared_ptr<Ice::Connection> connection) :
@@ -144,6 +191,7 @@ Glacier2::RequestQueue::RequestQueue(shared_ptr<RequestQueueThread> requestQueue
     _instance(move(instance)),
     _connection(move(connection)),
     _pendingSend(false),
+    _sentSynchronously(false),
     _destroyed(false)
 {
 }
@@ -191,6 +239,10 @@ Glacier2::RequestQueue::addRequest(shared_ptr<Request> request)
     {
         _observer->queued(!_connection);
     }
+    if(_requests.size() == _requestQueueThread->flushThreshold())
+    {
+        _requestQueueThread->flushThresholdReached(this);
+    }
     return false;
 }
 
@@ -259,31 +311,33 @@ Glacier2::RequestQueue::flush()
             _observer->forwarded(!_connection);
         }
 
-        shared_ptr<promise<void>> isSent = make_shared<promise<void>>();
-        shared_ptr<promise<void>> completedExceptionally = make_shared<promise<void>>();
-
         auto self = shared_from_this();
         auto request = *p;
 
+        //
+        // If the request is sent synchronously, the sent callback is called
+        // from this thread before invoke() returns. Otherwise, we wait for
+        // the sent or exception callback to flush the next requests. These
+        // callbacks are called from another thread and lock the mutex, so
+        // they can't run before _pendingSendRequest is set.
+        //
+        _sentSynchronously = false;
         request->invoke(
             [self, request](bool ok, const pair<const Byte*, const Byte*>& outParams)
             {
                 self->response(ok, outParams, request);
             },
-            [self, request, completedExceptionally](exception_ptr e)
+            [self, request](exception_ptr e)
             {
-                completedExceptionally->set_value();
                 self->exception(e, request);
             },
-            [self, request, isSent](bool sentSynchronously)
+            [self, request](bool sentSynchronously)
             {
-                isSent->set_value();
                 self->sent(sentSynchronously, request);
             }
         );
 
-        if((isSent->get_future().wait_for(0s) != future_status::ready) &&
-            (completedExceptionally->get_future().wait_for(0s) != future_status::ready))
+        if(!_sentSynchronously)
         {
             _pendingSend = true;
             _pendingSendRequest = *p++;
@@ -329,17 +383,66 @@ Glacier2::RequestQueue::exception(exception_ptr ex, const shared_ptr<Request>& r
 void
 Glacier2::RequestQueue::sent(bool sentSynchronously, const shared_ptr<Request>& request)
 {
-    if(_connection && !sentSynchronously)
+    if(_connection)
     {
-        lock_guard<mutex> lg(_mutex);
-        if(request == _pendingSendRequest)
+        if(sentSynchronously)
         {
-            flush();
+            _sentSynchronously = true; // Called from flush() with the mutex locked.
+        }
+        else
+        {
+            lock_guard<mutex> lg(_mutex);
+            if(request == _pendingSendRequest)
+            {
+                flush();
+            }
         }
     }
 }
 
-Glacier2::RequestQueueThread::RequestQueueThread(std::chrono::milliseconds sleepTime) :
+Glacier2::RequestQueueThread::RequestQueueThread(std::chrono::milliseconds sleepTime, int threads,
+                                                 int flushThreshold) :
+    _flushThreshold(static_cast<size_t>(max(flushThreshold, 0))),
+    _requestPool(make_shared<RequestPool>(1024))
+{
+    for(int i = 0; i < max(threads, 1); ++i)
+    {
+        _workers.push_back(unique_ptr<Worker>(new Worker(sleepTime)));
+    }
+}
+
+void
+Glacier2::RequestQueueThread::destroy()
+{
+    for(const auto& worker : _workers)
+    {
+        worker->destroy();
+    }
+}
+
+void
+Glacier2::RequestQueueThread::flushRequestQueue(shared_ptr<RequestQueue> queue)
+{
+    worker(queue.get()).flushRequestQueue(move(queue));
+}
+
+void
+Glacier2::RequestQueueThread::flushThresholdReached(const RequestQueue* queue)
+{
+    worker(queue).wakeUp();
+}
+
+Glacier2::RequestQueueThread::Worker&
+Glacier2::RequestQueueThread::worker(const RequestQueue* queue) const
+{
+    //
+    // The low bits of the address are the same for all the queues because
+    // of the allocation alignment.
+    //
+    return *_workers[(reinterpret_cast<uintptr_t>(queue) >> 6) % _workers.size()];
+}
+
+Glacier2::RequestQueueThread::Worker::Worker(std::chrono::milliseconds sleepTime) :
     _sleepTime(move(sleepTime)),
     _destroy(false),
     _sleep(false),
@@ -347,14 +450,14 @@ Glacier2::RequestQueueThread::RequestQueueThread(std::chrono::milliseconds sleep
 {
 }
 
-Glacier2::RequestQueueThread::~RequestQueueThread()
+Glacier2::RequestQueueThread::Worker::~Worker()
 {
     assert(_destroy);
     assert(_queues.empty());
 }
 
 void
-Glacier2::RequestQueueThread::destroy()
+Glacier2::RequestQueueThread::Worker::destroy()
 {
     {
         lock_guard<mutex> lg(_mutex);
@@ -369,7 +472,7 @@ Glacier2::RequestQueueThread::destroy()
 }
 
 void
-Glacier2::RequestQueueThread::flushRequestQueue(shared_ptr<RequestQueue> queue)
+Glacier2::RequestQueueThread::Worker::flushRequestQueue(shared_ptr<RequestQueue> queue)
 {
     lock_guard<mutex> lg(_mutex);
 
@@ -386,9 +489,20 @@ Glacier2::RequestQueueThread::flushRequestQueue(shared_ptr<RequestQueue> queue)
 }
 
 void
-Glacier2::RequestQueueThread::run()
+Glacier2::RequestQueueThread::Worker::wakeUp()
+{
+    lock_guard<mutex> lg(_mutex);
+    if(_sleep)
+    {
+        _sleep = false;
+        _condVar.notify_one();
+    }
+}
+
+void
+Glacier2::RequestQueueThread::Worker::run()
 {
-    std::chrono::nanoseconds sleepDuration = 0ns;
+    chrono::steady_clock::time_point deadline;
 
     while(true)
     {
@@ -401,24 +515,14 @@ Glacier2::RequestQueueThread::run()
             // Wait indefinitely if there's no requests to
             // send. If the queue is being destroyed we still need to
             // wait until all the responses for twoway requests are
-            // received.
+            // received. After a flush, wait until the deadline unless
+            // a queue reaches the flush threshold (see wakeUp()).
             //
             while(!_destroy && (_queues.empty() || _sleep))
             {
                 if(_sleep)
                 {
-                    auto now = chrono::steady_clock::now();
-
-                    if(_condVar.wait_for(lock, sleepDuration) == cv_status::no_timeout)
-                    {
-                        sleepDuration = 0ns;
-                    }
-                    else
-                    {
-                        sleepDuration -= chrono::steady_clock::now() - now;
-                    }
-
-                    if(sleepDuration <= 0ns)
+                    if(_condVar.wait_until(lock, deadline) == cv_status::timeout)
                     {
                         _sleep = false;
                     }
@@ -445,7 +549,7 @@ Glacier2::RequestQueueThread::run()
             if(_sleepTime > 0ms)
             {
                 _sleep = true;
-                sleepDuration = _sleepTime;
+                deadline = chrono::steady_clock::now() + _sleepTime;
             }
         }
 
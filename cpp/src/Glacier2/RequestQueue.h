@@ -10,6 +10,9 @@
 #include <Glacier2/Instrumentation.h>
 
 #include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Glacier2
 {
@@ -53,12 +56,77 @@ private:
     std::function<void(std::exception_ptr)> _exception;
 };
 
+//
+// Recycles the memory blocks of the requests. A request and its reference
+// count are allocated in a single block with std::allocate_shared, the
+// blocks of the released requests are kept for the next requests instead
+// of being freed.
+//
+class RequestPool
+{
+public:
+
+    RequestPool(size_t);
+    ~RequestPool();
+
+    void* allocate(size_t);
+    void deallocate(void*, size_t);
+
+private:
+
+    const size_t _max;
+    size_t _blockSize;
+    std::vector<void*> _blocks;
+    std::mutex _mutex;
+};
+
+template<typename T> class RequestAllocator
+{
+public:
+
+    typedef T value_type;
+
+    RequestAllocator(std::shared_ptr<RequestPool> pool) : _pool(std::move(pool))
+    {
+    }
+
+    template<typename U> RequestAllocator(const RequestAllocator<U>& other) : _pool(other._pool)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(_pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        _pool->deallocate(p, n * sizeof(T));
+    }
+
+    template<typename U> bool operator==(const RequestAllocator<U>& other) const
+    {
+        return _pool == other._pool;
+    }
+
+    template<typename U> bool operator!=(const RequestAllocator<U>& other) const
+    {
+        return _pool != other._pool;
+    }
+
+private:
+
+    template<typename U> friend class RequestAllocator;
+    std::shared_ptr<RequestPool> _pool;
+};
+
 class RequestQueue : public std::enable_shared_from_this<RequestQueue>
 {
 public:
 
     RequestQueue(std::shared_ptr<RequestQueueThread>, std::shared_ptr<Instance>, std::shared_ptr<Ice::Connection>);
 
+    template<typename... Args> std::shared_ptr<Request> createRequest(Args&&...);
     bool addRequest(std::shared_ptr<Request>);
     void flushRequests();
 
@@ -80,6 +148,7 @@ private:
 
     std::deque<std::shared_ptr<Request>> _requests;
     bool _pendingSend;
+    bool _sentSynchronously;
     std::shared_ptr<Request> _pendingSendRequest;
     bool _destroyed;
     std::shared_ptr<Glacier2::Instrumentation::SessionObserver> _observer;
@@ -87,30 +156,70 @@ private:
     std::mutex _mutex;
 };
 
+//
+// Flushes the request queues of the sessions. The queues are spread over
+// worker threads by address so that a queue is always flushed by the same
+// thread. After a flush, a worker waits until the sleep time deadline to
+// batch the requests queued in the meantime, unless a session queue
+// reaches the flush threshold first.
+//
 class RequestQueueThread
 {
 public:
 
-    RequestQueueThread(std::chrono::milliseconds);
-    ~RequestQueueThread();
+    RequestQueueThread(std::chrono::milliseconds, int, int);
+
+    template<typename... Args> std::shared_ptr<Request> createRequest(Args&&... args)
+    {
+        return std::allocate_shared<Request>(RequestAllocator<Request>(_requestPool), std::forward<Args>(args)...);
+    }
 
     void flushRequestQueue(std::shared_ptr<RequestQueue>);
+    void flushThresholdReached(const RequestQueue*);
+    size_t flushThreshold() const { return _flushThreshold; }
     void destroy();
 
 private:
-    void run();
 
-    const std::chrono::milliseconds _sleepTime;
-    bool _destroy;
-    bool _sleep;
+    class Worker
+    {
+    public:
 
-    std::vector<std::shared_ptr<RequestQueue>> _queues;
+        Worker(std::chrono::milliseconds);
+        ~Worker();
 
-    std::mutex _mutex;
-    std::condition_variable _condVar;
-    std::thread _thread;
+        void flushRequestQueue(std::shared_ptr<RequestQueue>);
+        void wakeUp();
+        void destroy();
+
+    private:
+
+        void run();
+
+        const std::chrono::milliseconds _sleepTime;
+        bool _destroy;
+        bool _sleep;
+
+        std::vector<std::shared_ptr<RequestQueue>> _queues;
+
+        std::mutex _mutex;
+        std::condition_variable _condVar;
+        std::thread _thread;
+    };
+
+    Worker& worker(const RequestQueue*) const;
+
+    const size_t _flushThreshold;
+    const std::shared_ptr<RequestPool> _requestPool;
+    std::vector<std::unique_ptr<Worker>> _workers;
 };
 
+template<typename... Args> std::shared_ptr<Request>
+RequestQueue::createRequest(Args&&... args)
+{
+    return _requestQueueThread->createRequest(std::forward<Args>(args)...);
+}
+
 }
 
 #endif
@@ -4,11 +4,43 @@
 
 #include <Ice/Buffer.h>
 #include <Ice/LocalException.h>
+#include <Ice/BufferPool.h>
 
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
+namespace
+{
+
+class SharedMemoryDeleter
+{
+public:
+
+    SharedMemoryDeleter(const BufferPoolPtr& pool, size_t capacity) : _pool(pool), _capacity(capacity)
+    {
+    }
+
+    void operator()(Byte* p) const
+    {
+        if(_pool)
+        {
+            _pool->release(p, _capacity);
+        }
+        else
+        {
+            ::free(p);
+        }
+    }
+
+private:
+
+    BufferPoolPtr _pool;
+    size_t _capacity;
+};
+
+}
+
 void
 IceInternal::Buffer::swapBuffer(Buffer& other)
 {
@@ -21,7 +53,8 @@ IceInternal::Buffer::Container::Container() :
     _size(0),
     _capacity(0),
     _shrinkCounter(0),
-    _owned(true)
+    _owned(true),
+    _pooled(false)
 {
 }
 
@@ -30,12 +63,14 @@ IceInternal::Buffer::Container::Container(const_iterator beg, const_iterator end
     _size(static_cast<size_t>(end - beg)),
     _capacity(static_cast<size_t>(end - beg)),
     _shrinkCounter(0),
-    _owned(false)
+    _owned(false),
+    _pooled(false)
 {
 }
 
 IceInternal::Buffer::Container::Container(const vector<value_type>& v) :
-    _shrinkCounter(0)
+    _shrinkCounter(0),
+    _pooled(false)
 {
     if(v.empty())
     {
@@ -53,7 +88,8 @@ IceInternal::Buffer::Container::Container(const vector<value_type>& v) :
     }
 }
 
-IceInternal::Buffer::Container::Container(Container& other, bool adopt)
+IceInternal::Buffer::Container::Container(Container& other, bool adopt) :
+    _pool(other._pool)
 {
     if(adopt)
     {
@@ -62,12 +98,15 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
         _capacity = other._capacity;
         _shrinkCounter = other._shrinkCounter;
         _owned = other._owned;
+        _pooled = other._pooled;
+        _shared.swap(other._shared);
 
         other._buf = 0;
         other._size = 0;
         other._capacity = 0;
         other._shrinkCounter = 0;
         other._owned = true;
+        other._pooled = false;
     }
     else
     {
@@ -76,15 +115,13 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
         _capacity = other._capacity;
         _shrinkCounter = 0;
         _owned = false;
+        _pooled = false;
     }
 }
 
 IceInternal::Buffer::Container::~Container()
 {
-    if(_buf && _owned)
-    {
-        ::free(_buf);
-    }
+    release(_buf, _capacity);
 }
 
 void
@@ -95,21 +132,51 @@ IceInternal::Buffer::Container::swap(Container& other)
     std::swap(_capacity, other._capacity);
     std::swap(_shrinkCounter, other._shrinkCounter);
     std::swap(_owned, other._owned);
+    std::swap(_pooled, other._pooled);
+    _pool.swap(other._pool);
+    _shared.swap(other._shared);
 }
 
 void
 IceInternal::Buffer::Container::clear()
 {
-    if(_buf && _owned)
-    {
-        ::free(_buf);
-    }
+    release(_buf, _capacity);
 
     _buf = 0;
     _size = 0;
     _capacity = 0;
     _shrinkCounter = 0;
     _owned = true;
+    _pooled = false;
+    _shared.reset();
+}
+
+void
+IceInternal::Buffer::Container::setPool(const BufferPoolPtr& pool)
+{
+    //
+    // Pooled memory must be returned to the pool it was allocated from.
+    //
+    if(!_pooled)
+    {
+        _pool = pool;
+    }
+}
+
+shared_ptr<Byte>
+IceInternal::Buffer::Container::share()
+{
+    if(!_shared && _buf && _owned)
+    {
+        //
+        // The shared pointer now owns the memory, it's no longer released
+        // by this buffer.
+        //
+        _shared = shared_ptr<Byte>(_buf, SharedMemoryDeleter(_pooled ? _pool : BufferPoolPtr(), _capacity));
+        _owned = false;
+        _pooled = false;
+    }
+    return _shared;
 }
 
 void
@@ -123,33 +190,79 @@ IceInternal::Buffer::Container::reserve(size_type n)
     }
     else if(n < _capacity)
     {
+        //
+        // Shrinking a pooled buffer within its size class wouldn't free
+        // any memory, keep the buffer.
+        //
+        if(_pooled && !_shared && _pool->pooled(n) && _pool->sizeClass(n) == _capacity)
+        {
+            return;
+        }
         _capacity = n;
     }
-    else
+    else if(!_shared)
     {
         return;
     }
 
     pointer p;
-    if(_owned)
+    bool pooled = _pool && _pool->pooled(_capacity);
+    if(pooled)
+    {
+        try
+        {
+            p = _pool->allocate(_capacity); // Rounds up the capacity to the size class.
+        }
+        catch(const std::bad_alloc&)
+        {
+            _capacity = c; // Restore the previous capacity.
+            throw;
+        }
+    }
+    else if(_owned && !_pooled)
     {
         p = reinterpret_cast<pointer>(::realloc(_buf, _capacity));
+        if(!p)
+        {
+            _capacity = c; // Restore the previous capacity.
+            throw std::bad_alloc();
+        }
+        _buf = p;
+        return;
     }
     else
     {
         p = reinterpret_cast<pointer>(::malloc(_capacity));
-        if(p)
+        if(!p)
         {
-            ::memcpy(p, _buf, _size);
-            _owned = true;
+            _capacity = c; // Restore the previous capacity.
+            throw std::bad_alloc();
         }
     }
 
-    if(!p)
+    if(_buf)
     {
-        _capacity = c; // Restore the previous capacity.
-        throw std::bad_alloc();
+        ::memcpy(p, _buf, std::min(_size, _capacity));
+        release(_buf, c);
     }
-
     _buf = p;
+    _owned = true;
+    _pooled = pooled;
+    _shared.reset();
+}
+
+void
+IceInternal::Buffer::Container::release(pointer buf, size_type capacity)
+{
+    if(buf && _owned)
+    {
+        if(_pooled)
+        {
+            _pool->release(buf, capacity);
+        }
+        else
+        {
+            ::free(buf);
+        }
+    }
 }
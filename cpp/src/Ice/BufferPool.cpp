@@ -0,0 +1,169 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/BufferPool.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace Ice;
+using namespace Ice::Instrumentation;
+using namespace IceInternal;
+
+ICE_API IceUtil::Shared* IceInternal::upCast(BufferPool* p) { return p; }
+
+namespace
+{
+
+//
+// The size of the smallest size class. Buffers are never allocated with
+// less than 240 bytes (see Buffer::Container::reserve) so smaller size
+// classes would never be used.
+//
+const size_t sizeClassMin = 256;
+
+}
+
+IceInternal::BufferPool::BufferPool(size_t sizeMax, size_t cacheSize) :
+    _sizeMax(0)
+{
+    for(size_t size = sizeClassMin; size <= sizeMax; size *= 2)
+    {
+        //
+        // Each size class caches at most cacheSize bytes but always
+        // keeps at least one buffer.
+        //
+        _classes.push_back(unique_ptr<SizeClass>(new SizeClass(size, max<size_t>(1, cacheSize / size))));
+        const_cast<size_t&>(_sizeMax) = size;
+    }
+}
+
+IceInternal::BufferPool::~BufferPool()
+{
+    destroy();
+}
+
+Byte*
+IceInternal::BufferPool::allocate(size_t& n)
+{
+    assert(pooled(n));
+    SizeClass* sizeClass = getSizeClass(n);
+    n = sizeClass->size;
+
+    //
+    // The observer is notified once the size class mutex is released.
+    //
+    Byte* p = 0;
+    BufferPoolObserverPtr observer;
+    {
+        IceUtil::Mutex::Lock sync(sizeClass->mutex);
+        if(!sizeClass->buffers.empty())
+        {
+            p = sizeClass->buffers.back();
+            sizeClass->buffers.pop_back();
+        }
+        observer = sizeClass->observer.get();
+    }
+
+    if(p)
+    {
+        if(observer)
+        {
+            observer->hit();
+        }
+        return p;
+    }
+
+    if(observer)
+    {
+        observer->miss();
+    }
+
+    p = reinterpret_cast<Byte*>(::malloc(n));
+    if(!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void
+IceInternal::BufferPool::release(Byte* p, size_t n)
+{
+    assert(p && pooled(n));
+    SizeClass* sizeClass = getSizeClass(n);
+    assert(sizeClass->size == n);
+    {
+        IceUtil::Mutex::Lock sync(sizeClass->mutex);
+        if(sizeClass->buffers.size() < sizeClass->max)
+        {
+            sizeClass->buffers.push_back(p);
+            return;
+        }
+    }
+    ::free(p);
+}
+
+void
+IceInternal::BufferPool::updateObservers(const CommunicatorObserverPtr& observer)
+{
+    for(vector<unique_ptr<SizeClass>>::const_iterator p = _classes.begin(); p != _classes.end(); ++p)
+    {
+        SizeClass* sizeClass = p->get();
+
+        BufferPoolObserverPtr old;
+        {
+            IceUtil::Mutex::Lock sync(sizeClass->mutex);
+            old = sizeClass->observer.get();
+        }
+
+        //
+        // Don't call on the communicator observer with the size class
+        // mutex locked.
+        //
+        BufferPoolObserverPtr o;
+        if(observer)
+        {
+            ostringstream os;
+            os << sizeClass->size;
+            o = observer->getBufferPoolObserver(os.str(), old);
+        }
+
+        IceUtil::Mutex::Lock sync(sizeClass->mutex);
+        sizeClass->observer.attach(o);
+    }
+}
+
+void
+IceInternal::BufferPool::destroy()
+{
+    //
+    // Free the cached buffers and stop caching released buffers, the
+    // buffers still in use might outlive the communicator.
+    //
+    for(vector<unique_ptr<SizeClass>>::const_iterator p = _classes.begin(); p != _classes.end(); ++p)
+    {
+        SizeClass* sizeClass = p->get();
+        IceUtil::Mutex::Lock sync(sizeClass->mutex);
+        for(vector<Byte*>::const_iterator q = sizeClass->buffers.begin(); q != sizeClass->buffers.end(); ++q)
+        {
+            ::free(*q);
+        }
+        sizeClass->buffers.clear();
+        sizeClass->max = 0;
+        sizeClass->observer.detach();
+    }
+}
+
+BufferPool::SizeClass*
+IceInternal::BufferPool::getSizeClass(size_t n) const
+{
+    size_t i = 0;
+    for(size_t size = sizeClassMin; size < n; size *= 2)
+    {
+        ++i;
+    }
+    assert(i < _classes.size());
+    return _classes[i].get();
+}
@@ -0,0 +1,89 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_BUFFER_POOL_H
+#define ICE_BUFFER_POOL_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <Ice/BufferPoolF.h>
+#include <Ice/Instrumentation.h>
+#include <Ice/ObserverHelper.h>
+
+#include <memory>
+#include <vector>
+
+namespace IceInternal
+{
+
+//
+// The buffer pool caches the memory of the message buffers used by the
+// input and output streams of a communicator. Buffers are grouped in
+// power of two size classes, each size class keeps a bounded list of
+// free buffers. Buffers larger than the largest size class are not
+// pooled and are allocated with malloc.
+//
+class BufferPool : public IceUtil::Shared
+{
+public:
+
+    BufferPool(size_t, size_t);
+    ~BufferPool();
+
+    //
+    // Returns true if a buffer of the given size is served by the pool.
+    //
+    bool pooled(size_t n) const
+    {
+        return n <= _sizeMax;
+    }
+
+    //
+    // Returns the capacity of the buffers allocated for the given size.
+    //
+    size_t sizeClass(size_t n) const
+    {
+        return getSizeClass(n)->size;
+    }
+
+    //
+    // Allocates a buffer of at least the given size. The size is updated
+    // with the capacity of the returned buffer. Throws std::bad_alloc if
+    // the memory can't be allocated.
+    //
+    Ice::Byte* allocate(size_t&);
+
+    //
+    // Returns a buffer allocated with allocate() to the pool.
+    //
+    void release(Ice::Byte*, size_t);
+
+    void updateObservers(const Ice::Instrumentation::CommunicatorObserverPtr&);
+
+    void destroy();
+
+private:
+
+    struct SizeClass
+    {
+        SizeClass(size_t s, size_t m) : size(s), max(m)
+        {
+        }
+
+        IceUtil::Mutex mutex;
+        const size_t size;
+        size_t max;
+        std::vector<Ice::Byte*> buffers;
+        ObserverHelperT<Ice::Instrumentation::BufferPoolObserver> observer;
+    };
+
+    SizeClass* getSizeClass(size_t) const;
+
+    const size_t _sizeMax;
+    std::vector<std::unique_ptr<SizeClass>> _classes;
+};
+
+}
+
+#endif
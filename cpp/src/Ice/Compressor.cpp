@@ -0,0 +1,464 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Compressor.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+#include <IceUtil/FileUtil.h>
+#include <IceUtil/Mutex.h>
+
+#include <fstream>
+
+#ifdef ICE_HAS_BZIP2
+#  include <bzlib.h>
+#endif
+
+#ifdef ICE_HAS_ZSTD
+#  include <zstd.h>
+#endif
+
+#ifdef ICE_HAS_LZ4
+#  include <lz4.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(Compressor* p) { return p; }
+IceUtil::Shared* IceInternal::upCast(CompressorRegistry* p) { return p; }
+
+namespace
+{
+
+int
+clamp(int value, int min, int max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+#ifdef ICE_HAS_BZIP2
+
+string
+getBZ2Error(int bzError)
+{
+    if(bzError == BZ_RUN_OK)
+    {
+        return ": BZ_RUN_OK";
+    }
+    else if(bzError == BZ_FLUSH_OK)
+    {
+        return ": BZ_FLUSH_OK";
+    }
+    else if(bzError == BZ_FINISH_OK)
+    {
+        return ": BZ_FINISH_OK";
+    }
+    else if(bzError == BZ_STREAM_END)
+    {
+        return ": BZ_STREAM_END";
+    }
+    else if(bzError == BZ_CONFIG_ERROR)
+    {
+        return ": BZ_CONFIG_ERROR";
+    }
+    else if(bzError == BZ_SEQUENCE_ERROR)
+    {
+        return ": BZ_SEQUENCE_ERROR";
+    }
+    else if(bzError == BZ_PARAM_ERROR)
+    {
+        return ": BZ_PARAM_ERROR";
+    }
+    else if(bzError == BZ_MEM_ERROR)
+    {
+        return ": BZ_MEM_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR)
+    {
+        return ": BZ_DATA_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR_MAGIC)
+    {
+        return ": BZ_DATA_ERROR_MAGIC";
+    }
+    else if(bzError == BZ_IO_ERROR)
+    {
+        return ": BZ_IO_ERROR";
+    }
+    else if(bzError == BZ_UNEXPECTED_EOF)
+    {
+        return ": BZ_UNEXPECTED_EOF";
+    }
+    else if(bzError == BZ_OUTBUFF_FULL)
+    {
+        return ": BZ_OUTBUFF_FULL";
+    }
+    else
+    {
+        return "";
+    }
+}
+
+class Bzip2Compressor : public Compressor
+{
+public:
+
+    Bzip2Compressor(const PropertiesPtr& properties) :
+        _level(clamp(properties->getPropertyAsIntWithDefault("Ice.Compression.Level", 1), 1, 9))
+    {
+    }
+
+    virtual Byte id() const
+    {
+        return 2;
+    }
+
+    virtual string name() const
+    {
+        return "bzip2";
+    }
+
+    virtual size_t compressBound(size_t size) const
+    {
+        return static_cast<size_t>(static_cast<double>(size) * 1.01 + 600);
+    }
+
+    virtual size_t compress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        unsigned int compressedLen = static_cast<unsigned int>(dstSize);
+        int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(dst), &compressedLen,
+                                               const_cast<char*>(reinterpret_cast<const char*>(src)),
+                                               static_cast<unsigned int>(srcSize), _level, 0, 0);
+        if(bzError != BZ_OK)
+        {
+            throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError));
+        }
+        return compressedLen;
+    }
+
+    virtual void uncompress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        unsigned int uncompressedLen = static_cast<unsigned int>(dstSize);
+        int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(dst), &uncompressedLen,
+                                                 const_cast<char*>(reinterpret_cast<const char*>(src)),
+                                                 static_cast<unsigned int>(srcSize), 0, 0);
+        if(bzError != BZ_OK)
+        {
+            throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffDecompress failed" +
+                                       getBZ2Error(bzError));
+        }
+    }
+
+private:
+
+    const int _level;
+};
+
+#endif
+
+#ifdef ICE_HAS_ZSTD
+
+//
+// Zstandard compressor. The compression and decompression contexts are
+// expensive to create so they are cached and reused across messages. If
+// a dictionary is configured, it must be the same on both sides.
+//
+class ZstdCompressor : public Compressor
+{
+public:
+
+    ZstdCompressor(const PropertiesPtr& properties) :
+        _level(clamp(properties->getPropertyAsIntWithDefault("Ice.Compression.Zstd.Level", 3), 1,
+                     ZSTD_maxCLevel())),
+        _cdict(0),
+        _ddict(0)
+    {
+        string file = properties->getProperty("Ice.Compression.Zstd.Dictionary");
+        if(!file.empty())
+        {
+            ifstream in(IceUtilInternal::streamFilename(file).c_str(), ios::binary);
+            if(!in)
+            {
+                throw InitializationException(__FILE__, __LINE__, "cannot open zstd dictionary `" + file + "'");
+            }
+            vector<char> dict((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+            _cdict = ZSTD_createCDict(dict.data(), dict.size(), _level);
+            _ddict = ZSTD_createDDict(dict.data(), dict.size());
+            if(!_cdict || !_ddict)
+            {
+                ZSTD_freeCDict(_cdict);
+                ZSTD_freeDDict(_ddict);
+                throw InitializationException(__FILE__, __LINE__, "invalid zstd dictionary `" + file + "'");
+            }
+        }
+    }
+
+    virtual ~ZstdCompressor()
+    {
+        for(vector<ZSTD_CCtx*>::const_iterator p = _cctxs.begin(); p != _cctxs.end(); ++p)
+        {
+            ZSTD_freeCCtx(*p);
+        }
+        for(vector<ZSTD_DCtx*>::const_iterator p = _dctxs.begin(); p != _dctxs.end(); ++p)
+        {
+            ZSTD_freeDCtx(*p);
+        }
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
+
+    virtual Byte id() const
+    {
+        return 3;
+    }
+
+    virtual string name() const
+    {
+        return "zstd";
+    }
+
+    virtual size_t compressBound(size_t size) const
+    {
+        return ZSTD_compressBound(size);
+    }
+
+    virtual size_t compress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        ZSTD_CCtx* cctx = 0;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            if(!_cctxs.empty())
+            {
+                cctx = _cctxs.back();
+                _cctxs.pop_back();
+            }
+        }
+        if(!cctx && !(cctx = ZSTD_createCCtx()))
+        {
+            throw CompressionException(__FILE__, __LINE__, "ZSTD_createCCtx failed");
+        }
+
+        size_t rc;
+        if(_cdict)
+        {
+            rc = ZSTD_compress_usingCDict(cctx, dst, dstSize, src, srcSize, _cdict);
+        }
+        else
+        {
+            rc = ZSTD_compressCCtx(cctx, dst, dstSize, src, srcSize, _level);
+        }
+
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            _cctxs.push_back(cctx);
+        }
+
+        if(ZSTD_isError(rc))
+        {
+            throw CompressionException(__FILE__, __LINE__, string("ZSTD_compress failed: ") + ZSTD_getErrorName(rc));
+        }
+        return rc;
+    }
+
+    virtual void uncompress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        ZSTD_DCtx* dctx = 0;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            if(!_dctxs.empty())
+            {
+                dctx = _dctxs.back();
+                _dctxs.pop_back();
+            }
+        }
+        if(!dctx && !(dctx = ZSTD_createDCtx()))
+        {
+            throw CompressionException(__FILE__, __LINE__, "ZSTD_createDCtx failed");
+        }
+
+        size_t rc;
+        if(_ddict)
+        {
+            rc = ZSTD_decompress_usingDDict(dctx, dst, dstSize, src, srcSize, _ddict);
+        }
+        else
+        {
+            rc = ZSTD_decompressDCtx(dctx, dst, dstSize, src, srcSize);
+        }
+
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            _dctxs.push_back(dctx);
+        }
+
+        if(ZSTD_isError(rc))
+        {
+            throw CompressionException(__FILE__, __LINE__, string("ZSTD_decompress failed: ") + ZSTD_getErrorName(rc));
+        }
+        else if(rc != dstSize)
+        {
+            throw CompressionException(__FILE__, __LINE__, "ZSTD_decompress failed: unexpected uncompressed size");
+        }
+    }
+
+private:
+
+    const int _level;
+    ZSTD_CDict* _cdict;
+    ZSTD_DDict* _ddict;
+
+    IceUtil::Mutex _mutex;
+    vector<ZSTD_CCtx*> _cctxs;
+    vector<ZSTD_DCtx*> _dctxs;
+};
+
+#endif
+
+#ifdef ICE_HAS_LZ4
+
+//
+// LZ4 block compressor, it trades compression ratio for speed. The
+// acceleration factor trades more ratio for more speed.
+//
+class LZ4Compressor : public Compressor
+{
+public:
+
+    LZ4Compressor(const PropertiesPtr& properties) :
+        _acceleration(max(properties->getPropertyAsIntWithDefault("Ice.Compression.LZ4.Acceleration", 1), 1))
+    {
+    }
+
+    virtual Byte id() const
+    {
+        return 4;
+    }
+
+    virtual string name() const
+    {
+        return "lz4";
+    }
+
+    virtual size_t compressBound(size_t size) const
+    {
+        return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+    }
+
+    virtual size_t compress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        int rc = LZ4_compress_fast(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                   static_cast<int>(srcSize), static_cast<int>(dstSize), _acceleration);
+        if(rc <= 0)
+        {
+            throw CompressionException(__FILE__, __LINE__, "LZ4_compress_fast failed");
+        }
+        return static_cast<size_t>(rc);
+    }
+
+    virtual void uncompress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        int rc = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                     static_cast<int>(srcSize), static_cast<int>(dstSize));
+        if(rc < 0 || static_cast<size_t>(rc) != dstSize)
+        {
+            throw CompressionException(__FILE__, __LINE__, "LZ4_decompress_safe failed");
+        }
+    }
+
+private:
+
+    const int _acceleration;
+};
+
+#endif
+
+}
+
+IceInternal::Compressor::~Compressor()
+{
+    // Out of line to avoid weak vtable
+}
+
+IceInternal::CompressorRegistry::CompressorRegistry(const PropertiesPtr& properties, const LoggerPtr& logger) :
+    _mask(0),
+    _minSize(static_cast<size_t>(max(properties->getPropertyAsIntWithDefault("Ice.CompressionMinSize", 100), 0)))
+{
+    StringSeq codecs;
+    codecs.push_back("zstd");
+    codecs.push_back("lz4");
+    codecs.push_back("bzip2");
+    codecs = properties->getPropertyAsListWithDefault("Ice.Compression.Codecs", codecs);
+
+    for(StringSeq::const_iterator p = codecs.begin(); p != codecs.end(); ++p)
+    {
+        CompressorPtr compressor;
+        if(*p == "bzip2")
+        {
+#ifdef ICE_HAS_BZIP2
+            compressor = new Bzip2Compressor(properties);
+#endif
+        }
+        else if(*p == "zstd")
+        {
+#ifdef ICE_HAS_ZSTD
+            compressor = new ZstdCompressor(properties);
+#endif
+        }
+        else if(*p == "lz4")
+        {
+#ifdef ICE_HAS_LZ4
+            compressor = new LZ4Compressor(properties);
+#endif
+        }
+        else
+        {
+            Warning out(logger);
+            out << "unknown compressor `" << *p << "' in Ice.Compression.Codecs";
+            continue;
+        }
+
+        //
+        // Compressors which are not built in are ignored, the peers
+        // negotiate one supported by both sides.
+        //
+        if(compressor && !(_mask & (1 << (compressor->id() - 1))))
+        {
+            _compressors.push_back(compressor);
+            _mask = static_cast<Byte>(_mask | (1 << (compressor->id() - 1)));
+        }
+    }
+}
+
+CompressorPtr
+IceInternal::CompressorRegistry::get(Byte id) const
+{
+    for(vector<CompressorPtr>::const_iterator p = _compressors.begin(); p != _compressors.end(); ++p)
+    {
+        if((*p)->id() == id)
+        {
+            return *p;
+        }
+    }
+    return 0;
+}
+
+CompressorPtr
+IceInternal::CompressorRegistry::select(Byte mask) const
+{
+    if(mask == 0)
+    {
+        return get(2); // Peer without compressor negotiation, only bzip2 is supported.
+    }
+
+    for(vector<CompressorPtr>::const_iterator p = _compressors.begin(); p != _compressors.end(); ++p)
+    {
+        if(mask & (1 << ((*p)->id() - 1)))
+        {
+            return *p;
+        }
+    }
+    return 0;
+}
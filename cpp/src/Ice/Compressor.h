@@ -0,0 +1,112 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_COMPRESSOR_H
+#define ICE_COMPRESSOR_H
+
+#include <IceUtil/Shared.h>
+#include <Ice/CompressorF.h>
+#include <Ice/PropertiesF.h>
+#include <Ice/LoggerF.h>
+
+#include <vector>
+
+#ifndef ICE_HAS_BZIP2
+#   define ICE_HAS_BZIP2
+#endif
+
+namespace IceInternal
+{
+
+//
+// A compressor compresses and uncompresses the body of protocol messages.
+// Its ID is the compression status written in the header of the messages
+// it compresses. Compressors are used concurrently by all the connections
+// of a communicator and must be thread-safe.
+//
+class Compressor : public IceUtil::Shared
+{
+public:
+
+    virtual ~Compressor();
+
+    virtual Ice::Byte id() const = 0;
+    virtual std::string name() const = 0;
+
+    //
+    // Returns the maximum size of the compressed data for the given
+    // uncompressed size.
+    //
+    virtual size_t compressBound(size_t) const = 0;
+
+    //
+    // Compresses the given data into the given buffer and returns the
+    // compressed size. Throws CompressionException on failure.
+    //
+    virtual size_t compress(const Ice::Byte*, size_t, Ice::Byte*, size_t) = 0;
+
+    //
+    // Uncompresses the given data into the given buffer, the buffer size
+    // is the expected uncompressed size. Throws CompressionException on
+    // failure.
+    //
+    virtual void uncompress(const Ice::Byte*, size_t, Ice::Byte*, size_t) = 0;
+};
+
+//
+// The compressors of a communicator, configured in preference order with
+// Ice.Compression.Codecs. A compressor is identified by its ID, between 2
+// (bzip2, the only compressor known to peers which don't negotiate
+// compressors) and 7.
+//
+// Compressors are negotiated per connection with bit masks of supported
+// compressor IDs: the server sends its mask with the compression status
+// of the validate connection message (ignored by older peers), the client
+// sends its mask with the compression status of uncompressed messages if
+// the server sent a mask. A peer's mask is also updated with the IDs of
+// the compressed messages it sends.
+//
+class CompressorRegistry : public IceUtil::Shared
+{
+public:
+
+    //
+    // The compression status flag of uncompressed messages carrying the
+    // compressor mask of the sender.
+    //
+    static const Ice::Byte maskFlag = 0x80;
+
+    CompressorRegistry(const Ice::PropertiesPtr&, const Ice::LoggerPtr&);
+
+    CompressorPtr get(Ice::Byte) const;
+
+    //
+    // Returns the preferred compressor supported by a peer with the given
+    // mask, the bzip2 compressor if the mask is unknown (0) or null.
+    //
+    CompressorPtr select(Ice::Byte) const;
+
+    Ice::Byte mask() const
+    {
+        return _mask;
+    }
+
+    //
+    // Messages smaller than this size are never compressed.
+    //
+    size_t minSize() const
+    {
+        return _minSize;
+    }
+
+private:
+
+    std::vector<CompressorPtr> _compressors; // Immutable, in preference order.
+    Ice::Byte _mask;
+    size_t _minSize;
+};
+
+}
+
+#endif
@@ -0,0 +1,25 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_COMPRESSOR_F_H
+#define ICE_COMPRESSOR_F_H
+
+#include <IceUtil/Shared.h>
+
+#include <Ice/Handle.h>
+
+namespace IceInternal
+{
+
+class Compressor;
+IceUtil::Shared* upCast(Compressor*);
+typedef Handle<Compressor> CompressorPtr;
+
+class CompressorRegistry;
+IceUtil::Shared* upCast(CompressorRegistry*);
+typedef Handle<CompressorRegistry> CompressorRegistryPtr;
+
+}
+
+#endif
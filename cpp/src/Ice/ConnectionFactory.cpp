@@ -73,6 +73,50 @@ find(const Map& m, const typename Map::key_type& k, Predicate predicate)
     return nullptr;
 }
 
+//
+// Returns the active connection with the least outstanding messages and
+// the number of active connections. The connections with the same number
+// of outstanding messages are returned in turn: the rotation selects the
+// connection returned first.
+//
+template<typename Map> typename Map::mapped_type
+findLeastLoaded(const Map& m, const typename Map::key_type& k, size_t rotation, size_t& count)
+{
+    typename Map::mapped_type connection;
+    auto pr = m.equal_range(k);
+    count = 0;
+    for(auto q = pr.first; q != pr.second; ++q)
+    {
+        if(q->second->isActiveOrHolding())
+        {
+            ++count;
+        }
+    }
+    if(count == 0)
+    {
+        return connection;
+    }
+
+    size_t outstanding = 0;
+    size_t rank = 0;
+    size_t i = count - rotation % count;
+    for(auto q = pr.first; q != pr.second; ++q)
+    {
+        if(q->second->isActiveOrHolding())
+        {
+            size_t n = q->second->outstandingMessages();
+            size_t r = i++ % count;
+            if(!connection || n < outstanding || (n == outstanding && r < rank))
+            {
+                connection = q->second;
+                outstanding = n;
+                rank = r;
+            }
+        }
+    }
+    return connection;
+}
+
 class StartAcceptor : public IceUtil::TimerTask
                     , public std::enable_shared_from_this<StartAcceptor>
 {
@@ -231,9 +275,14 @@ IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpt
     try
     {
         bool compress;
-        Ice::ConnectionIPtr connection = findConnection(endpoints, compress);
+        EndpointIPtr grow;
+        Ice::ConnectionIPtr connection = findConnection(endpoints, compress, grow);
         if(connection)
         {
+            if(grow)
+            {
+                growPool(grow, selType);
+            }
             callback->setConnection(connection, compress);
             return;
         }
@@ -357,7 +406,11 @@ IceInternal::OutgoingConnectionFactory::OutgoingConnectionFactory(const Communic
     _communicator(communicator),
     _instance(instance),
     _monitor(new FactoryACMMonitor(instance, instance->clientACM())),
+    _connectAttemptDelay(instance->initializationData().properties->getPropertyAsInt("Ice.ConnectAttemptDelay")),
+    _connectionPoolSize(static_cast<size_t>(
+        max(instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.ConnectionPoolSize", 1), 1))),
     _destroyed(false),
+    _poolRotation(0),
     _pendingConnectCount(0)
 {
 }
@@ -390,7 +443,8 @@ IceInternal::OutgoingConnectionFactory::applyOverrides(const vector<EndpointIPtr
 }
 
 ConnectionIPtr
-IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr>& endpoints, bool& compress)
+IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr>& endpoints, bool& compress,
+                                                       EndpointIPtr& grow)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     if(_destroyed)
@@ -402,11 +456,28 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
     assert(!endpoints.empty());
     for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
     {
-        auto connection = find(_connectionsByEndpoint, *p,
-                               [](const ConnectionIPtr& conn)
-                               {
-                                   return conn->isActiveOrHolding();
-                               });
+        ConnectionIPtr connection;
+        if(_connectionPoolSize > 1)
+        {
+            //
+            // Spread the requests over the pool connections. If the pool isn't
+            // full, the caller establishes a new connection in the background.
+            //
+            size_t count;
+            connection = findLeastLoaded(_connectionsByEndpoint, *p, _poolRotation++, count);
+            if(connection && count < _connectionPoolSize && _growingPools.insert(*p).second)
+            {
+                grow = *p;
+            }
+        }
+        else
+        {
+            connection = find(_connectionsByEndpoint, *p,
+                              [](const ConnectionIPtr& conn)
+                              {
+                                  return conn->isActiveOrHolding();
+                              });
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -424,7 +495,8 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
 }
 
 ConnectionIPtr
-IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, bool& compress)
+IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, bool grow,
+                                                       bool& compress)
 {
     // This must be called with the mutex locked.
 
@@ -436,11 +508,28 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInf
             continue;
         }
 
-        auto connection = find(_connections, p->connector,
-                               [](const ConnectionIPtr& conn)
-                               {
-                                   return conn->isActiveOrHolding();
-                               });
+        ConnectionIPtr connection;
+        if(_connectionPoolSize > 1)
+        {
+            //
+            // When growing the pool, a connection is only returned if the pool
+            // is already full.
+            //
+            size_t count;
+            connection = findLeastLoaded(_connections, p->connector, _poolRotation++, count);
+            if(grow && count < _connectionPoolSize)
+            {
+                connection = 0;
+            }
+        }
+        else
+        {
+            connection = find(_connections, p->connector,
+                              [](const ConnectionIPtr& conn)
+                              {
+                                  return conn->isActiveOrHolding();
+                              });
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -458,6 +547,59 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInf
     return 0;
 }
 
+//
+// The callback of the connection establishments growing a connection pool,
+// the established connection is added to the pool by the factory.
+//
+class IceInternal::OutgoingConnectionFactory::PoolGrowthCallback :
+    public IceInternal::OutgoingConnectionFactory::CreateConnectionCallback
+{
+public:
+
+    PoolGrowthCallback(const OutgoingConnectionFactoryPtr& factory, const EndpointIPtr& endpoint) :
+        _factory(factory), _endpoint(endpoint)
+    {
+    }
+
+    virtual void
+    setConnection(const Ice::ConnectionIPtr&, bool)
+    {
+        _factory->poolGrown(_endpoint);
+    }
+
+    virtual void
+    setException(const Ice::LocalException&)
+    {
+        //
+        // The failure is traced by the factory, the requests keep using the
+        // connections of the pool.
+        //
+        _factory->poolGrown(_endpoint);
+    }
+
+private:
+
+    const OutgoingConnectionFactoryPtr _factory;
+    const EndpointIPtr _endpoint;
+};
+
+void
+IceInternal::OutgoingConnectionFactory::growPool(const EndpointIPtr& endpoint, Ice::EndpointSelectionType selType)
+{
+    vector<EndpointIPtr> endpoints;
+    endpoints.push_back(endpoint);
+    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, false, new PoolGrowthCallback(this, endpoint),
+                                           selType, true);
+    cb->getConnectors();
+}
+
+void
+IceInternal::OutgoingConnectionFactory::poolGrown(const EndpointIPtr& endpoint)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    _growingPools.erase(endpoint);
+}
+
 void
 IceInternal::OutgoingConnectionFactory::incPendingConnectCount()
 {
@@ -492,6 +634,7 @@ IceInternal::OutgoingConnectionFactory::decPendingConnectCount()
 ConnectionIPtr
 IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo>& connectors,
                                                       const ConnectCallbackPtr& cb,
+                                                      bool grow,
                                                       bool& compress)
 {
     {
@@ -528,7 +671,7 @@ IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo
             //
             // Search for a matching connection. If we find one, we're done.
             //
-            Ice::ConnectionIPtr connection = findConnection(connectors, compress);
+            Ice::ConnectionIPtr connection = findConnection(connectors, grow, compress);
             if(connection)
             {
                 return connection;
@@ -585,7 +728,7 @@ ConnectionIPtr
 IceInternal::OutgoingConnectionFactory::createConnection(const TransceiverPtr& transceiver, const ConnectorInfo& ci)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    assert(_pending.find(ci.connector) != _pending.end() && transceiver);
+    assert(transceiver);
 
     //
     // Create and add the connection to the connection map. Adding the connection to the map
@@ -600,6 +743,15 @@ IceInternal::OutgoingConnectionFactory::createConnection(const TransceiverPtr& t
             throw Ice::CommunicatorDestroyedException(__FILE__, __LINE__);
         }
 
+        //
+        // With connection attempts, the connection establishment might be
+        // done once a delayed attempt gets here. The attempt is aborted.
+        //
+        if(_pending.find(ci.connector) == _pending.end())
+        {
+            throw Ice::ConnectionManuallyClosedException(__FILE__, __LINE__, false);
+        }
+
         connection = ConnectionI::create(_communicator, _instance, _monitor, transceiver, ci.connector,
                                          ci.endpoint->compress(false), nullptr);
     }
@@ -859,13 +1011,16 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
                                                                          const vector<EndpointIPtr>& endpoints,
                                                                          bool hasMore,
                                                                          const CreateConnectionCallbackPtr& cb,
-                                                                         Ice::EndpointSelectionType selType) :
+                                                                         Ice::EndpointSelectionType selType,
+                                                                         bool grow) :
     _instance(instance),
     _factory(factory),
     _endpoints(endpoints),
     _hasMore(hasMore),
     _callback(cb),
-    _selType(selType)
+    _selType(selType),
+    _grow(grow),
+    _done(false)
 {
     _endpointsIter = _endpoints.begin();
 }
@@ -876,6 +1031,12 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartCompleted(const ConnectionIPtr& connection)
 {
+    if(_factory->_connectAttemptDelay > 0)
+    {
+        attemptCompleted(connection);
+        return;
+    }
+
     if(_observer)
     {
         _observer->detach();
@@ -886,9 +1047,20 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartComplete
 }
 
 void
-IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& /*connection*/,
+IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& connection,
                                                                                const LocalException& ex)
 {
+    if(_factory->_connectAttemptDelay > 0)
+    {
+        list<Attempt>::iterator attempt;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            attempt = findAttempt(connection);
+        }
+        attemptFailed(attempt, ex);
+        return;
+    }
+
     assert(_iter != _connectors.end());
     if(connectionStartFailedImpl(ex))
     {
@@ -948,6 +1120,19 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::exception(const Ice::Lo
     }
 }
 
+//
+// Methods from TimerTask
+//
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::runTimerTask()
+{
+    //
+    // The attempt delay elapsed before the last attempt completed, try the
+    // next connector.
+    //
+    startAttempt();
+}
+
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnectors()
 {
@@ -994,7 +1179,7 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnection()
         // connection.
         //
         bool compress;
-        Ice::ConnectionIPtr connection = _factory->getConnection(_connectors, shared_from_this(), compress);
+        Ice::ConnectionIPtr connection = _factory->getConnection(_connectors, shared_from_this(), _grow, compress);
         if(!connection)
         {
             //
@@ -1019,6 +1204,12 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnection()
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::nextConnector()
 {
+    if(_factory->_connectAttemptDelay > 0)
+    {
+        startAttempt();
+        return;
+    }
+
     while(true)
     {
         try
@@ -1142,6 +1333,224 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailedIm
     return false;
 }
 
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::startAttempt()
+{
+    list<Attempt>::iterator attempt;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_done || _iter == _connectors.end())
+        {
+            return;
+        }
+        attempt = _attempts.insert(_attempts.end(), Attempt(*_iter++));
+
+        //
+        // Try the next connector if this attempt doesn't complete within the
+        // attempt delay.
+        //
+        IceUtil::TimerPtr timer = _instance->timer();
+        timer->cancel(shared_from_this());
+        if(_iter != _connectors.end())
+        {
+            try
+            {
+                timer->schedule(shared_from_this(), IceUtil::Time::milliSeconds(_factory->_connectAttemptDelay));
+            }
+            catch(const IceUtil::IllegalArgumentException&)
+            {
+                // The communicator is being destroyed, the attempt will fail.
+            }
+        }
+
+        const ConnectorInfo& ci = attempt->connector;
+        const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+        if(obsv)
+        {
+            attempt->observer = obsv->getConnectionEstablishmentObserver(ci.endpoint, ci.connector->toString());
+            if(attempt->observer)
+            {
+                attempt->observer->attach();
+            }
+        }
+    }
+
+    //
+    // The connection is created without the mutex locked, the factory is
+    // locked to create the connection. The attempt is aborted if the
+    // connection establishment is done once the connection is created.
+    //
+    const ConnectorInfo& ci = attempt->connector;
+    ConnectionIPtr connection;
+    try
+    {
+        if(_instance->traceLevels()->network >= 2)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            out << "trying to establish " << ci.endpoint->protocol() << " connection to "
+                << ci.connector->toString();
+        }
+        connection = _factory->createConnection(ci.connector->connect(), ci);
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        if(_instance->traceLevels()->network >= 2)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            out << "failed to establish " << ci.endpoint->protocol() << " connection to "
+                << ci.connector->toString() << "\n" << ex;
+        }
+        attemptFailed(attempt, ex);
+        return;
+    }
+
+    bool aborted;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        attempt->connection = connection;
+        aborted = _done;
+    }
+
+    connection->start(shared_from_this());
+    if(aborted)
+    {
+        connection->close(ConnectionClose::Forcefully);
+    }
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::attemptCompleted(const ConnectionIPtr& connection)
+{
+    list<Attempt> attempt;
+    vector<ConnectionIPtr> aborted;
+    bool first;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        attempt.splice(attempt.begin(), _attempts, findAttempt(connection));
+        first = !_done;
+        if(first)
+        {
+            _done = true;
+            aborted = abortAttempts();
+        }
+    }
+
+    if(attempt.front().observer)
+    {
+        attempt.front().observer->detach();
+    }
+
+    if(!first)
+    {
+        //
+        // The connection to another connector was already kept.
+        //
+        connection->close(ConnectionClose::Gracefully);
+        return;
+    }
+
+    for(vector<ConnectionIPtr>::const_iterator p = aborted.begin(); p != aborted.end(); ++p)
+    {
+        (*p)->close(ConnectionClose::Forcefully);
+    }
+
+    connection->activate();
+    _factory->finishGetConnection(_connectors, attempt.front().connector, connection, shared_from_this());
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::attemptFailed(list<Attempt>::iterator attempt,
+                                                                      const Ice::LocalException& ex)
+{
+    vector<ConnectionIPtr> aborted;
+    bool finished = false;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        Ice::Instrumentation::ObserverPtr observer = attempt->observer;
+        _attempts.erase(attempt);
+        if(_done)
+        {
+            //
+            // The attempt was aborted or the connection establishment failed.
+            //
+            if(observer)
+            {
+                observer->detach();
+            }
+            return;
+        }
+
+        if(observer)
+        {
+            observer->failed(ex.ice_id());
+            observer->detach();
+        }
+
+        bool more = _iter != _connectors.end() || !_attempts.empty();
+        _factory->handleConnectionException(ex, _hasMore || more);
+        if(!more || dynamic_cast<const Ice::CommunicatorDestroyedException*>(&ex))
+        {
+            _done = true;
+            aborted = abortAttempts();
+            finished = true;
+        }
+    }
+
+    if(finished)
+    {
+        for(vector<ConnectionIPtr>::const_iterator p = aborted.begin(); p != aborted.end(); ++p)
+        {
+            (*p)->close(ConnectionClose::Forcefully);
+        }
+        _factory->finishGetConnection(_connectors, ex, shared_from_this());
+    }
+    else
+    {
+        //
+        // Don't wait for the attempt delay to try the next connector.
+        //
+        startAttempt();
+    }
+}
+
+list<IceInternal::OutgoingConnectionFactory::ConnectCallback::Attempt>::iterator
+IceInternal::OutgoingConnectionFactory::ConnectCallback::findAttempt(const ConnectionIPtr& connection)
+{
+    // Must be called with the mutex locked.
+
+    list<Attempt>::iterator p = _attempts.begin();
+    while(p != _attempts.end() && p->connection != connection)
+    {
+        ++p;
+    }
+    assert(p != _attempts.end());
+    return p;
+}
+
+vector<ConnectionIPtr>
+IceInternal::OutgoingConnectionFactory::ConnectCallback::abortAttempts()
+{
+    // Must be called with the mutex locked once done.
+
+    assert(_done);
+    _instance->timer()->cancel(shared_from_this());
+
+    //
+    // Return the connections of the attempts in progress, they are closed
+    // outside the synchronization. The attempts are removed once their
+    // failure is reported.
+    //
+    vector<ConnectionIPtr> connections;
+    for(list<Attempt>::const_iterator p = _attempts.begin(); p != _attempts.end(); ++p)
+    {
+        if(p->connection)
+        {
+            connections.push_back(p->connection);
+        }
+    }
+    return connections;
+}
+
 void
 IceInternal::IncomingConnectionFactory::activate()
 {
@@ -26,6 +26,8 @@
 
 #include <list>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Ice
 {
@@ -39,6 +41,16 @@ ICE_DEFINE_PTR(ObjectAdapterIPtr, ObjectAdapterI);
 namespace IceInternal
 {
 
+//
+// If Ice.ConnectionPoolSize is greater than 1, the factory keeps up to this
+// number of connections per endpoint and returns the least loaded one, the
+// connections equally loaded are returned in turn. The pool only grows when
+// a proxy binds to a connection: while the pool isn't full, each binding
+// returns an existing connection and establishes a new one in the
+// background. A proxy with a cached connection keeps using the connection
+// it's bound to, so a single proxy only spreads its requests over the pool
+// if connection caching is disabled with ice_connectionCached(false).
+//
 class OutgoingConnectionFactory : public virtual IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
@@ -81,15 +93,24 @@ private:
         EndpointIPtr endpoint;
     };
 
+    //
+    // The connectors are tried one after the other, or concurrently if the
+    // Ice.ConnectAttemptDelay property is set: each connector is then tried
+    // once the previous connector failed or after the attempt delay, and the
+    // first connection to be validated is kept (the other attempts are
+    // aborted). The attempts are the connections being established in this
+    // mode.
+    //
     class ConnectCallback : public Ice::ConnectionI::StartCallback,
-                            public IceInternal::EndpointI_connectors
+                            public IceInternal::EndpointI_connectors,
+                            public IceUtil::TimerTask
                           , public std::enable_shared_from_this<ConnectCallback>
 
     {
     public:
 
         ConnectCallback(const InstancePtr&, const OutgoingConnectionFactoryPtr&, const std::vector<EndpointIPtr>&, bool,
-                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType);
+                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType, bool = false);
 
         virtual void connectionStartCompleted(const Ice::ConnectionIPtr&);
         virtual void connectionStartFailed(const Ice::ConnectionIPtr&, const Ice::LocalException&);
@@ -97,6 +118,8 @@ private:
         virtual void connectors(const std::vector<ConnectorPtr>&);
         virtual void exception(const Ice::LocalException&);
 
+        virtual void runTimerTask();
+
         void getConnectors();
         void nextEndpoint();
 
@@ -114,27 +137,53 @@ private:
 
     private:
 
+        struct Attempt
+        {
+            Attempt(const ConnectorInfo& c) : connector(c)
+            {
+            }
+
+            ConnectorInfo connector;
+            Ice::ConnectionIPtr connection;
+            Ice::Instrumentation::ObserverPtr observer;
+        };
+
         bool connectionStartFailedImpl(const Ice::LocalException&);
 
+        void startAttempt();
+        void attemptCompleted(const Ice::ConnectionIPtr&);
+        void attemptFailed(std::list<Attempt>::iterator, const Ice::LocalException&);
+        std::list<Attempt>::iterator findAttempt(const Ice::ConnectionIPtr&);
+        std::vector<Ice::ConnectionIPtr> abortAttempts();
+
         const InstancePtr _instance;
         const OutgoingConnectionFactoryPtr _factory;
         const std::vector<EndpointIPtr> _endpoints;
         const bool _hasMore;
         const CreateConnectionCallbackPtr _callback;
         const Ice::EndpointSelectionType _selType;
+        const bool _grow;
         Ice::Instrumentation::ObserverPtr _observer;
         std::vector<EndpointIPtr>::const_iterator _endpointsIter;
         std::vector<ConnectorInfo> _connectors;
         std::vector<ConnectorInfo>::const_iterator _iter;
+
+        IceUtil::Mutex _mutex;
+        std::list<Attempt> _attempts;
+        bool _done;
     };
     ICE_DEFINE_PTR(ConnectCallbackPtr, ConnectCallback);
     friend class ConnectCallback;
 
+    class PoolGrowthCallback;
+
     std::vector<EndpointIPtr> applyOverrides(const std::vector<EndpointIPtr>&);
-    Ice::ConnectionIPtr findConnection(const std::vector<EndpointIPtr>&, bool&);
+    Ice::ConnectionIPtr findConnection(const std::vector<EndpointIPtr>&, bool&, EndpointIPtr&);
+    void growPool(const EndpointIPtr&, Ice::EndpointSelectionType);
+    void poolGrown(const EndpointIPtr&);
     void incPendingConnectCount();
     void decPendingConnectCount();
-    Ice::ConnectionIPtr getConnection(const std::vector<ConnectorInfo>&, const ConnectCallbackPtr&, bool&);
+    Ice::ConnectionIPtr getConnection(const std::vector<ConnectorInfo>&, const ConnectCallbackPtr&, bool, bool&);
     void finishGetConnection(const std::vector<ConnectorInfo>&, const ConnectorInfo&, const Ice::ConnectionIPtr&,
                              const ConnectCallbackPtr&);
     void finishGetConnection(const std::vector<ConnectorInfo>&, const Ice::LocalException&, const ConnectCallbackPtr&);
@@ -142,7 +191,7 @@ private:
     bool addToPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
     void removeFromPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
 
-    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, bool&);
+    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, bool, bool&);
     Ice::ConnectionIPtr createConnection(const TransceiverPtr&, const ConnectorInfo&);
 
     void handleException(const Ice::LocalException&, bool);
@@ -151,12 +200,16 @@ private:
     Ice::CommunicatorPtr _communicator;
     const InstancePtr _instance;
     const FactoryACMMonitorPtr _monitor;
+    const int _connectAttemptDelay;
+    const size_t _connectionPoolSize;
     bool _destroyed;
 
     std::multimap<ConnectorPtr, Ice::ConnectionIPtr> _connections;
     std::map<ConnectorPtr, std::set<ConnectCallbackPtr> > _pending;
 
-    std::multimap<EndpointIPtr, Ice::ConnectionIPtr, Ice::TargetCompare<EndpointIPtr, std::less>> _connectionsByEndpoint;
+    std::unordered_multimap<EndpointIPtr, Ice::ConnectionIPtr, EndpointIHash, EndpointIEqualTo> _connectionsByEndpoint;
+    std::unordered_set<EndpointIPtr, EndpointIHash, EndpointIEqualTo> _growingPools;
+    size_t _poolRotation;
     int _pendingConnectCount;
 };
 
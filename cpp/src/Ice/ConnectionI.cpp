@@ -23,9 +23,7 @@
 #include <Ice/ProxyFactory.h> // For createProxy().
 #include <Ice/BatchRequestQueue.h>
 
-#ifdef ICE_HAS_BZIP2
-#  include <bzlib.h>
-#endif
+#include <Ice/Compressor.h>
 
 using namespace std;
 using namespace Ice;
@@ -549,6 +547,13 @@ Ice::ConnectionI::isFinished() const
     return true;
 }
 
+size_t
+Ice::ConnectionI::outstandingMessages() const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    return _asyncRequests.size() + _sendStreams.size() + _sendQueue.size();
+}
+
 void
 Ice::ConnectionI::throwException() const
 {
@@ -684,6 +689,47 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
 {
     OutputStream* os = out->getOs();
 
+    //
+    // While messages are being sent, the request is queued without locking the
+    // connection. It's moved to the send streams by the thread sending the
+    // messages or, if the queue was deactivated concurrently, by this thread.
+    //
+    // The queue is only active while the connection is active or holding: it's
+    // deactivated and drained once the connection exception is set, and the
+    // requests dequeued afterwards fail with the connection exception and are
+    // retried.
+    //
+    if(_sendQueueActive)
+    {
+        _transceiver->checkSendSize(*os);
+
+        //
+        // The request is flagged as queued before it's cancelable, a
+        // cancellation can't find it until the push is linked.
+        //
+        QueuedRequest* request = out->getQueuedRequest();
+        request->queued = true;
+        try
+        {
+            out->cancelable(shared_from_this());
+        }
+        catch(const LocalException&)
+        {
+            request->queued = false;
+            throw;
+        }
+        request->outAsync = out;
+        request->compress = compress;
+        request->requestId = writeRequestId(*os, response, batchRequestNum);
+        _sendQueue.push(request);
+        if(!_sendQueueActive)
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+            dequeueRequests(false);
+        }
+        return AsyncStatusQueued;
+    }
+
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     //
     // If the exception is closed before we even have a chance
@@ -708,37 +754,34 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
     // This will throw if the request is canceled.
     //
     out->cancelable(shared_from_this());
-    Int requestId = 0;
-    if(response)
-    {
-        //
-        // Create a new unique request ID.
-        //
-        requestId = _nextRequestId++;
-        if(requestId <= 0)
-        {
-            _nextRequestId = 1;
-            requestId = _nextRequestId++;
-        }
 
-        //
-        // Fill in the request ID.
-        //
-        const Byte* p = reinterpret_cast<const Byte*>(&requestId);
-#ifdef ICE_BIG_ENDIAN
-        reverse_copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#else
-        copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#endif
+    //
+    // Requests queued before by this thread must be sent first.
+    //
+    dequeueRequests(false);
+    if(_exception)
+    {
+        throw RetryException(*_exception);
     }
-    else if(batchRequestNum > 0)
+
+    Int requestId = writeRequestId(*os, response, batchRequestNum);
+
+    //
+    // If a push isn't linked yet, the requests pushed after it can't be
+    // dequeued and some of them might have been queued by this thread. The
+    // request is queued behind them rather than waiting for the push with
+    // the connection locked: the producer of the pending push, or the thread
+    // sending the messages, dequeues them all once the push is linked.
+    //
+    if(!_sendQueue.empty())
     {
-        const Byte* p = reinterpret_cast<const Byte*>(&batchRequestNum);
-#ifdef ICE_BIG_ENDIAN
-        reverse_copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#else
-        copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#endif
+        QueuedRequest* request = out->getQueuedRequest();
+        request->queued = true;
+        request->outAsync = out;
+        request->compress = compress;
+        request->requestId = requestId;
+        _sendQueue.push(request);
+        return AsyncStatusQueued;
     }
 
     out->attachRemoteObserver(initConnectionInfo(), _endpoint, requestId);
@@ -1033,6 +1076,32 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
         return; // The request has already been or will be shortly notified of the failure.
     }
 
+    //
+    // The request might still be in the send queue.
+    //
+    dequeueRequests(false);
+
+    //
+    // If it's still queued, a push isn't linked yet. The request is flagged as
+    // canceled and it's dropped once dequeued.
+    //
+    QueuedRequest* request = outAsync->getQueuedRequest();
+    if(request->queued)
+    {
+        if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
+        {
+            setState(StateClosed, ex);
+        }
+        else if(!request->canceled.exchange(true))
+        {
+            if(outAsync->exception(ex))
+            {
+                outAsync->invokeExceptionAsync();
+            }
+        }
+        return;
+    }
+
     for(deque<OutgoingMessage>::iterator o = _sendStreams.begin(); o != _sendStreams.end(); ++o)
     {
         if(o->outAsync.get() == outAsync.get())
@@ -2100,8 +2169,10 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _readTimeoutScheduled(false),
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _warnUdp(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Datagrams") > 0),
-    _compressionLevel(1),
+    _compressorRegistry(_instance->compressorRegistry()), // Cached for better performance.
+    _peerCompressors(0),
     _nextRequestId(1),
+    _sendQueueActive(false),
     _asyncRequestsHint(_asyncRequests.end()),
     _messageSizeMax(adapter ? adapter->messageSizeMax() : _instance->messageSizeMax()),
     _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
@@ -2114,19 +2185,6 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _initialized(false),
     _validated(false)
 {
-    const Ice::PropertiesPtr& properties = _instance->initializationData().properties;
-
-    int& compressionLevel = const_cast<int&>(_compressionLevel);
-    compressionLevel = properties->getPropertyAsIntWithDefault("Ice.Compression.Level", 1);
-    if(compressionLevel < 1)
-    {
-        compressionLevel = 1;
-    }
-    else if(compressionLevel > 9)
-    {
-        compressionLevel = 9;
-    }
-
     if(adapter)
     {
         _servantManager = adapter->getServantManager();
@@ -2151,11 +2209,11 @@ Ice::ConnectionI::create(const CommunicatorPtr& communicator,
                                              endpoint, adapter));
     if(adapter)
     {
-        const_cast<ThreadPoolPtr&>(conn->_threadPool) = adapter->getThreadPool();
+        const_cast<ThreadPoolPtr&>(conn->_threadPool) = adapter->getThreadPool()->getEventLoop();
     }
     else
     {
-        const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool();
+        const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool()->getEventLoop();
     }
     conn->_threadPool->initialize(conn);
     return conn;
@@ -2220,6 +2278,13 @@ Ice::ConnectionI::setState(State state, const LocalException& ex)
     // that is not yet marked as closed or closing.
     //
     setState(state);
+
+    //
+    // Requests can no longer be queued without locking the connection,
+    // the requests already queued are retried.
+    //
+    _sendQueueActive = false;
+    dequeueRequests(false);
 }
 
 void
@@ -2520,7 +2585,7 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 _writeStream.write(currentProtocol);
                 _writeStream.write(currentProtocolEncoding);
                 _writeStream.write(validateConnectionMsg);
-                _writeStream.write(static_cast<Byte>(0)); // Compression status (always zero for validate connection).
+                _writeStream.write(_compressorRegistry->mask()); // Compressors supported by the server.
                 _writeStream.write(headerSize); // Message size.
                 _writeStream.i = _writeStream.b.begin();
                 traceSend(_writeStream, _logger, _traceLevels);
@@ -2601,8 +2666,13 @@ Ice::ConnectionI::validate(SocketOperation operation)
             {
                 throw ConnectionNotValidatedException(__FILE__, __LINE__);
             }
+            //
+            // The compression status of the validate connection message is the mask
+            // of the compressors supported by the server, zero for older servers.
+            //
             Byte compress;
-            _readStream.read(compress); // Ignore compression status for validate connection.
+            _readStream.read(compress);
+            _peerCompressors = static_cast<Byte>(compress & ~CompressorRegistry::maskFlag);
             Int size;
             _readStream.read(size);
             if(size != headerSize)
@@ -2673,8 +2743,13 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             _sendStreams.pop_front();
 
             //
-            // If there's nothing left to send, we're done.
+            // If there's nothing left to send, including requests queued without
+            // locking the connection, we're done.
             //
+            if(_sendStreams.empty() && _state < StateClosingPending)
+            {
+                dequeueRequests(true);
+            }
             if(_sendStreams.empty())
             {
                 break;
@@ -2693,56 +2768,15 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             }
 
             //
-            // Otherwise, prepare the next message stream for writing.
+            // Otherwise, prepare the next message stream for writing. The
+            // message might already be prepared if it was gathered with the
+            // previous message.
             //
             message = &_sendStreams.front();
-            assert(!message->stream->i);
-#ifdef ICE_HAS_BZIP2
-            if(message->compress && message->stream->b.size() >= 100) // Only compress messages > 100 bytes.
+            if(!message->stream->i)
             {
-                //
-                // Message compressed. Request compressed response, if any.
-                //
-                message->stream->b[9] = 2;
-
-                //
-                // Do compression.
-                //
-                OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
-                doCompress(*message->stream, stream);
-
-                traceSend(*message->stream, _logger, _traceLevels);
-
-                message->adopt(&stream); // Adopt the compressed stream.
-                message->stream->i = message->stream->b.begin();
+                prepareMessage(*message);
             }
-            else
-            {
-#endif
-                if(message->compress)
-                {
-                    //
-                    // Message not compressed. Request compressed response, if any.
-                    //
-                    message->stream->b[9] = 1;
-                }
-
-                //
-                // No compression, just fill in the message size.
-                //
-                Int sz = static_cast<Int>(message->stream->b.size());
-                const Byte* p = reinterpret_cast<const Byte*>(&sz);
-#ifdef ICE_BIG_ENDIAN
-                reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
-#else
-                copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
-#endif
-                message->stream->i = message->stream->b.begin();
-                traceSend(*message->stream, _logger, _traceLevels);
-
-#ifdef ICE_HAS_BZIP2
-            }
-#endif
             _writeStream.swap(*message->stream);
 
             //
@@ -2755,7 +2789,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             assert(_writeStream.i);
             if(_writeStream.i != _writeStream.b.end())
             {
-                SocketOperation op = write(_writeStream);
+                SocketOperation op = writeMessages(callbacks);
                 if(op)
                 {
                     return op;
@@ -2788,6 +2822,139 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     return SocketOperationNone;
 }
 
+void
+Ice::ConnectionI::prepareMessage(OutgoingMessage& message)
+{
+    assert(!message.stream->i);
+    CompressorPtr compressor = selectCompressor(message);
+    if(compressor)
+    {
+        //
+        // Do compression, the compression status is set by doCompress. The message
+        // is sent uncompressed if compression doesn't reduce its size.
+        //
+        OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
+        if(doCompress(compressor, *message.stream, stream))
+        {
+            traceSend(*message.stream, _logger, _traceLevels);
+
+            message.adopt(&stream); // Adopt the compressed stream.
+            message.stream->i = message.stream->b.begin();
+            return;
+        }
+    }
+
+    if(message.compress)
+    {
+        //
+        // Message not compressed. Request compressed response, if any.
+        //
+        message.stream->b[9] = uncompressedStatus();
+    }
+
+    //
+    // No compression, just fill in the message size.
+    //
+    Int sz = static_cast<Int>(message.stream->b.size());
+    const Byte* p = reinterpret_cast<const Byte*>(&sz);
+#ifdef ICE_BIG_ENDIAN
+    reverse_copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
+#else
+    copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
+#endif
+    message.stream->i = message.stream->b.begin();
+    traceSend(*message.stream, _logger, _traceLevels);
+}
+
+SocketOperation
+Ice::ConnectionI::writeMessages(vector<OutgoingMessage>& callbacks)
+{
+#if defined(ICE_USE_IOCP)
+    return write(_writeStream);
+#else
+    //
+    // Gather the messages queued after the message being sent to write
+    // them with a single call to the transceiver. Messages which need
+    // compression are not gathered, they are compressed when they become
+    // the message being sent.
+    //
+    dequeueRequests(true);
+
+    vector<Buffer*> buffers;
+    vector<Buffer::Container::iterator> starts;
+    buffers.push_back(&_writeStream);
+    deque<OutgoingMessage>::iterator p = _sendStreams.begin();
+    for(++p; p != _sendStreams.end() && buffers.size() < 64; ++p)
+    {
+        if(!p->stream->i)
+        {
+            if(selectCompressor(*p))
+            {
+                break;
+            }
+            prepareMessage(*p);
+        }
+        buffers.push_back(p->stream);
+        starts.push_back(p->stream->i);
+    }
+
+    SocketOperation op = buffers.size() == 1 ? write(_writeStream) : write(buffers);
+
+    if(_observer && !starts.empty())
+    {
+        //
+        // The bytes written for the gathered messages are reported here, the
+        // bytes of the message being sent are reported with finishWrite.
+        //
+        Int sent = 0;
+        for(size_t i = 0; i < starts.size(); ++i)
+        {
+            sent += static_cast<Int>(buffers[i + 1]->i - starts[i]);
+        }
+        if(sent > 0)
+        {
+            _observer->sentBytes(sent);
+        }
+    }
+
+    if(op)
+    {
+        //
+        // Remove the messages which were completely written. The message
+        // partially written, if any, must be the message being sent: only
+        // this message is allowed to be partially written when the write
+        // is resumed or when a request is canceled.
+        //
+        while(_writeStream.i == _writeStream.b.end())
+        {
+            if(_observer)
+            {
+                _observer.finishWrite(_writeStream);
+            }
+
+            OutgoingMessage* message = &_sendStreams.front();
+            _writeStream.swap(*message->stream);
+            if(message->sent())
+            {
+                callbacks.push_back(*message);
+            }
+            _sendStreams.pop_front();
+
+            assert(!_sendStreams.empty());
+            message = &_sendStreams.front();
+            assert(message->stream->i);
+            _writeStream.swap(*message->stream);
+
+            if(_observer)
+            {
+                _observer.startWrite(_writeStream);
+            }
+        }
+    }
+    return op;
+#endif
+}
+
 AsyncStatus
 Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 {
@@ -2809,19 +2976,13 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
     message.stream->i = message.stream->b.begin();
     SocketOperation op;
-#ifdef ICE_HAS_BZIP2
-    if(message.compress && message.stream->b.size() >= 100) // Only compress messages larger than 100 bytes.
+    CompressorPtr compressor = selectCompressor(message);
+    OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
+    if(compressor && doCompress(compressor, *message.stream, stream))
     {
         //
-        // Message compressed. Request compressed response, if any.
+        // Message compressed, the compression status is set by doCompress.
         //
-        message.stream->b[9] = 2;
-
-        //
-        // Do compression.
-        //
-        OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
-        doCompress(*message.stream, stream);
         stream.i = stream.b.begin();
 
         traceSend(*message.stream, _logger, _traceLevels);
@@ -2858,13 +3019,12 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     }
     else
     {
-#endif
         if(message.compress)
         {
             //
             // Message not compressed. Request compressed response, if any.
             //
-            message.stream->b[9] = 1;
+            message.stream->b[9] = uncompressedStatus();
         }
 
         //
@@ -2909,100 +3069,207 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
         _sendStreams.push_back(message);
         _sendStreams.back().adopt(0); // Adopt the stream.
-#ifdef ICE_HAS_BZIP2
     }
-#endif
 
     _writeStream.swap(*_sendStreams.back().stream);
     scheduleTimeout(op);
     _threadPool->_register(shared_from_this(), op);
+
+    //
+    // Until all the messages are sent, requests can be queued without locking
+    // the connection.
+    //
+    if(!_exception)
+    {
+        _sendQueueActive = true;
+    }
     return AsyncStatusQueued;
 }
 
-#ifdef ICE_HAS_BZIP2
-static string
-getBZ2Error(int bzError)
+Int
+Ice::ConnectionI::writeRequestId(OutputStream& os, bool response, int batchRequestNum)
 {
-    if(bzError == BZ_RUN_OK)
-    {
-        return ": BZ_RUN_OK";
-    }
-    else if(bzError == BZ_FLUSH_OK)
-    {
-        return ": BZ_FLUSH_OK";
-    }
-    else if(bzError == BZ_FINISH_OK)
-    {
-        return ": BZ_FINISH_OK";
-    }
-    else if(bzError == BZ_STREAM_END)
-    {
-        return ": BZ_STREAM_END";
-    }
-    else if(bzError == BZ_CONFIG_ERROR)
-    {
-        return ": BZ_CONFIG_ERROR";
-    }
-    else if(bzError == BZ_SEQUENCE_ERROR)
-    {
-        return ": BZ_SEQUENCE_ERROR";
-    }
-    else if(bzError == BZ_PARAM_ERROR)
-    {
-        return ": BZ_PARAM_ERROR";
-    }
-    else if(bzError == BZ_MEM_ERROR)
-    {
-        return ": BZ_MEM_ERROR";
-    }
-    else if(bzError == BZ_DATA_ERROR)
-    {
-        return ": BZ_DATA_ERROR";
-    }
-    else if(bzError == BZ_DATA_ERROR_MAGIC)
+    Int requestId = 0;
+    if(response)
     {
-        return ": BZ_DATA_ERROR_MAGIC";
+        //
+        // Create a new unique request ID.
+        //
+        do
+        {
+            requestId = _nextRequestId++;
+            if(requestId <= 0)
+            {
+                Int next = requestId + 1;
+                _nextRequestId.compare_exchange_strong(next, 1);
+            }
+        }
+        while(requestId <= 0);
+
+        //
+        // Fill in the request ID.
+        //
+        const Byte* p = reinterpret_cast<const Byte*>(&requestId);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(p, p + sizeof(Int), os.b.begin() + headerSize);
+#else
+        copy(p, p + sizeof(Int), os.b.begin() + headerSize);
+#endif
     }
-    else if(bzError == BZ_IO_ERROR)
+    else if(batchRequestNum > 0)
     {
-        return ": BZ_IO_ERROR";
+        const Byte* p = reinterpret_cast<const Byte*>(&batchRequestNum);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(p, p + sizeof(Int), os.b.begin() + headerSize);
+#else
+        copy(p, p + sizeof(Int), os.b.begin() + headerSize);
+#endif
     }
-    else if(bzError == BZ_UNEXPECTED_EOF)
+    return requestId;
+}
+
+void
+Ice::ConnectionI::dequeueRequests(bool writing)
+{
+    //
+    // Moves the requests queued by sendAsyncRequest to the send streams, the
+    // connection must be locked. If writing is true, the caller is the thread
+    // sending the messages and the requests are just appended to the send
+    // streams, otherwise they are sent with sendMessage.
+    //
+    // If nothing is left to send, the queue is deactivated and checked again: a
+    // request queued concurrently is either found here or its producer sees the
+    // deactivation and dequeues it.
+    //
+    while(true)
     {
-        return ": BZ_UNEXPECTED_EOF";
+        QueuedRequest* request = _sendQueue.pop();
+        if(!request)
+        {
+            if(!_sendQueueActive || !_sendStreams.empty())
+            {
+                return;
+            }
+            _sendQueueActive = false;
+            continue;
+        }
+
+        //
+        // Release the reference held by the queued request, it can be queued
+        // again once it's popped.
+        //
+        OutgoingAsyncBasePtr out = std::move(request->outAsync);
+        const bool compress = request->compress;
+        const Int requestId = request->requestId;
+        const bool canceled = request->canceled.exchange(false);
+        request->queued = false;
+        if(canceled)
+        {
+            continue; // The request was already notified of the cancellation.
+        }
+
+        if(_exception)
+        {
+            //
+            // The request wasn't sent, it's retried.
+            //
+            if(out->exception(*_exception))
+            {
+                out->invokeExceptionAsync();
+            }
+            continue;
+        }
+
+        out->attachRemoteObserver(initConnectionInfo(), _endpoint, requestId);
+
+        OutgoingMessage message(out, out->getOs(), compress, requestId);
+        if(writing)
+        {
+            message.stream->i = 0;
+            _sendStreams.push_back(message);
+        }
+        else
+        {
+            try
+            {
+                if(sendMessage(message) & AsyncStatusInvokeSentCallback)
+                {
+                    out->invokeSentAsync();
+                }
+            }
+            catch(const LocalException& ex)
+            {
+                setState(StateClosed, ex);
+                if(out->exception(*_exception))
+                {
+                    out->invokeExceptionAsync();
+                }
+                continue;
+            }
+        }
+
+        if(requestId)
+        {
+            _asyncRequestsHint = _asyncRequests.insert(_asyncRequests.end(),
+                                                       pair<const Int, OutgoingAsyncBasePtr>(requestId, out));
+        }
     }
-    else if(bzError == BZ_OUTBUFF_FULL)
+}
+
+CompressorPtr
+Ice::ConnectionI::selectCompressor(const OutgoingMessage& message) const
+{
+    //
+    // Only compress messages larger than Ice.CompressionMinSize with a
+    // compressor supported by the peer.
+    //
+    if(!message.compress || message.stream->b.size() < _compressorRegistry->minSize())
     {
-        return ": BZ_OUTBUFF_FULL";
+        return 0;
     }
-    else
+    return _compressorRegistry->select(_peerCompressors);
+}
+
+Byte
+Ice::ConnectionI::uncompressedStatus() const
+{
+    //
+    // The compressors supported by this side are only sent to peers which
+    // negotiate compressors, the other peers only understand status 1.
+    //
+    if(_peerCompressors && _compressorRegistry->mask())
     {
-        return "";
+        return static_cast<Byte>(CompressorRegistry::maskFlag | _compressorRegistry->mask());
     }
+    return 1;
 }
 
-void
-Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compressed)
+bool
+Ice::ConnectionI::doCompress(const CompressorPtr& compressor, OutputStream& uncompressed, OutputStream& compressed)
 {
     const Byte* p;
 
     //
-    // Compress the message body, but not the header.
+    // Compress the message body, but not the header. Don't bother sending the
+    // compressed message if it's not smaller than the uncompressed message.
     //
-    unsigned int uncompressedLen = static_cast<unsigned int>(uncompressed.b.size() - headerSize);
-    unsigned int compressedLen = static_cast<unsigned int>(uncompressedLen * 1.01 + 600);
-    compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
-    int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                           &compressedLen,
-                                           reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                           uncompressedLen,
-                                           _compressionLevel, 0, 0);
-    if(bzError != BZ_OK)
+    size_t uncompressedLen = uncompressed.b.size() - headerSize;
+    compressed.b.resize(headerSize + sizeof(Int) + compressor->compressBound(uncompressedLen));
+    size_t compressedLen = compressor->compress(&uncompressed.b[0] + headerSize, uncompressedLen,
+                                                &compressed.b[0] + headerSize + sizeof(Int),
+                                                compressed.b.size() - headerSize - sizeof(Int));
+    if(headerSize + sizeof(Int) + compressedLen >= uncompressed.b.size())
     {
-        throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError));
+        compressed.b.clear();
+        return false;
     }
     compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
 
+    //
+    // Message compressed. Request compressed response, if any.
+    //
+    uncompressed.b[9] = compressor->id();
+
     //
     // Write the size of the compressed stream into the header of the
     // uncompressed stream. Since the header will be copied, this size
@@ -3032,10 +3299,11 @@ Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compresse
     // Copy the header from the uncompressed stream to the compressed one.
     //
     copy(uncompressed.b.begin(), uncompressed.b.begin() + headerSize, compressed.b.begin());
+    return true;
 }
 
 void
-Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompressed)
+Ice::ConnectionI::doUncompress(const CompressorPtr& compressor, InputStream& compressed, InputStream& uncompressed)
 {
     Int uncompressedSize;
     compressed.i = compressed.b.begin() + headerSize;
@@ -3051,21 +3319,13 @@ Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompresse
     }
     uncompressed.resize(static_cast<size_t>(uncompressedSize));
 
-    unsigned int uncompressedLen = static_cast<unsigned int>(uncompressedSize - headerSize);
-    unsigned int compressedLen = static_cast<unsigned int>(compressed.b.size() - headerSize - sizeof(Int));
-    int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                             &uncompressedLen,
-                                             reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                             compressedLen,
-                                             0, 0);
-    if(bzError != BZ_OK)
-    {
-        throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError));
-    }
+    compressor->uncompress(&compressed.b[0] + headerSize + sizeof(Int),
+                           compressed.b.size() - headerSize - sizeof(Int),
+                           &uncompressed.b[0] + headerSize,
+                           static_cast<size_t>(uncompressedSize) - headerSize);
 
     copy(compressed.b.begin(), compressed.b.begin() + headerSize, uncompressed.b.begin());
 }
-#endif
 
 SocketOperation
 Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& requestId, Byte& compress,
@@ -3095,15 +3355,27 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
         stream.read(messageType);
         stream.read(compress);
 
-        if(compress == 2)
+        if(compress >= 2 && compress < CompressorRegistry::maskFlag)
         {
-#ifdef ICE_HAS_BZIP2
+            CompressorPtr compressor = _compressorRegistry->get(compress);
+            if(!compressor)
+            {
+                throw FeatureNotSupportedException(__FILE__, __LINE__, "Cannot uncompress compressed message");
+            }
+            if(compress != 2)
+            {
+                //
+                // Only peers which negotiate compressors use compressors other than bzip2.
+                //
+                _peerCompressors = static_cast<Byte>(_peerCompressors | (1 << (compress - 1)));
+            }
             InputStream ustream(_instance.get(), Ice::currentProtocolEncoding);
-            doUncompress(stream, ustream);
+            doUncompress(compressor, stream, ustream);
             stream.b.swap(ustream.b);
-#else
-            throw FeatureNotSupportedException(__FILE__, __LINE__, "Cannot uncompress compressed message");
-#endif
+        }
+        else if(compress & CompressorRegistry::maskFlag)
+        {
+            _peerCompressors = static_cast<Byte>(compress & ~CompressorRegistry::maskFlag);
         }
         stream.i = stream.b.begin() + headerSize;
 
@@ -3485,6 +3757,35 @@ ConnectionI::write(Buffer& buf)
     return op;
 }
 
+SocketOperation
+ConnectionI::write(vector<Buffer*>& buffers)
+{
+    size_t size = 0;
+    vector<Buffer::Container::iterator> starts;
+    for(vector<Buffer*>::const_iterator p = buffers.begin(); p != buffers.end(); ++p)
+    {
+        starts.push_back((*p)->i);
+        size += static_cast<size_t>((*p)->b.end() - (*p)->i);
+    }
+
+    SocketOperation op = _transceiver->writeBuffers(buffers);
+    if(_instance->traceLevels()->network >= 3)
+    {
+        size_t sent = 0;
+        for(size_t i = 0; i < buffers.size(); ++i)
+        {
+            sent += static_cast<size_t>(buffers[i]->i - starts[i]);
+        }
+        if(sent > 0)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            out << "sent " << sent << " of " << size << " bytes via " << _endpoint->protocol() << " ("
+                << buffers.size() << " messages)\n" << toString();
+        }
+    }
+    return op;
+}
+
 void
 ConnectionI::reap()
 {
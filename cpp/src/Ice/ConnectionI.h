@@ -34,13 +34,12 @@
 #include <Ice/ACM.h>
 #include <Ice/OutputStream.h>
 #include <Ice/InputStream.h>
+#include <Ice/CompressorF.h>
+#include <Ice/MessageQueue.h>
 
+#include <atomic>
 #include <deque>
 
-#ifndef ICE_HAS_BZIP2
-#   define ICE_HAS_BZIP2
-#endif
-
 namespace Ice
 {
 
@@ -139,6 +138,7 @@ public:
 
     bool isActiveOrHolding() const;
     bool isFinished() const;
+    size_t outstandingMessages() const; // The number of requests waiting to be sent or waiting for a reply.
 
     virtual void throwException() const; // From Connection. Throws the connection exception if destroyed.
 
@@ -256,12 +256,17 @@ private:
     bool initialize(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     bool validate(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     IceInternal::SocketOperation sendNextMessage(std::vector<OutgoingMessage>&);
+    void prepareMessage(OutgoingMessage&);
+    IceInternal::SocketOperation writeMessages(std::vector<OutgoingMessage>&);
     IceInternal::AsyncStatus sendMessage(OutgoingMessage&);
 
-#ifdef ICE_HAS_BZIP2
-    void doCompress(Ice::OutputStream&, Ice::OutputStream&);
-    void doUncompress(Ice::InputStream&, Ice::InputStream&);
-#endif
+    Int writeRequestId(Ice::OutputStream&, bool, int);
+    void dequeueRequests(bool);
+
+    IceInternal::CompressorPtr selectCompressor(const OutgoingMessage&) const;
+    Byte uncompressedStatus() const;
+    bool doCompress(const IceInternal::CompressorPtr&, Ice::OutputStream&, Ice::OutputStream&);
+    void doUncompress(const IceInternal::CompressorPtr&, Ice::InputStream&, Ice::InputStream&);
 
     IceInternal::SocketOperation parseMessage(Ice::InputStream&, Int&, Int&, Byte&,
                                               IceInternal::ServantManagerPtr&, ObjectAdapterPtr&,
@@ -278,6 +283,7 @@ private:
 
     IceInternal::SocketOperation read(IceInternal::Buffer&);
     IceInternal::SocketOperation write(IceInternal::Buffer&);
+    IceInternal::SocketOperation write(std::vector<IceInternal::Buffer*>&);
 
     void reap();
 
@@ -313,9 +319,20 @@ private:
 
     IceUtil::Time _acmLastActivity;
 
-    const int _compressionLevel;
+    const IceInternal::CompressorRegistryPtr _compressorRegistry; // Cached for better performance.
+    Byte _peerCompressors;
 
-    Int _nextRequestId;
+    std::atomic<Int> _nextRequestId;
+
+    //
+    // The requests queued by sendAsyncRequest without the connection lock. Requests
+    // are queued only while _sendQueueActive is set, that is while the connection
+    // is active or holding and messages are being sent. They are moved to
+    // _sendStreams by the thread sending messages or, if the flag is cleared
+    // concurrently, by the producer itself.
+    //
+    IceInternal::MessageQueue<IceInternal::QueuedRequest> _sendQueue;
+    std::atomic<bool> _sendQueueActive;
 
     std::map<Int, IceInternal::OutgoingAsyncBasePtr> _asyncRequests;
     std::map<Int, IceInternal::OutgoingAsyncBasePtr>::iterator _asyncRequestsHint;
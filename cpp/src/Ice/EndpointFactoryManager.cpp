@@ -19,8 +19,15 @@ using namespace IceInternal;
 
 IceUtil::Shared* IceInternal::upCast(EndpointFactoryManager* p) { return p; }
 
+namespace
+{
+
+const size_t minInternSweepSize = 128;
+
+}
+
 IceInternal::EndpointFactoryManager::EndpointFactoryManager(const InstancePtr& instance)
-    : _instance(instance)
+    : _instance(instance), _internSweepSize(minInternSweepSize)
 {
 }
 
@@ -117,7 +124,7 @@ IceInternal::EndpointFactoryManager::create(const string& str, bool oaEndpoint)
             throw EndpointParseException(__FILE__, __LINE__, "unrecognized argument `" + v.front() +
                                          "' in endpoint `" + str + "'");
         }
-        return e;
+        return oaEndpoint ? e : intern(e);
 #else
         // Code below left in place for debugging.
 
@@ -163,7 +170,7 @@ IceInternal::EndpointFactoryManager::create(const string& str, bool oaEndpoint)
             is.startEncapsulation();
             EndpointIPtr e = factory->read(&is);
             is.endEncapsulation();
-            return e;
+            return oaEndpoint ? e : intern(e);
         }
         return ue; // Endpoint is opaque, but we don't have a factory for its type.
     }
@@ -199,7 +206,7 @@ IceInternal::EndpointFactoryManager::read(InputStream* s) const
 
     s->endEncapsulation();
 
-    return e;
+    return intern(e);
 }
 
 void
@@ -210,4 +217,49 @@ IceInternal::EndpointFactoryManager::destroy()
         _factories[i]->destroy();
     }
     _factories.clear();
+
+    IceUtil::Mutex::Lock sync(_internMutex);
+    _interned.clear();
+}
+
+EndpointIPtr
+IceInternal::EndpointFactoryManager::intern(const EndpointIPtr& endpoint) const
+{
+    //
+    // Return the canonical instance of the endpoint so that proxies with
+    // the same endpoints share them: equality checks then succeed on
+    // identity and the endpoint hash is only computed once.
+    //
+    if(!endpoint)
+    {
+        return endpoint;
+    }
+
+    IceUtil::Mutex::Lock sync(_internMutex);
+    auto p = _interned.insert(endpoint);
+    if(!p.second)
+    {
+        return *p.first;
+    }
+
+    if(_interned.size() >= _internSweepSize)
+    {
+        //
+        // Release the endpoints no longer used by any proxy. The set size
+        // doubles between sweeps to keep the interning cost constant.
+        //
+        for(auto q = _interned.begin(); q != _interned.end();)
+        {
+            if(q->use_count() == 1)
+            {
+                q = _interned.erase(q);
+            }
+            else
+            {
+                ++q;
+            }
+        }
+        _internSweepSize = max(minInternSweepSize, _interned.size() * 2);
+    }
+    return endpoint;
 }
@@ -8,10 +8,12 @@
 #include <IceUtil/Shared.h>
 #include <IceUtil/Mutex.h>
 #include <Ice/InstanceF.h>
-#include <Ice/EndpointIF.h>
+#include <Ice/EndpointI.h>
 #include <Ice/EndpointFactoryF.h>
 #include <Ice/EndpointFactoryManagerF.h>
 
+#include <unordered_set>
+
 namespace Ice
 {
 
@@ -38,8 +40,18 @@ private:
     void destroy();
     friend class Instance;
 
+    EndpointIPtr intern(const EndpointIPtr&) const;
+
     InstancePtr _instance;
     std::vector<EndpointFactoryPtr> _factories;
+
+    //
+    // The interned proxy endpoints. Endpoints only referenced by this set
+    // are released when the set grows past _internSweepSize.
+    //
+    mutable IceUtil::Mutex _internMutex;
+    mutable std::unordered_set<EndpointIPtr, EndpointIHash, EndpointIEqualTo> _interned;
+    mutable size_t _internSweepSize;
 };
 
 }
@@ -161,6 +161,36 @@ protected:
 
 };
 
+//
+// Hash and equality functors for hashed containers of endpoints. Equal
+// endpoints have the same hash, so the virtual operator== is only called
+// for distinct endpoints with the same hash. Interned endpoints (see
+// EndpointFactoryManager) compare equal on identity.
+//
+struct EndpointIHash
+{
+    size_t operator()(const EndpointIPtr& endpoint) const
+    {
+        return endpoint ? static_cast<size_t>(endpoint->hash()) : 0;
+    }
+};
+
+struct EndpointIEqualTo
+{
+    bool operator()(const EndpointIPtr& lhs, const EndpointIPtr& rhs) const
+    {
+        if(lhs == rhs)
+        {
+            return true;
+        }
+        else if(!lhs || !rhs || lhs->hash() != rhs->hash())
+        {
+            return false;
+        }
+        return *lhs == *rhs;
+    }
+};
+
 template<typename T> class InfoI : public T
 {
 public:
@@ -10,38 +10,12 @@
 #include <Ice/LoggerUtil.h>
 #include <Ice/HashUtil.h>
 #include <Ice/NetworkProxy.h>
-#include <IceUtil/MutexPtrLock.h>
 
 using namespace std;
 using namespace Ice;
 using namespace Ice::Instrumentation;
 using namespace IceInternal;
 
-namespace
-{
-
-IceUtil::Mutex* hashMutex = 0;
-
-class Init
-{
-public:
-
-    Init()
-    {
-        hashMutex = new IceUtil::Mutex;
-    }
-
-    ~Init()
-    {
-        delete hashMutex;
-        hashMutex = 0;
-    }
-};
-
-Init init;
-
-}
-
 IceUtil::Shared* IceInternal::upCast(EndpointHostResolver* p) { return p; }
 
 IceInternal::IPEndpointInfoI::IPEndpointInfoI(const EndpointIPtr& endpoint) : _endpoint(endpoint)
@@ -210,15 +184,19 @@ IceInternal::IPEndpointI::equivalent(const EndpointIPtr& endpoint) const
 Ice::Int
 IceInternal::IPEndpointI::hash() const
 {
-    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(hashMutex);
-    if(!_hashInitialized)
+    //
+    // The hash is only computed from immutable members, threads racing to
+    // initialize it compute the same value so there's no need to lock.
+    //
+    if(!_hashInitialized.load(memory_order_acquire))
     {
-        _hashValue = 5381;
-        hashAdd(_hashValue, type());
-        hashInit(_hashValue);
-        _hashInitialized = true;
+        Ice::Int h = 5381;
+        hashAdd(h, type());
+        hashInit(h);
+        _hashValue.store(h, memory_order_relaxed);
+        _hashInitialized.store(true, memory_order_release);
     }
-    return _hashValue;
+    return _hashValue.load(memory_order_relaxed);
 }
 
 string
@@ -502,21 +480,24 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, const
     _port(port),
     _sourceAddr(sourceAddr),
     _connectionId(connectionId),
-    _hashInitialized(false)
+    _hashInitialized(false),
+    _hashValue(0)
 {
 }
 
 IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance) :
     _instance(instance),
     _port(0),
-    _hashInitialized(false)
+    _hashInitialized(false),
+    _hashValue(0)
 {
 }
 
 IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, InputStream* s) :
     _instance(instance),
     _port(0),
-    _hashInitialized(false)
+    _hashInitialized(false),
+    _hashValue(0)
 {
     s->read(const_cast<string&>(_host), false);
     s->read(const_cast<Ice::Int&>(_port));
@@ -16,6 +16,7 @@
 #include <Ice/ObserverHelper.h>
 
 #include <deque>
+#include <atomic>
 
 namespace IceInternal
 {
@@ -91,8 +92,8 @@ protected:
 
 private:
 
-    mutable bool _hashInitialized;
-    mutable Ice::Int _hashValue;
+    mutable std::atomic<bool> _hashInitialized;
+    mutable std::atomic<Ice::Int> _hashValue;
 };
 
 class ICE_API EndpointHostResolver : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
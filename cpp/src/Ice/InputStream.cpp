@@ -159,6 +159,8 @@ Ice::InputStream::initialize(Instance* instance, const EncodingVersion& encoding
 
     _traceSlicing = _instance->traceLevels()->slicing > 0;
     _classGraphDepthMax = _instance->classGraphDepthMax();
+
+    b.setPool(_instance->bufferPool());
 }
 
 void
@@ -420,6 +422,30 @@ Ice::InputStream::read(std::vector<Ice::Byte>& v)
     }
 }
 
+void
+Ice::InputStream::read(SharedByteSeq& v)
+{
+    pair<const Byte*, const Byte*> p;
+    read(p);
+    size_t sz = static_cast<size_t>(p.second - p.first);
+
+    //
+    // Only share the buffer if the sequence is large and uses a significant
+    // part of the buffer, a small sequence shouldn't keep a large message
+    // buffer alive and is cheaper to copy.
+    //
+    if(sz >= 1024 && sz * 4 >= b.size())
+    {
+        shared_ptr<Byte> memory = b.share();
+        if(memory)
+        {
+            v = SharedByteSeq(shared_ptr<const Byte>(memory, p.first), sz);
+            return;
+        }
+    }
+    v = SharedByteSeq(p.first, p.second);
+}
+
 void
 Ice::InputStream::read(pair<const Byte*, const Byte*>& v)
 {
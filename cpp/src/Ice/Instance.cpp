@@ -12,6 +12,8 @@
 #include <Ice/ReferenceFactory.h>
 #include <Ice/ProxyFactory.h>
 #include <Ice/ThreadPool.h>
+#include <Ice/BufferPool.h>
+#include <Ice/Compressor.h>
 #include <Ice/ConnectionFactory.h>
 #include <Ice/ValueFactoryManagerI.h>
 #include <Ice/LocalException.h>
@@ -180,6 +182,7 @@ public:
 
     virtual void updateConnectionObservers();
     virtual void updateThreadObservers();
+    virtual void updateBufferPoolObservers();
 
 private:
 
@@ -290,6 +293,12 @@ IceInternal::ObserverUpdaterI::updateThreadObservers()
     _instance->updateThreadObservers();
 }
 
+void
+IceInternal::ObserverUpdaterI::updateBufferPoolObservers()
+{
+    _instance->updateBufferPoolObservers();
+}
+
 bool
 IceInternal::Instance::destroyed() const
 {
@@ -1200,6 +1209,27 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
 
         const_cast<bool&>(_collectObjects) = _initData.properties->getPropertyAsInt("Ice.CollectObjects") > 0;
 
+        if(_initData.properties->getPropertyAsInt("Ice.CacheMessageBuffers") > 0)
+        {
+            //
+            // Both properties are in kilobytes. By default, buffers up to 1MB are pooled and
+            // each size class caches up to 256KB of buffers (and at least one buffer), so the
+            // pool caches at most about 5MB.
+            //
+            Int sizeMax = _initData.properties->getPropertyAsIntWithDefault("Ice.MessageBufferPool.SizeMax", 1024);
+            Int cacheSize = _initData.properties->getPropertyAsIntWithDefault("Ice.MessageBufferPool.CacheSize",
+                                                                              256);
+            if(sizeMax > 0 && cacheSize > 0)
+            {
+                const_cast<BufferPoolPtr&>(_bufferPool) =
+                    new BufferPool(static_cast<size_t>(min(sizeMax, 0x7fffffff / 1024)) * 1024,
+                                   static_cast<size_t>(min(cacheSize, 0x7fffffff / 1024)) * 1024);
+            }
+        }
+
+        const_cast<CompressorRegistryPtr&>(_compressorRegistry) =
+            new CompressorRegistry(_initData.properties, _initData.logger);
+
         string toStringModeStr = _initData.properties->getPropertyWithDefault("Ice.ToStringMode", "Unicode");
         if(toStringModeStr == "ASCII")
         {
@@ -1431,6 +1461,11 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
     if(_initData.observer)
     {
         _initData.observer->setObserverUpdater(std::make_shared<ObserverUpdaterI>(this));
+        if(_bufferPool)
+        {
+            _bufferPool->updateObservers(_initData.observer);
+        }
+        _locatorManager->updateObservers(_initData.observer);
     }
 
     //
@@ -1448,6 +1483,12 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
         {
             _timer = new Timer;
         }
+
+        int timerThreads = _initData.properties->getPropertyAsIntWithDefault("Ice.TimerThreads", 1);
+        if(timerThreads > 1)
+        {
+            _timer->addThreads(timerThreads - 1);
+        }
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -1687,6 +1728,11 @@ IceInternal::Instance::destroy()
         _endpointFactoryManager->destroy();
     }
 
+    if(_bufferPool)
+    {
+        _bufferPool->destroy();
+    }
+
     if(_initData.properties->getPropertyAsInt("Ice.Warn.UnusedProperties") > 0)
     {
         set<string> unusedProperties = static_cast<PropertiesI*>(_initData.properties.get())->getUnusedProperties();
@@ -1782,6 +1828,15 @@ IceInternal::Instance::updateThreadObservers()
     }
 }
 
+void
+IceInternal::Instance::updateBufferPoolObservers()
+{
+    if(_bufferPool)
+    {
+        _bufferPool->updateObservers(_initData.observer);
+    }
+}
+
 BufSizeWarnInfo
 IceInternal::Instance::getBufSizeWarn(Short type)
 {
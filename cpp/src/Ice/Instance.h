@@ -21,6 +21,8 @@
 #include <Ice/ReferenceFactoryF.h>
 #include <Ice/ProxyFactoryF.h>
 #include <Ice/ThreadPoolF.h>
+#include <Ice/BufferPoolF.h>
+#include <Ice/CompressorF.h>
 #include <Ice/ConnectionFactoryF.h>
 #include <Ice/ACM.h>
 #include <Ice/ObjectFactory.h>
@@ -37,6 +39,7 @@
 #include <Ice/FacetMap.h>
 #include <Ice/Process.h>
 #include <list>
+#include <set>
 
 namespace Ice
 {
@@ -105,6 +108,8 @@ public:
     size_t batchAutoFlushSize() const { return _batchAutoFlushSize; }
     size_t classGraphDepthMax() const { return _classGraphDepthMax; }
     bool collectObjects() const { return _collectObjects; }
+    const BufferPoolPtr& bufferPool() const { return _bufferPool; }
+    const CompressorRegistryPtr& compressorRegistry() const { return _compressorRegistry; }
     Ice::ToStringMode toStringMode() const { return _toStringMode; }
     const ACMConfig& clientACM() const;
     const ACMConfig& serverACM() const;
@@ -149,6 +154,7 @@ private:
 
     void updateConnectionObservers();
     void updateThreadObservers();
+    void updateBufferPoolObservers();
     friend class ObserverUpdaterI;
 
     void addAllAdminFacets();
@@ -171,6 +177,8 @@ private:
     const size_t _classGraphDepthMax; // Immutable, not reset by destroy().
     const bool _collectObjects; // Immutable, not reset by destroy().
     const Ice::ToStringMode _toStringMode; // Immutable, not reset by destroy()
+    const BufferPoolPtr _bufferPool; // Immutable, not reset by destroy().
+    const CompressorRegistryPtr _compressorRegistry; // Immutable, not reset by destroy().
     ACMConfig _clientACM;
     ACMConfig _serverACM;
     RouterManagerPtr _routerManager;
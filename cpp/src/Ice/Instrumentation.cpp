@@ -65,10 +65,26 @@ Ice::Instrumentation::InvocationObserver::~InvocationObserver()
 {
 }
 
+Ice::Instrumentation::BufferPoolObserver::~BufferPoolObserver()
+{
+}
+
 Ice::Instrumentation::ObserverUpdater::~ObserverUpdater()
 {
 }
 
+void
+Ice::Instrumentation::ObserverUpdater::updateBufferPoolObservers()
+{
+}
+
 Ice::Instrumentation::CommunicatorObserver::~CommunicatorObserver()
 {
 }
+
+::std::shared_ptr<::Ice::Instrumentation::BufferPoolObserver>
+Ice::Instrumentation::CommunicatorObserver::getBufferPoolObserver(const ::std::string&,
+                                                                  const ::std::shared_ptr<BufferPoolObserver>&)
+{
+    return nullptr;
+}
@@ -63,6 +63,27 @@ struct ThreadStateChanged
     ThreadState newState;
 };
 
+struct WebSocketDeflateBytes
+{
+    typedef Long WebSocketDeflateMetrics::*Member;
+
+    WebSocketDeflateBytes(Member bytesP, Member compressedBytesP, Long bytesValue, Long compressedBytesValue) :
+        bytes(bytesP), compressedBytes(compressedBytesP), bytesVal(bytesValue), compressedBytesVal(compressedBytesValue)
+    {
+    }
+
+    void operator()(const WebSocketDeflateMetricsPtr& v)
+    {
+        v.get()->*bytes += bytesVal;
+        v.get()->*compressedBytes += compressedBytesVal;
+    }
+
+    Member bytes;
+    Member compressedBytes;
+    Long bytesVal;
+    Long compressedBytesVal;
+};
+
 IPConnectionInfo*
 getIPConnectionInfo(const ConnectionInfoPtr& info)
 {
@@ -77,6 +98,28 @@ getIPConnectionInfo(const ConnectionInfoPtr& info)
     return nullptr;
 }
 
+string
+getConnectionId(const ConnectionInfoPtr& connectionInfo)
+{
+    ostringstream os;
+    IPConnectionInfo* info = getIPConnectionInfo(connectionInfo);
+    if(info)
+    {
+        os << info->localAddress << ':' << info->localPort;
+        os << " -> ";
+        os << info->remoteAddress << ':' << info->remotePort;
+    }
+    else
+    {
+        os << "connection-" << connectionInfo.get();
+    }
+    if(!connectionInfo->connectionId.empty())
+    {
+        os << " [" << connectionInfo->connectionId << "]";
+    }
+    return os.str();
+}
+
 class ConnectionHelper : public MetricsHelperT<ConnectionMetrics>
 {
 public:
@@ -96,7 +139,7 @@ public:
     static Attributes attributes;
 
     ConnectionHelper(const ConnectionInfoPtr& con, const EndpointPtr& endpt, ConnectionState state) :
-        _connectionInfo(con), _endpoint(endpt), _state(state)
+        MetricsHelperT(attributes), _connectionInfo(con), _endpoint(endpt), _state(state)
     {
     }
 
@@ -110,23 +153,7 @@ public:
     {
         if(_id.empty())
         {
-            ostringstream os;
-            IPConnectionInfo* info = getIPConnectionInfo(_connectionInfo);
-            if(info)
-            {
-                os << info->localAddress << ':' << info->localPort;
-                os << " -> ";
-                os << info->remoteAddress << ':' << info->remotePort;
-            }
-            else
-            {
-                os << "connection-" << _connectionInfo.get();
-            }
-            if(!_connectionInfo->connectionId.empty())
-            {
-                os << " [" << _connectionInfo->connectionId << "]";
-            }
-            _id = os.str();
+            _id = getConnectionId(_connectionInfo);
         }
         return _id;
     }
@@ -225,7 +252,7 @@ public:
     };
     static Attributes attributes;
 
-    DispatchHelper(const Current& current, int size) : _current(current), _size(size)
+    DispatchHelper(const Current& current, int size) : MetricsHelperT(attributes), _current(current), _size(size)
     {
     }
 
@@ -363,7 +390,7 @@ public:
     };
     static Attributes attributes;
     InvocationHelper(const ObjectPrxPtr& proxy, const string& op, const Context& ctx) :
-        _proxy(proxy), _operation(op), _context(ctx)
+        MetricsHelperT(attributes), _proxy(proxy), _operation(op), _context(ctx)
     {
     }
 
@@ -507,7 +534,7 @@ public:
     static Attributes attributes;
 
     RemoteInvocationHelper(const ConnectionInfoPtr& con, const EndpointPtr& endpt, int requestId, int size) :
-        _connectionInfo(con), _endpoint(endpt), _requestId(requestId), _size(size)
+        MetricsHelperT(attributes), _connectionInfo(con), _endpoint(endpt), _requestId(requestId), _size(size)
     {
     }
 
@@ -608,7 +635,7 @@ public:
     static Attributes attributes;
 
     CollocatedInvocationHelper(const Ice::ObjectAdapterPtr& adapter, int requestId, int size) :
-        _requestId(requestId), _size(size), _id(adapter->getName())
+        MetricsHelperT(attributes), _requestId(requestId), _size(size), _id(adapter->getName())
     {
     }
 
@@ -665,7 +692,8 @@ public:
     };
     static Attributes attributes;
 
-    ThreadHelper(const string& parent, const string& id, ThreadState state) : _parent(parent), _id(id), _state(state)
+    ThreadHelper(const string& parent, const string& id, ThreadState state) :
+        MetricsHelperT(attributes), _parent(parent), _id(id), _state(state)
     {
     }
 
@@ -708,11 +736,11 @@ public:
     };
     static Attributes attributes;
 
-    EndpointHelper(const EndpointPtr& endpt, const string& id) : _endpoint(endpt), _id(id)
+    EndpointHelper(const EndpointPtr& endpt, const string& id) : MetricsHelperT(attributes), _endpoint(endpt), _id(id)
     {
     }
 
-    EndpointHelper(const EndpointPtr& endpt) : _endpoint(endpt)
+    EndpointHelper(const EndpointPtr& endpt) : MetricsHelperT(attributes), _endpoint(endpt)
     {
     }
 
@@ -762,6 +790,98 @@ private:
 
 EndpointHelper::Attributes EndpointHelper::attributes;
 
+class BufferPoolHelper : public MetricsHelperT<BufferPoolMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<BufferPoolHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &BufferPoolHelper::getParent);
+            add("id", &BufferPoolHelper::_id);
+        }
+    };
+    static Attributes attributes;
+
+    BufferPoolHelper(const string& id) : MetricsHelperT(attributes), _id(id)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+private:
+
+    const string _id;
+};
+
+BufferPoolHelper::Attributes BufferPoolHelper::attributes;
+
+class WebSocketDeflateHelper : public MetricsHelperT<WebSocketDeflateMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<WebSocketDeflateHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &WebSocketDeflateHelper::getParent);
+            add("id", &WebSocketDeflateHelper::getId);
+            add("localHost", &WebSocketDeflateHelper::getConnectionInfo, &IPConnectionInfo::localAddress);
+            add("localPort", &WebSocketDeflateHelper::getConnectionInfo, &IPConnectionInfo::localPort);
+            add("remoteHost", &WebSocketDeflateHelper::getConnectionInfo, &IPConnectionInfo::remoteAddress);
+            add("remotePort", &WebSocketDeflateHelper::getConnectionInfo, &IPConnectionInfo::remotePort);
+        }
+    };
+    static Attributes attributes;
+
+    WebSocketDeflateHelper(const ConnectionInfoPtr& con) : MetricsHelperT(attributes), _connectionInfo(con)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+    string
+    getId() const
+    {
+        return getConnectionId(_connectionInfo);
+    }
+
+    const ConnectionInfoPtr&
+    getConnectionInfo() const
+    {
+        return _connectionInfo;
+    }
+
+private:
+
+    const ConnectionInfoPtr& _connectionInfo;
+};
+
+WebSocketDeflateHelper::Attributes WebSocketDeflateHelper::attributes;
+
 }
 
 void
@@ -795,6 +915,40 @@ ThreadObserverI::stateChanged(ThreadState oldState, ThreadState newState)
 
 }
 
+void
+BufferPoolObserverI::hit()
+{
+    forEach(inc(&BufferPoolMetrics::hits));
+    if(_delegate)
+    {
+        _delegate->hit();
+    }
+}
+
+void
+BufferPoolObserverI::miss()
+{
+    forEach(inc(&BufferPoolMetrics::misses));
+    if(_delegate)
+    {
+        _delegate->miss();
+    }
+}
+
+void
+WebSocketDeflateObserverI::sent(Long bytes, Long compressedBytes)
+{
+    forEach(WebSocketDeflateBytes(&WebSocketDeflateMetrics::sentBytes, &WebSocketDeflateMetrics::sentCompressedBytes,
+                                  bytes, compressedBytes));
+}
+
+void
+WebSocketDeflateObserverI::received(Long bytes, Long compressedBytes)
+{
+    forEach(WebSocketDeflateBytes(&WebSocketDeflateMetrics::receivedBytes,
+                                  &WebSocketDeflateMetrics::receivedCompressedBytes, bytes, compressedBytes));
+}
+
 void
 DispatchObserverI::userException()
 {
@@ -906,7 +1060,9 @@ CommunicatorObserverI::CommunicatorObserverI(const InitializationData& initData)
     _invocations(_metrics, "Invocation"),
     _threads(_metrics, "Thread"),
     _connects(_metrics, "ConnectionEstablishment"),
-    _endpointLookups(_metrics, "EndpointLookup")
+    _endpointLookups(_metrics, "EndpointLookup"),
+    _bufferPools(_metrics, "BufferPool"),
+    _webSocketDeflates(_metrics, "WebSocketDeflate")
 {
     _invocations.registerSubMap<RemoteMetrics>("Remote", &InvocationMetrics::remotes);
     _invocations.registerSubMap<CollocatedMetrics>("Collocated", &InvocationMetrics::collocated);
@@ -917,6 +1073,7 @@ CommunicatorObserverI::setObserverUpdater(const ObserverUpdaterPtr& updater)
 {
     _connections.setUpdater(newUpdater(updater, &ObserverUpdater::updateConnectionObservers));
     _threads.setUpdater(newUpdater(updater, &ObserverUpdater::updateThreadObservers));
+    _bufferPools.setUpdater(newUpdater(updater, &ObserverUpdater::updateBufferPoolObservers));
     if(_delegate)
     {
         _delegate->setObserverUpdater(updater);
@@ -1069,6 +1226,48 @@ CommunicatorObserverI::getDispatchObserver(const Current& current, int size)
     return nullptr;
 }
 
+BufferPoolObserverPtr
+CommunicatorObserverI::getBufferPoolObserver(const string& id, const BufferPoolObserverPtr& observer)
+{
+    if(_bufferPools.isEnabled())
+    {
+        try
+        {
+            BufferPoolObserverPtr delegate;
+            BufferPoolObserverI* o = dynamic_cast<BufferPoolObserverI*>(observer.get());
+            if(_delegate)
+            {
+                delegate = _delegate->getBufferPoolObserver(id, o ? o->getDelegate() : observer);
+            }
+            return _bufferPools.getObserverWithDelegate(BufferPoolHelper(id), delegate, observer);
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return nullptr;
+}
+
+WebSocketDeflateObserverIPtr
+CommunicatorObserverI::getWebSocketDeflateObserver(const ConnectionInfoPtr& connectionInfo)
+{
+    if(_webSocketDeflates.isEnabled())
+    {
+        try
+        {
+            return _webSocketDeflates.getObserver(WebSocketDeflateHelper(connectionInfo));
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return nullptr;
+}
+
 const IceInternal::MetricsAdminIPtr&
 CommunicatorObserverI::getFacet() const
 {
@@ -1085,6 +1284,8 @@ CommunicatorObserverI::destroy()
     _threads.destroy();
     _connects.destroy();
     _endpointLookups.destroy();
+    _bufferPools.destroy();
+    _webSocketDeflates.destroy();
 
     _metrics->destroy();
 }
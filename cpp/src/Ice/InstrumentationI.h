@@ -202,8 +202,31 @@ public:
     getCollocatedObserver(const Ice::ObjectAdapterPtr&, Ice::Int, Ice::Int);
 };
 
+class BufferPoolObserverI : public ObserverWithDelegateT<IceMX::BufferPoolMetrics,
+                                                         Ice::Instrumentation::BufferPoolObserver>
+{
+public:
+
+    virtual void hit();
+
+    virtual void miss();
+};
+
 typedef ObserverWithDelegateT<IceMX::Metrics, Ice::Instrumentation::Observer> ObserverI;
 
+//
+// The WebSocket permessage-deflate observer isn't part of the Instrumentation
+// API, it's only used to maintain the WebSocketDeflate metrics map.
+//
+class WebSocketDeflateObserverI : public IceMX::ObserverT<IceMX::WebSocketDeflateMetrics>
+{
+public:
+
+    void sent(Ice::Long, Ice::Long);
+    void received(Ice::Long, Ice::Long);
+};
+ICE_DEFINE_PTR(WebSocketDeflateObserverIPtr, WebSocketDeflateObserverI);
+
 class ICE_API CommunicatorObserverI : public Ice::Instrumentation::CommunicatorObserver
 {
 public:
@@ -233,6 +256,11 @@ public:
 
     virtual Ice::Instrumentation::DispatchObserverPtr getDispatchObserver(const Ice::Current&, Ice::Int);
 
+    virtual Ice::Instrumentation::BufferPoolObserverPtr
+    getBufferPoolObserver(const std::string&, const Ice::Instrumentation::BufferPoolObserverPtr&);
+
+    WebSocketDeflateObserverIPtr getWebSocketDeflateObserver(const Ice::ConnectionInfoPtr&);
+
     const IceInternal::MetricsAdminIPtr& getFacet() const;
 
     void destroy();
@@ -248,6 +276,8 @@ private:
     ObserverFactoryWithDelegateT<ThreadObserverI> _threads;
     ObserverFactoryWithDelegateT<ObserverI> _connects;
     ObserverFactoryWithDelegateT<ObserverI> _endpointLookups;
+    ObserverFactoryWithDelegateT<BufferPoolObserverI> _bufferPools;
+    IceMX::ObserverFactoryT<WebSocketDeflateObserverI> _webSocketDeflates;
 };
 ICE_DEFINE_PTR(CommunicatorObserverIPtr, CommunicatorObserverI);
 
@@ -13,6 +13,7 @@
 #include <Ice/Reference.h>
 #include <Ice/Properties.h>
 #include <Ice/Comparable.h>
+#include <Ice/InstrumentationI.h>
 #include <iterator>
 
 using namespace std;
@@ -22,6 +23,7 @@ using namespace IceInternal;
 IceUtil::Shared* IceInternal::upCast(LocatorManager* p) { return p; }
 IceUtil::Shared* IceInternal::upCast(LocatorInfo* p) { return p; }
 IceUtil::Shared* IceInternal::upCast(LocatorTable* p) { return p; }
+IceUtil::Shared* IceInternal::upCast(LocatorCacheObserver* p) { return p; }
 
 namespace
 {
@@ -103,10 +105,86 @@ public:
     }
 };
 
+//
+// The helper for the LocatorCache metrics map.
+//
+class LocatorCacheHelper : public IceMX::MetricsHelperT<IceMX::Metrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<LocatorCacheHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &LocatorCacheHelper::getParent);
+            add("id", &LocatorCacheHelper::getId);
+            add("adapter", &LocatorCacheHelper::getAdapter);
+            add("object", &LocatorCacheHelper::getObject);
+        }
+    };
+    static Attributes attributes;
+
+    LocatorCacheHelper(const ReferencePtr& ref, LocatorCacheObserver::Event event) :
+        MetricsHelperT(attributes), _reference(ref), _event(event)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+    string
+    getId() const
+    {
+        switch(_event)
+        {
+        case LocatorCacheObserver::Hit:
+            return "hit";
+        case LocatorCacheObserver::Miss:
+            return "miss";
+        case LocatorCacheObserver::Refresh:
+            return "refresh";
+        }
+        assert(false);
+        return "";
+    }
+
+    string
+    getAdapter() const
+    {
+        return _reference->getAdapterId();
+    }
+
+    string
+    getObject() const
+    {
+        return _reference->isWellKnown() ?
+            Ice::identityToString(_reference->getIdentity(), _reference->getInstance()->toStringMode()) : "";
+    }
+
+private:
+
+    const ReferencePtr _reference;
+    const LocatorCacheObserver::Event _event;
+};
+
+LocatorCacheHelper::Attributes LocatorCacheHelper::attributes;
+
 }
 
 IceInternal::LocatorManager::LocatorManager(const Ice::PropertiesPtr& properties) :
     _background(properties->getPropertyAsInt("Ice.BackgroundLocatorCacheUpdates") > 0),
+    _refreshThreshold(min(max(properties->getPropertyAsInt("Ice.LocatorCacheRefreshThreshold"), 0), 100)),
+    _observer(new LocatorCacheObserver()),
     _tableHint(_table.end())
 {
 }
@@ -121,6 +199,14 @@ IceInternal::LocatorManager::destroy()
     _tableHint = _table.end();
 
     _locatorTables.clear();
+
+    _observer->destroy();
+}
+
+void
+IceInternal::LocatorManager::updateObservers(const Ice::Instrumentation::CommunicatorObserverPtr& observer)
+{
+    _observer->initialize(observer);
 }
 
 LocatorInfoPtr
@@ -167,13 +253,14 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
         {
             t = _locatorTables.insert(_locatorTables.begin(),
                                       pair<const pair<Identity, EncodingVersion>, LocatorTablePtr>(
-                                          locatorKey, new LocatorTable()));
+                                          locatorKey, new LocatorTable(_refreshThreshold)));
         }
 
         _tableHint = _table.insert(_tableHint,
                                    pair<const LocatorPrxPtr, LocatorInfoPtr>(locator,
                                                                           new LocatorInfo(locator, t->second,
-                                                                                          _background)));
+                                                                                          _background,
+                                                                                          _observer)));
     }
     else
     {
@@ -183,35 +270,39 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
     return _tableHint->second;
 }
 
-IceInternal::LocatorTable::LocatorTable()
+IceInternal::LocatorTable::LocatorTable(int refreshThreshold) : _refreshThreshold(refreshThreshold)
 {
 }
 
 void
 IceInternal::LocatorTable::clear()
 {
-     IceUtil::Mutex::Lock sync(*this);
-
-     _adapterEndpointsMap.clear();
-     _objectMap.clear();
+    for(size_t i = 0; i < shards; ++i)
+    {
+        IceUtil::Mutex::Lock sync(_shards[i].mutex);
+        _shards[i].adapterEndpoints.clear();
+        _shards[i].objects.clear();
+    }
 }
 
 bool
-IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints)
+IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints,
+                                               bool& refresh)
 {
+    refresh = false;
     if(ttl == 0) // No locator cache.
     {
         return false;
     }
 
-    IceUtil::Mutex::Lock sync(*this);
+    Shard& s = shard(hash<string>()(adapter));
+    IceUtil::Mutex::Lock sync(s.mutex);
 
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
-
-    if(p != _adapterEndpointsMap.end())
+    auto p = s.adapterEndpoints.find(adapter);
+    if(p != s.adapterEndpoints.end())
     {
-        endpoints = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        endpoints = p->second.value;
+        return checkTTL(p->second, ttl, refresh);
     }
     return false;
 }
@@ -219,55 +310,69 @@ IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, v
 void
 IceInternal::LocatorTable::addAdapterEndpoints(const string& adapter, const vector<EndpointIPtr>& endpoints)
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
+    Shard& s = shard(hash<string>()(adapter));
+    IceUtil::Mutex::Lock sync(s.mutex);
 
-    if(p != _adapterEndpointsMap.end())
+    auto p = s.adapterEndpoints.find(adapter);
+    if(p != s.adapterEndpoints.end())
     {
-        p->second = make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints);
+        p->second = Entry<vector<EndpointIPtr> >(endpoints);
     }
     else
     {
-        _adapterEndpointsMap.insert(
-            make_pair(adapter, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints)));
+        s.adapterEndpoints.insert(make_pair(adapter, Entry<vector<EndpointIPtr> >(endpoints)));
     }
 }
 
 vector<EndpointIPtr>
 IceInternal::LocatorTable::removeAdapterEndpoints(const string& adapter)
 {
-    IceUtil::Mutex::Lock sync(*this);
+    Shard& s = shard(hash<string>()(adapter));
+    IceUtil::Mutex::Lock sync(s.mutex);
 
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
-    if(p == _adapterEndpointsMap.end())
+    auto p = s.adapterEndpoints.find(adapter);
+    if(p == s.adapterEndpoints.end())
     {
         return vector<EndpointIPtr>();
     }
 
-    vector<EndpointIPtr> endpoints = p->second.second;
+    vector<EndpointIPtr> endpoints = p->second.value;
 
-    _adapterEndpointsMap.erase(p);
+    s.adapterEndpoints.erase(p);
 
     return endpoints;
 }
 
+void
+IceInternal::LocatorTable::endAdapterEndpointsRefresh(const string& adapter)
+{
+    Shard& s = shard(hash<string>()(adapter));
+    IceUtil::Mutex::Lock sync(s.mutex);
+
+    auto p = s.adapterEndpoints.find(adapter);
+    if(p != s.adapterEndpoints.end())
+    {
+        p->second.refreshing = false;
+    }
+}
+
 bool
-IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref)
+IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref, bool& refresh)
 {
+    refresh = false;
     if(ttl == 0) // No locator cache
     {
         return false;
     }
 
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    Shard& s = shard(IdentityHash()(id));
+    IceUtil::Mutex::Lock sync(s.mutex);
 
-    if(p != _objectMap.end())
+    auto p = s.objects.find(id);
+    if(p != s.objects.end())
     {
-        ref = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        ref = p->second.value;
+        return checkTTL(p->second, ttl, refresh);
     }
     return false;
 }
@@ -275,47 +380,131 @@ IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, Refer
 void
 IceInternal::LocatorTable::addObjectReference(const Identity& id, const ReferencePtr& ref)
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    Shard& s = shard(IdentityHash()(id));
+    IceUtil::Mutex::Lock sync(s.mutex);
 
-    if(p != _objectMap.end())
+    auto p = s.objects.find(id);
+    if(p != s.objects.end())
     {
-        p->second = make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref);
+        p->second = Entry<ReferencePtr>(ref);
     }
     else
     {
-        _objectMap.insert(make_pair(id, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref)));
+        s.objects.insert(make_pair(id, Entry<ReferencePtr>(ref)));
     }
 }
 
 ReferencePtr
 IceInternal::LocatorTable::removeObjectReference(const Identity& id)
 {
-    IceUtil::Mutex::Lock sync(*this);
+    Shard& s = shard(IdentityHash()(id));
+    IceUtil::Mutex::Lock sync(s.mutex);
 
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
-    if(p == _objectMap.end())
+    auto p = s.objects.find(id);
+    if(p == s.objects.end())
     {
         return 0;
     }
 
-    ReferencePtr ref = p->second.second;
-    _objectMap.erase(p);
+    ReferencePtr ref = p->second.value;
+    s.objects.erase(p);
     return ref;
 }
 
-bool
-IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
+void
+IceInternal::LocatorTable::endObjectReferenceRefresh(const Identity& id)
+{
+    Shard& s = shard(IdentityHash()(id));
+    IceUtil::Mutex::Lock sync(s.mutex);
+
+    auto p = s.objects.find(id);
+    if(p != s.objects.end())
+    {
+        p->second.refreshing = false;
+    }
+}
+
+size_t
+IceInternal::LocatorTable::IdentityHash::operator()(const Identity& id) const
+{
+    size_t h = hash<string>()(id.name);
+    return h ^ (hash<string>()(id.category) + 0x9e3779b9 + (h << 6) + (h >> 2));
+}
+
+IceInternal::LocatorTable::Shard&
+IceInternal::LocatorTable::shard(size_t h)
+{
+    //
+    // Use the high bits of the hash, the low bits select the bucket in the
+    // shard maps.
+    //
+    return _shards[((h >> 16) ^ (h >> 24)) % shards];
+}
+
+template<typename T> bool
+IceInternal::LocatorTable::checkTTL(Entry<T>& entry, int ttl, bool& refresh) const
 {
     assert(ttl != 0);
     if (ttl < 0) // TTL = infinite
     {
         return true;
     }
-    else
+
+    IceUtil::Int64 age = (IceUtil::Time::now(IceUtil::Time::Monotonic) - entry.time).toMicroSeconds();
+    IceUtil::Int64 timeout = IceUtil::Time::seconds(ttl).toMicroSeconds();
+    if(age > timeout)
     {
-        return IceUtil::Time::now(IceUtil::Time::Monotonic) - time <= IceUtil::Time::seconds(ttl);
+        return false;
+    }
+
+    //
+    // Only the first lookup past the refresh threshold refreshes the
+    // entry, the entry is replaced when the locator replies.
+    //
+    if(_refreshThreshold > 0 && !entry.refreshing && age * 100 >= timeout * _refreshThreshold)
+    {
+        entry.refreshing = true;
+        refresh = true;
+    }
+    return true;
+}
+
+void
+IceInternal::LocatorCacheObserver::initialize(const Ice::Instrumentation::CommunicatorObserverPtr& observer)
+{
+    CommunicatorObserverIPtr o = ICE_DYNAMIC_CAST(CommunicatorObserverI, observer);
+    if(o && !atomic_load(&_factory))
+    {
+        atomic_store(&_factory, make_shared<IceMX::ObserverFactoryT<IceMX::ObserverI> >(o->getFacet(), "LocatorCache"));
+    }
+}
+
+void
+IceInternal::LocatorCacheObserver::destroy()
+{
+    atomic_store(&_factory, shared_ptr<IceMX::ObserverFactoryT<IceMX::ObserverI> >()); // Unregisters the map.
+}
+
+void
+IceInternal::LocatorCacheObserver::record(const ReferencePtr& ref, Event event)
+{
+    shared_ptr<IceMX::ObserverFactoryT<IceMX::ObserverI> > factory = atomic_load(&_factory);
+    if(factory && factory->isEnabled())
+    {
+        try
+        {
+            shared_ptr<IceMX::ObserverI> observer = factory->getObserver(LocatorCacheHelper(ref, event));
+            if(observer)
+            {
+                observer->attach();
+                observer->detach();
+            }
+        }
+        catch(const exception& ex)
+        {
+            Error error(ref->getInstance()->initializationData().logger);
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
     }
 }
 
@@ -462,10 +651,12 @@ IceInternal::LocatorInfo::Request::exception(const Ice::Exception& ex)
     }
 }
 
-IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background) :
+IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background,
+                                      const LocatorCacheObserverPtr& observer) :
     _locator(locator),
     _table(table),
-    _background(background)
+    _background(background),
+    _observer(observer)
 {
     assert(_locator);
     assert(_table);
@@ -533,37 +724,57 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref,
 {
     assert(ref->isIndirect());
     vector<EndpointIPtr> endpoints;
+    bool refresh;
     if(!ref->isWellKnown())
     {
-        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints))
+        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints, refresh))
         {
             if(_background && !endpoints.empty())
             {
-                getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
+                refresh = true;
             }
             else
             {
+                _observer->record(ref, LocatorCacheObserver::Miss);
                 getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, callback);
                 return;
             }
         }
+
+        _observer->record(ref, LocatorCacheObserver::Hit);
+        if(refresh)
+        {
+            //
+            // Keep using the cached endpoints and update them in the background.
+            //
+            _observer->record(ref, LocatorCacheObserver::Refresh);
+            getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
+        }
     }
     else
     {
         ReferencePtr r;
-        if(!_table->getObjectReference(ref->getIdentity(), ttl, r))
+        if(!_table->getObjectReference(ref->getIdentity(), ttl, r, refresh))
         {
             if(_background && r)
             {
-                getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
+                refresh = true;
             }
             else
             {
+                _observer->record(ref, LocatorCacheObserver::Miss);
                 getObjectRequest(ref)->addCallback(ref, 0, ttl, callback);
                 return;
             }
         }
 
+        _observer->record(ref, LocatorCacheObserver::Hit);
+        if(refresh)
+        {
+            _observer->record(ref, LocatorCacheObserver::Refresh);
+            getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
+        }
+
         if(!r->isIndirect())
         {
             endpoints = r->getEndpoints();
@@ -840,6 +1051,14 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
         {
             _table->removeAdapterEndpoints(ref->getAdapterId());
         }
+        else
+        {
+            //
+            // The locator request failed, keep the cached endpoints until they
+            // expire but allow a later lookup to refresh them again.
+            //
+            _table->endAdapterEndpointsRefresh(ref->getAdapterId());
+        }
 
         IceUtil::Mutex::Lock sync(*this);
         assert(_adapterRequests.find(ref->getAdapterId()) != _adapterRequests.end());
@@ -855,6 +1074,10 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
         {
             _table->removeObjectReference(ref->getIdentity());
         }
+        else
+        {
+            _table->endObjectReferenceRefresh(ref->getIdentity());
+        }
 
         IceUtil::Mutex::Lock sync(*this);
         assert(_objectRequests.find(ref->getIdentity()) != _objectRequests.end());
@@ -16,9 +16,21 @@
 #include <Ice/EndpointIF.h>
 #include <Ice/PropertiesF.h>
 #include <Ice/Version.h>
+#include <Ice/Instrumentation.h>
 
 #include <Ice/UniquePtr.h>
 
+#include <unordered_map>
+
+namespace IceMX
+{
+
+class Metrics;
+template<typename> class ObserverT;
+template<typename> class ObserverFactoryT;
+
+}
+
 namespace IceInternal
 {
 
@@ -36,9 +48,13 @@ public:
     //
     LocatorInfoPtr get(const Ice::LocatorPrxPtr&);
 
+    void updateObservers(const Ice::Instrumentation::CommunicatorObserverPtr&);
+
 private:
 
     const bool _background;
+    const int _refreshThreshold;
+    const LocatorCacheObserverPtr _observer;
 
     using LocatorInfoTable = std::map<std::shared_ptr<Ice::LocatorPrx>,
                                       LocatorInfoPtr,
@@ -49,28 +65,99 @@ private:
     std::map<std::pair<Ice::Identity, Ice::EncodingVersion>, LocatorTablePtr> _locatorTables;
 };
 
-class LocatorTable : public IceUtil::Shared, public IceUtil::Mutex
+//
+// The locator cache. Entries are spread over shards by key hash, each
+// shard has its own mutex so lookups of different adapters or objects
+// don't contend. A lookup copies the cached endpoint vector or reference
+// out of the shard and a locator reply replaces it, both while holding the
+// shard mutex only for the copy; the critical sections are short and a
+// lock-free table would need deferred reclamation of the replaced values.
+//
+// The get methods return false if the entry is missing or expired. Once
+// an entry is older than the refresh threshold (a percentage of the TTL),
+// the first lookup sets refresh to true so that the caller refreshes the
+// entry in the background before it expires. The refresh is over once the
+// locator replies: the caller replaces or removes the entry, or calls the
+// matching end*Refresh method if the request failed, so that a later lookup
+// can refresh the entry again.
+//
+class LocatorTable : public IceUtil::Shared
 {
 public:
 
-    LocatorTable();
+    LocatorTable(int);
 
     void clear();
 
-    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&);
+    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&, bool&);
     void addAdapterEndpoints(const std::string&, const ::std::vector<EndpointIPtr>&);
     ::std::vector<EndpointIPtr> removeAdapterEndpoints(const std::string&);
+    void endAdapterEndpointsRefresh(const std::string&);
 
-    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&);
+    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&, bool&);
     void addObjectReference(const Ice::Identity&, const ReferencePtr&);
     ReferencePtr removeObjectReference(const Ice::Identity&);
+    void endObjectReferenceRefresh(const Ice::Identity&);
 
 private:
 
-    bool checkTTL(const IceUtil::Time&, int) const;
+    template<typename T> struct Entry
+    {
+        Entry(const T& v) : time(IceUtil::Time::now(IceUtil::Time::Monotonic)), value(v), refreshing(false)
+        {
+        }
+
+        IceUtil::Time time;
+        T value;
+        bool refreshing;
+    };
+
+    struct IdentityHash
+    {
+        size_t operator()(const Ice::Identity&) const;
+    };
+
+    struct Shard
+    {
+        IceUtil::Mutex mutex;
+        std::unordered_map<std::string, Entry<std::vector<EndpointIPtr> > > adapterEndpoints;
+        std::unordered_map<Ice::Identity, Entry<ReferencePtr>, IdentityHash> objects;
+    };
+    static const size_t shards = 16;
+
+    Shard& shard(size_t);
+
+    template<typename T> bool checkTTL(Entry<T>&, int, bool&) const;
+
+    const int _refreshThreshold;
+    Shard _shards[shards];
+};
+
+//
+// Records the locator cache lookups in the LocatorCache metrics map. The
+// map provides by default a metrics object for the lookups served from
+// the cache ("hit"), the lookups waiting for the locator ("miss") and the
+// background refreshes of cached entries ("refresh").
+//
+class LocatorCacheObserver : public IceUtil::Shared
+{
+public:
+
+    enum Event
+    {
+        Hit,
+        Miss,
+        Refresh
+    };
+
+    void initialize(const Ice::Instrumentation::CommunicatorObserverPtr&);
+    void destroy();
+
+    void record(const ReferencePtr&, Event);
+
+private:
 
-    std::map<std::string, std::pair<IceUtil::Time, std::vector<EndpointIPtr> > > _adapterEndpointsMap;
-    std::map<Ice::Identity, std::pair<IceUtil::Time, ReferencePtr> > _objectMap;
+    std::shared_ptr<IceMX::ObserverFactoryT<IceMX::ObserverT<IceMX::Metrics> > > _factory;
 };
 
 class LocatorInfo : public IceUtil::Shared, public IceUtil::Mutex
@@ -133,7 +220,7 @@ public:
     };
     typedef IceUtil::Handle<Request> RequestPtr;
 
-    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool);
+    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool, const LocatorCacheObserverPtr&);
 
     void destroy();
 
@@ -175,6 +262,7 @@ private:
     Ice::LocatorRegistryPrxPtr _locatorRegistry;
     const LocatorTablePtr _table;
     const bool _background;
+    const LocatorCacheObserverPtr _observer;
 
     std::map<std::string, RequestPtr> _adapterRequests;
     std::map<Ice::Identity, RequestPtr> _objectRequests;
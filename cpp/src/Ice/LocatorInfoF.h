@@ -24,6 +24,10 @@ class LocatorTable;
 IceUtil::Shared* upCast(LocatorTable*);
 typedef Handle<LocatorTable> LocatorTablePtr;
 
+class LocatorCacheObserver;
+IceUtil::Shared* upCast(LocatorCacheObserver*);
+typedef Handle<LocatorCacheObserver> LocatorCacheObserverPtr;
+
 }
 
 #endif
@@ -21,6 +21,26 @@ ifeq ($(os),Darwin)
 Ice_excludes            += src/IceUtil/ConvertUTF.cpp src/IceUtil/Unicode.cpp
 endif
 
+#
+# Optional protocol compressors, bzip2 is always built in.
+#
+ifeq ($(shell pkg-config --exists libzstd 2> /dev/null && echo yes),yes)
+Ice_cppflags                            += -DICE_HAS_ZSTD $(shell pkg-config --cflags libzstd)
+Ice_ldflags                             += $(shell pkg-config --libs libzstd)
+endif
+ifeq ($(shell pkg-config --exists liblz4 2> /dev/null && echo yes),yes)
+Ice_cppflags                            += -DICE_HAS_LZ4 $(shell pkg-config --cflags liblz4)
+Ice_ldflags                             += $(shell pkg-config --libs liblz4)
+endif
+
+#
+# The permessage-deflate extension of the WebSocket transports requires zlib.
+#
+ifeq ($(shell pkg-config --exists zlib 2> /dev/null && echo yes),yes)
+Ice_cppflags                            += -DICE_HAS_ZLIB $(shell pkg-config --cflags zlib)
+Ice_ldflags                             += $(shell pkg-config --libs zlib)
+endif
+
 ifeq ($(os),Linux)
 ifeq ($(shell pkg-config --exists libsystemd 2> /dev/null && echo yes),yes)
 Ice_cppflags                            += -DICE_USE_SYSTEMD $(shell pkg-config --cflags libsystemd)
@@ -0,0 +1,135 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_MESSAGE_QUEUE_H
+#define ICE_MESSAGE_QUEUE_H
+
+#include <IceUtil/Config.h>
+
+#include <atomic>
+
+namespace IceInternal
+{
+
+//
+// An unbounded multi-producer single-consumer FIFO queue. Pushing is
+// lock-free and wait-free: a producer exchanges the head pointer and links
+// its node to the previous head. Popping must be serialized by the caller,
+// it might return null while a concurrent push isn't linked yet, such a
+// push must therefore be followed by a check from the producer to ensure
+// its element is eventually consumed.
+//
+// This is Dmitry Vyukov's intrusive MPSC node-based queue. The nodes are
+// the elements, T must provide a std::atomic<T*> next member, so pushing
+// doesn't allocate. The queue doesn't own the elements, the caller must
+// keep an element alive until it's popped. A popped element is no longer
+// referenced by the queue and can be pushed again: the stub node is pushed
+// when the last element is popped.
+//
+// The queue also counts its elements, the count is only an estimate while
+// pushes or pops are in progress.
+//
+template<typename T>
+class MessageQueue
+{
+public:
+
+    MessageQueue() :
+        _head(&_stub),
+        _tail(&_stub),
+        _size(0)
+    {
+    }
+
+    void push(T* node)
+    {
+        ++_size;
+        link(node);
+    }
+
+    T* pop()
+    {
+        T* node = unlink();
+        if(node)
+        {
+            --_size;
+        }
+        return node;
+    }
+
+    size_t size() const
+    {
+        return _size.load();
+    }
+
+    //
+    // Returns true if all the pushed elements were popped. The queue isn't
+    // empty while a push isn't linked yet, even though pop returns null.
+    // Must be called by the consumer.
+    //
+    bool empty() const
+    {
+        return _head.load() == _tail;
+    }
+
+private:
+
+    MessageQueue(const MessageQueue&);
+    void operator=(const MessageQueue&);
+
+    void link(T* node)
+    {
+        node->next.store(0);
+        T* prev = _head.exchange(node);
+        prev->next.store(node);
+    }
+
+    T* unlink()
+    {
+        T* tail = _tail;
+        T* next = tail->next.load();
+        if(tail == &_stub)
+        {
+            if(!next)
+            {
+                return 0;
+            }
+            _tail = next;
+            tail = next;
+            next = next->next.load();
+        }
+
+        if(next)
+        {
+            _tail = next;
+            return tail;
+        }
+
+        if(tail != _head.load())
+        {
+            return 0; // A push isn't linked yet.
+        }
+
+        //
+        // The tail is the last element, push the stub to unlink it.
+        //
+        link(&_stub);
+        next = tail->next.load();
+        if(next)
+        {
+            _tail = next;
+            return tail;
+        }
+        return 0;
+    }
+
+    T _stub;
+    std::atomic<T*> _head; // Producers side.
+    T* _tail; // Consumer side.
+    std::atomic<size_t> _size;
+};
+
+}
+
+#endif
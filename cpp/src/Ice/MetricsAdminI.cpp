@@ -25,9 +25,11 @@ const string suffixes[] =
 {
     "Disabled",
     "GroupBy",
+    "Histogram",
     "Accept.*",
     "Reject.*",
     "RetainDetached",
+    "Shards",
     "Map.*",
 };
 
@@ -87,6 +89,75 @@ parseRule(const PropertiesPtr& properties, const string& name)
 
 }
 
+void
+IceMX::addMetrics(Metrics& to, const Metrics& from)
+{
+    to.total += from.total;
+    to.current += from.current;
+    to.totalLifetime += from.totalLifetime;
+    to.failures += from.failures;
+}
+
+void
+IceMX::addMetrics(ThreadMetrics& to, const ThreadMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.inUseForIO += from.inUseForIO;
+    to.inUseForUser += from.inUseForUser;
+    to.inUseForOther += from.inUseForOther;
+}
+
+void
+IceMX::addMetrics(DispatchMetrics& to, const DispatchMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.userException += from.userException;
+    to.size += from.size;
+    to.replySize += from.replySize;
+}
+
+void
+IceMX::addMetrics(ChildInvocationMetrics& to, const ChildInvocationMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.size += from.size;
+    to.replySize += from.replySize;
+}
+
+void
+IceMX::addMetrics(InvocationMetrics& to, const InvocationMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.retry += from.retry;
+    to.userException += from.userException;
+}
+
+void
+IceMX::addMetrics(ConnectionMetrics& to, const ConnectionMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.receivedBytes += from.receivedBytes;
+    to.sentBytes += from.sentBytes;
+}
+
+void
+IceMX::addMetrics(BufferPoolMetrics& to, const BufferPoolMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.hits += from.hits;
+    to.misses += from.misses;
+}
+
+void
+IceMX::addMetrics(WebSocketDeflateMetrics& to, const WebSocketDeflateMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.sentBytes += from.sentBytes;
+    to.sentCompressedBytes += from.sentCompressedBytes;
+    to.receivedBytes += from.receivedBytes;
+    to.receivedCompressedBytes += from.receivedCompressedBytes;
+}
+
 MetricsMapI::RegExp::RegExp(const string& attribute, const string& regexp) : _attribute(attribute)
 {
     _regex = regex(regexp, std::regex_constants::extended | std::regex_constants::nosubs);
@@ -110,6 +181,8 @@ MetricsMapI::~MetricsMapI()
 MetricsMapI::MetricsMapI(const std::string& mapPrefix, const PropertiesPtr& properties) :
     _properties(properties->getPropertiesForPrefix(mapPrefix)),
     _retain(properties->getPropertyAsIntWithDefault(mapPrefix + "RetainDetached", 10)),
+    _shards(max(properties->getPropertyAsIntWithDefault(mapPrefix + "Shards", 0), 0)),
+    _histogram(properties->getPropertyAsInt(mapPrefix + "Histogram") > 0),
     _accept(parseRule(properties, mapPrefix + "Accept")),
     _reject(parseRule(properties, mapPrefix + "Reject"))
 {
@@ -165,6 +238,8 @@ MetricsMapI::MetricsMapI(const MetricsMapI& map) :
     _groupByAttributes(map._groupByAttributes),
     _groupBySeparators(map._groupBySeparators),
     _retain(map._retain),
+    _shards(map._shards),
+    _histogram(map._histogram),
     _accept(map._accept),
     _reject(map._reject)
 {
@@ -176,6 +251,76 @@ MetricsMapI::getProperties() const
     return _properties;
 }
 
+size_t
+MetricsMapI::threadShard()
+{
+    //
+    // Threads are assigned consecutive indexes, the threads of a thread pool
+    // therefore use distinct shards as long as there are enough shards.
+    //
+    static atomic<size_t> nextShard(0);
+    static thread_local size_t shard = nextShard++;
+    return shard;
+}
+
+LifetimeHistogram::LifetimeHistogram()
+{
+}
+
+void
+LifetimeHistogram::add(Ice::Long duration)
+{
+    size_t index;
+    if(duration < linearBuckets)
+    {
+        index = duration > 0 ? static_cast<size_t>(duration) : 0;
+    }
+    else
+    {
+        //
+        // Find the power of two range of the duration, the sub-bucket is given
+        // by the bits following the most significant bit.
+        //
+        int exponent = subBucketBits + 1;
+        while((duration >> (exponent + 1)) != 0)
+        {
+            ++exponent;
+        }
+        index = linearBuckets + (exponent - subBucketBits - 1) * subBuckets +
+            static_cast<size_t>((duration >> (exponent - subBucketBits)) & (subBuckets - 1));
+    }
+
+    if(index >= _counts.size())
+    {
+        _counts.resize(index + 1, 0);
+    }
+    ++_counts[index];
+}
+
+void
+LifetimeHistogram::get(IceMX::LatencyHistogram& histogram) const
+{
+    for(size_t i = 0; i < _counts.size(); ++i)
+    {
+        if(_counts[i] > 0)
+        {
+            histogram[lowerBound(i)] += _counts[i];
+        }
+    }
+}
+
+Ice::Long
+LifetimeHistogram::lowerBound(size_t index)
+{
+    if(index < static_cast<size_t>(linearBuckets))
+    {
+        return static_cast<Ice::Long>(index);
+    }
+    size_t exponent = (index - linearBuckets) / subBuckets + subBucketBits + 1;
+    Ice::Long subBucket = static_cast<Ice::Long>((index - linearBuckets) % subBuckets);
+    return (subBuckets + subBucket) << (exponent - subBucketBits);
+}
+
 MetricsMapFactory::~MetricsMapFactory()
 {
     // Out of line to avoid weak vtable
@@ -130,6 +130,8 @@ Ice::OutputStream::initialize(Instance* instance, const EncodingVersion& encodin
     _encoding = encoding;
 
     _format = _instance->defaultsAndOverrides()->defaultFormat;
+
+    b.setPool(_instance->bufferPool());
 }
 
 void
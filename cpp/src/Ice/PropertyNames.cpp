@@ -1,6 +1,6 @@
 // Copyright (c) ZeroC, Inc. All rights reserved.
 
-// Generated by makeprops.py from file config/PropertyNames.xml, Mon Oct 12 15:41:02 2020
+// Generated by makeprops.py from file config/PropertyNames.xml, Sat Oct 17 03:02:15 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -55,6 +55,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.Router.Router", false, 0),
     IceInternal::Property("Ice.Admin.Router", false, 0),
     IceInternal::Property("Ice.Admin.ProxyOptions", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.Size", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.SizeWarn", false, 0),
@@ -78,9 +79,16 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ClassGraphDepthMax", false, 0),
     IceInternal::Property("Ice.ClientAccessPolicyProtocol", false, 0),
     IceInternal::Property("Ice.CloseTimeout", false, 0),
+    IceInternal::Property("Ice.Compression.Codecs", false, 0),
+    IceInternal::Property("Ice.Compression.Level", false, 0),
+    IceInternal::Property("Ice.Compression.LZ4.Acceleration", false, 0),
+    IceInternal::Property("Ice.Compression.Zstd.Dictionary", false, 0),
+    IceInternal::Property("Ice.Compression.Zstd.Level", false, 0),
     IceInternal::Property("Ice.CompressionLevel", false, 0),
     IceInternal::Property("Ice.CompressionMinSize", false, 0),
+    IceInternal::Property("Ice.ConnectAttemptDelay", false, 0),
     IceInternal::Property("Ice.ConnectTimeout", false, 0),
+    IceInternal::Property("Ice.ConnectionPoolSize", false, 0),
     IceInternal::Property("Ice.CollectObjects", false, 0),
     IceInternal::Property("Ice.Config", false, 0),
     IceInternal::Property("Ice.ConsoleListener", false, 0),
@@ -130,9 +138,12 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
     IceInternal::Property("Ice.IPv6", false, 0),
+    IceInternal::Property("Ice.LocatorCacheRefreshThreshold", false, 0),
     IceInternal::Property("Ice.LogFile", false, 0),
     IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
+    IceInternal::Property("Ice.MessageBufferPool.CacheSize", false, 0),
+    IceInternal::Property("Ice.MessageBufferPool.SizeMax", false, 0),
     IceInternal::Property("Ice.MessageSizeMax", false, 0),
     IceInternal::Property("Ice.Nohup", false, 0),
     IceInternal::Property("Ice.NullHandleAbort", false, 0),
@@ -159,6 +170,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.StdErr", false, 0),
     IceInternal::Property("Ice.StdOut", false, 0),
     IceInternal::Property("Ice.SyslogFacility", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.EventLoops", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.SizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.SizeWarn", false, 0),
@@ -166,6 +178,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.EventLoops", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
@@ -174,6 +187,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Server.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadPriority", false, 0),
     IceInternal::Property("Ice.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.TimerThreads", false, 0),
     IceInternal::Property("Ice.ToStringMode", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Properties", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Logger", false, 0),
@@ -184,6 +198,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Trace.Slicing", false, 0),
     IceInternal::Property("Ice.Trace.ThreadPool", false, 0),
     IceInternal::Property("Ice.Trace.Transport", false, 0),
+    IceInternal::Property("Ice.UDP.GSO", false, 0),
+    IceInternal::Property("Ice.UDP.RcvBatch", false, 0),
     IceInternal::Property("Ice.UDP.RcvSize", false, 0),
     IceInternal::Property("Ice.UDP.SndSize", false, 0),
     IceInternal::Property("Ice.TCP.Backlog", false, 0),
@@ -212,10 +228,12 @@ const IceInternal::PropertyArray
 const IceInternal::Property IceMXPropsData[] =
 {
     IceInternal::Property("IceMX.Metrics.*.GroupBy", false, 0),
+    IceInternal::Property("IceMX.Metrics.*.Histogram", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Map", false, 0),
     IceInternal::Property("IceMX.Metrics.*.RetainDetached", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Accept", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Reject", false, 0),
+    IceInternal::Property("IceMX.Metrics.*.Shards", false, 0),
     IceInternal::Property("IceMX.Metrics.*", false, 0),
 };
 
@@ -257,6 +275,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ProxyOptions", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Size", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SizeWarn", false, 0),
@@ -297,6 +316,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ProxyOptions", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Size", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
@@ -337,6 +357,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ProxyOptions", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Size", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
@@ -393,6 +414,7 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ProxyOptions", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Size", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
@@ -433,6 +455,7 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ProxyOptions", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Size", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
@@ -534,6 +557,7 @@ const IceInternal::Property IceBridgePropsData[] =
     IceInternal::Property("IceBridge.Source.Router.Router", false, 0),
     IceInternal::Property("IceBridge.Source.Router", false, 0),
     IceInternal::Property("IceBridge.Source.ProxyOptions", false, 0),
+    IceInternal::Property("IceBridge.Source.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.Size", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.SizeWarn", false, 0),
@@ -592,6 +616,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Server.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ProxyOptions", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.SizeWarn", false, 0),
@@ -635,6 +660,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ProxyOptions", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SizeWarn", false, 0),
@@ -675,6 +701,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ProxyOptions", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.SizeWarn", false, 0),
@@ -725,6 +752,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.Router.Router", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SizeWarn", false, 0),
@@ -766,6 +794,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Node.Router", false, 0),
     IceInternal::Property("IceGrid.Node.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.SizeWarn", false, 0),
@@ -849,6 +878,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SizeWarn", false, 0),
@@ -900,6 +930,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SizeWarn", false, 0),
@@ -942,6 +973,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SizeWarn", false, 0),
@@ -987,6 +1019,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SizeWarn", false, 0),
@@ -1045,6 +1078,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SizeWarn", false, 0),
@@ -1086,6 +1120,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ProxyOptions", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Size", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SizeWarn", false, 0),
@@ -1152,6 +1187,7 @@ const IceInternal::Property IceSSLPropsData[] =
     IceInternal::Property("IceSSL.Keystore", false, 0),
     IceInternal::Property("IceSSL.KeystorePassword", false, 0),
     IceInternal::Property("IceSSL.KeystoreType", false, 0),
+    IceInternal::Property("IceSSL.KTLS", false, 0),
     IceInternal::Property("IceSSL.Password", false, 0),
     IceInternal::Property("IceSSL.PasswordCallback", false, 0),
     IceInternal::Property("IceSSL.PasswordRetryMax", false, 0),
@@ -1160,6 +1196,7 @@ const IceInternal::Property IceSSLPropsData[] =
     IceInternal::Property("IceSSL.ProtocolVersionMin", false, 0),
     IceInternal::Property("IceSSL.Random", false, 0),
     IceInternal::Property("IceSSL.SchannelStrongCrypto", false, 0),
+    IceInternal::Property("IceSSL.SessionCacheSize", false, 0),
     IceInternal::Property("IceSSL.Trace.Security", false, 0),
     IceInternal::Property("IceSSL.TrustOnly", false, 0),
     IceInternal::Property("IceSSL.TrustOnly.Client", false, 0),
@@ -1233,6 +1270,7 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.Router.Router", false, 0),
     IceInternal::Property("Glacier2.Client.Router", false, 0),
     IceInternal::Property("Glacier2.Client.ProxyOptions", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.Size", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.SizeWarn", false, 0),
@@ -1242,7 +1280,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
     IceInternal::Property("Glacier2.Client.Buffered", false, 0),
+    IceInternal::Property("Glacier2.Client.FlushThreshold", false, 0),
     IceInternal::Property("Glacier2.Client.ForwardContext", false, 0),
+    IceInternal::Property("Glacier2.Client.QueueThreads", false, 0),
     IceInternal::Property("Glacier2.Client.SleepTime", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Override", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Reject", false, 0),
@@ -1312,6 +1352,7 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.Router.Router", false, 0),
     IceInternal::Property("Glacier2.Server.Router", false, 0),
     IceInternal::Property("Glacier2.Server.ProxyOptions", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.EventLoops", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.Size", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.SizeMax", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.SizeWarn", false, 0),
@@ -1321,7 +1362,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
     IceInternal::Property("Glacier2.Server.Buffered", false, 0),
+    IceInternal::Property("Glacier2.Server.FlushThreshold", false, 0),
     IceInternal::Property("Glacier2.Server.ForwardContext", false, 0),
+    IceInternal::Property("Glacier2.Server.QueueThreads", false, 0),
     IceInternal::Property("Glacier2.Server.SleepTime", false, 0),
     IceInternal::Property("Glacier2.Server.Trace.Override", false, 0),
     IceInternal::Property("Glacier2.Server.Trace.Request", false, 0),
@@ -1,6 +1,6 @@
 // Copyright (c) ZeroC, Inc. All rights reserved.
 
-// Generated by makeprops.py from file config/PropertyNames.xml, Mon Oct 12 15:41:02 2020
+// Generated by makeprops.py from file config/PropertyNames.xml, Sat Oct 17 03:02:15 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
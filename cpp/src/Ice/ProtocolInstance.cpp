@@ -123,6 +123,12 @@ IceInternal::ProtocolInstance::messageSizeMax() const
     return _instance->messageSizeMax();
 }
 
+const Ice::Instrumentation::CommunicatorObserverPtr&
+IceInternal::ProtocolInstance::observer() const
+{
+    return _instance->initializationData().observer;
+}
+
 void
 IceInternal::ProtocolInstance::resolve(const string& host, int port, EndpointSelectionType type,
                                        const IPEndpointIPtr& endpt, const EndpointI_connectorsPtr& cb) const
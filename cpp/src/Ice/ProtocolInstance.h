@@ -71,6 +71,7 @@ public:
     NetworkProxyPtr networkProxy() const;
     size_t messageSizeMax() const;
     int defaultTimeout() const;
+    const Ice::Instrumentation::CommunicatorObserverPtr& observer() const;
 
     void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
                  const EndpointI_connectorsPtr&) const;
@@ -1356,7 +1356,7 @@ IceInternal::RoutableReference::operator==(const Reference& r) const
     // check the sizes are equal.
     //
     if(_endpoints.size() != rhs->_endpoints.size() ||
-       !equal(_endpoints.begin(), _endpoints.end(), rhs->_endpoints.begin(), Ice::TargetCompare<shared_ptr<EndpointI>, std::equal_to>()))
+       !equal(_endpoints.begin(), _endpoints.end(), rhs->_endpoints.begin(), EndpointIEqualTo()))
     {
         return false;
     }
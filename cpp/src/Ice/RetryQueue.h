@@ -13,6 +13,8 @@
 #include <Ice/InstanceF.h>
 #include <Ice/RequestHandler.h> // For CancellationHandler
 
+#include <set>
+
 namespace IceInternal
 {
 
@@ -14,6 +14,8 @@
 #include <Ice/EventHandlerF.h>
 #include <Ice/UniqueRef.h>
 
+#include <set>
+
 #if defined(ICE_USE_EPOLL)
 #   include <sys/epoll.h>
 #elif defined(ICE_USE_KQUEUE)
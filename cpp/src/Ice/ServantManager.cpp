@@ -15,42 +15,56 @@ using namespace IceInternal;
 
 ICE_API IceUtil::Shared* IceInternal::upCast(ServantManager* p) { return p; }
 
-void
-IceInternal::ServantManager::addServant(const ObjectPtr& object, const Identity& ident, const string& facet)
+namespace
 {
-    IceUtil::Mutex::Lock sync(*this);
 
-    assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
+//
+// FNV-1a over the name and the category, with the 64-bit offset basis and
+// prime if size_t is 64-bit. The servant maps cache the hash in their keys so
+// it's not computed again when they grow.
+//
+size_t
+hashIdentity(const Identity& ident)
+{
+    const size_t offset = sizeof(size_t) > 4 ? static_cast<size_t>(14695981039346656037ULL) : 2166136261u;
+    const size_t prime = sizeof(size_t) > 4 ? static_cast<size_t>(1099511628211ULL) : 16777619u;
 
-    if(p == _servantMapMap.end() || p->first != ident)
+    size_t h = offset;
+    for(string::const_iterator p = ident.name.begin(); p != ident.name.end(); ++p)
     {
-        p = _servantMapMap.find(ident);
+        h = (h ^ static_cast<unsigned char>(*p)) * prime;
     }
-
-    if(p == _servantMapMap.end())
+    h = (h ^ static_cast<size_t>('/')) * prime;
+    for(string::const_iterator p = ident.category.begin(); p != ident.category.end(); ++p)
     {
-        p = _servantMapMap.insert(_servantMapMapHint, pair<const Identity, FacetMap>(ident, FacetMap()));
+        h = (h ^ static_cast<unsigned char>(*p)) * prime;
     }
-    else
+    return h;
+}
+
+}
+
+void
+IceInternal::ServantManager::addServant(const ObjectPtr& object, const Identity& ident, const string& facet)
+{
+    const IdentityKey key(ident);
+    ShardLock servantMap(*this, key);
+
+    assert(_instance); // Must not be called after destruction.
+
+    FacetMap& facets = servantMap.servants[key];
+    if(facets.find(facet) != facets.end())
     {
-        if(p->second.find(facet) != p->second.end())
+        ostringstream os;
+        os << Ice::identityToString(ident, _toStringMode);
+        if(!facet.empty())
         {
-            ToStringMode toStringMode = _instance->toStringMode();
-            ostringstream os;
-            os << Ice::identityToString(ident, toStringMode);
-            if(!facet.empty())
-            {
-                os << " -f " << escapeString(facet, "", toStringMode);
-            }
-            throw AlreadyRegisteredException(__FILE__, __LINE__, "servant", os.str());
+            os << " -f " << escapeString(facet, "", _toStringMode);
         }
+        throw AlreadyRegisteredException(__FILE__, __LINE__, "servant", os.str());
     }
 
-    _servantMapMapHint = p;
-
-    p->second.insert(pair<const string, ObjectPtr>(facet, object));
+    facets.insert(pair<const string, ObjectPtr>(facet, object));
 }
 
 void
@@ -79,26 +93,21 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
     //
     ObjectPtr servant = 0;
 
-    IceUtil::Mutex::Lock sync(*this);
+    const IdentityKey key(ident);
+    ShardLock servantMap(*this, key);
 
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
+    ServantMapMap::iterator p = servantMap.servants.find(key);
     FacetMap::iterator q;
 
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
-
-    if(p == _servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    if(p == servantMap.servants.end() || (q = p->second.find(facet)) == p->second.end())
     {
-        ToStringMode toStringMode = _instance->toStringMode();
         ostringstream os;
-        os << Ice::identityToString(ident, toStringMode);
+        os << Ice::identityToString(ident, _toStringMode);
         if(!facet.empty())
         {
-            os << " -f " + escapeString(facet, "", toStringMode);
+            os << " -f " + escapeString(facet, "", _toStringMode);
         }
         throw NotRegisteredException(__FILE__, __LINE__, "servant", os.str());
     }
@@ -108,15 +117,7 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
 
     if(p->second.empty())
     {
-        if(p == _servantMapMapHint)
-        {
-            _servantMapMap.erase(p++);
-            _servantMapMapHint = p;
-        }
-        else
-        {
-            _servantMapMap.erase(p);
-        }
+        servantMap.servants.erase(p);
     }
     return servant;
 }
@@ -150,43 +151,26 @@ IceInternal::ServantManager::removeDefaultServant(const string& category)
 FacetMap
 IceInternal::ServantManager::removeAllFacets(const Identity& ident)
 {
-    IceUtil::Mutex::Lock sync(*this);
+    const IdentityKey key(ident);
+    ShardLock servantMap(*this, key);
 
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
-
-    if(p == _servantMapMap.end())
+    ServantMapMap::iterator p = servantMap.servants.find(key);
+    if(p == servantMap.servants.end())
     {
-        throw NotRegisteredException(__FILE__, __LINE__, "servant",
-                                     Ice::identityToString(ident, _instance->toStringMode()));
-    }
-
-    FacetMap result = p->second;
-
-    if(p == _servantMapMapHint)
-    {
-        _servantMapMap.erase(p++);
-        _servantMapMapHint = p;
-    }
-    else
-    {
-        _servantMapMap.erase(p);
+        throw NotRegisteredException(__FILE__, __LINE__, "servant", Ice::identityToString(ident, _toStringMode));
     }
 
+    FacetMap result;
+    result.swap(p->second);
+    servantMap.servants.erase(p);
     return result;
 }
 
 ObjectPtr
 IceInternal::ServantManager::findServant(const Identity& ident, const string& facet) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
     // This assert is not valid if the adapter dispatch incoming
     // requests from bidir connections. This method might be called if
@@ -195,30 +179,30 @@ IceInternal::ServantManager::findServant(const Identity& ident, const string& fa
     //
     //assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-    FacetMap::iterator q;
-
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
-
-    if(p == servantMapMap.end() || p->first != ident)
     {
-        p = servantMapMap.find(ident);
+        const IdentityKey key(ident);
+        ShardLock servantMap(*this, key);
+
+        ServantMapMap::const_iterator p = servantMap.servants.find(key);
+        if(p != servantMap.servants.end())
+        {
+            FacetMap::const_iterator q = p->second.find(facet);
+            if(q != p->second.end())
+            {
+                return q->second;
+            }
+        }
     }
 
-    if(p == servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    IceUtil::Mutex::Lock sync(*this);
+
+    DefaultServantMap::const_iterator d = _defaultServantMap.find(ident.category);
+    if(d == _defaultServantMap.end())
     {
-        DefaultServantMap::const_iterator d = _defaultServantMap.find(ident.category);
+        d = _defaultServantMap.find("");
         if(d == _defaultServantMap.end())
         {
-            d = _defaultServantMap.find("");
-            if(d == _defaultServantMap.end())
-            {
-                return 0;
-            }
-            else
-            {
-                return d->second;
-            }
+            return 0;
         }
         else
         {
@@ -227,8 +211,7 @@ IceInternal::ServantManager::findServant(const Identity& ident, const string& fa
     }
     else
     {
-        _servantMapMapHint = p;
-        return q->second;
+        return d->second;
     }
 }
 
@@ -251,26 +234,18 @@ IceInternal::ServantManager::findDefaultServant(const string& category) const
 FacetMap
 IceInternal::ServantManager::findAllFacets(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
+    const IdentityKey key(ident);
+    ShardLock servantMap(*this, key);
 
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
-
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
-
-    if(p == servantMapMap.end())
+    ServantMapMap::const_iterator p = servantMap.servants.find(key);
+    if(p == servantMap.servants.end())
     {
         return FacetMap();
     }
     else
     {
-        _servantMapMapHint = p;
         return p->second;
     }
 }
@@ -278,8 +253,6 @@ IceInternal::ServantManager::findAllFacets(const Identity& ident) const
 bool
 IceInternal::ServantManager::hasServant(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
     // This assert is not valid if the adapter dispatch incoming
     // requests from bidir connections. This method might be called if
@@ -288,21 +261,16 @@ IceInternal::ServantManager::hasServant(const Identity& ident) const
     //
     //assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
-
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
+    const IdentityKey key(ident);
+    ShardLock servantMap(*this, key);
 
-    if(p == servantMapMap.end())
+    ServantMapMap::const_iterator p = servantMap.servants.find(key);
+    if(p == servantMap.servants.end())
     {
         return false;
     }
     else
     {
-        _servantMapMapHint = p;
         assert(!p->second.empty());
         return true;
     }
@@ -400,7 +368,7 @@ IceInternal::ServantManager::findServantLocator(const string& category) const
 IceInternal::ServantManager::ServantManager(const InstancePtr& instance, const string& adapterName)
     : _instance(instance),
       _adapterName(adapterName),
-      _servantMapMapHint(_servantMapMap.end()),
+      _toStringMode(instance->toStringMode()),
       _locatorMapHint(_locatorMap.end())
 {
 }
@@ -415,10 +383,39 @@ IceInternal::ServantManager::~ServantManager()
     //assert(!_instance);
 }
 
+IceInternal::ServantManager::IdentityKey::IdentityKey(const Identity& ident) :
+    _hash(hashIdentity(ident)),
+    _ref(&ident)
+{
+}
+
+IceInternal::ServantManager::IdentityKey::IdentityKey(const IdentityKey& other) :
+    _hash(other._hash),
+    _identity(other.identity()),
+    _ref(0)
+{
+}
+
+IceInternal::ServantManager::ShardLock::ShardLock(const ServantManager& manager, const IdentityKey& key) :
+    IceUtil::Mutex::Lock(manager.shard(key.hash()).mutex),
+    servants(manager.shard(key.hash()).servants)
+{
+}
+
+IceInternal::ServantManager::ServantMapShard&
+IceInternal::ServantManager::shard(size_t h) const
+{
+    //
+    // Use the high bits of the hash, the low bits select the bucket in the
+    // shard servant map.
+    //
+    return _servantMapShards[((h >> 16) ^ (h >> 24)) % servantMapShards];
+}
+
 void
 IceInternal::ServantManager::destroy()
 {
-    ServantMapMap servantMapMap;
+    vector<ServantMapMap> servantMaps(servantMapShards);
     DefaultServantMap defaultServantMap;
     map<string, ServantLocatorPtr> locatorMap;
     Ice::LoggerPtr logger;
@@ -435,8 +432,11 @@ IceInternal::ServantManager::destroy()
 
         logger = _instance->initializationData().logger;
 
-        servantMapMap.swap(_servantMapMap);
-        _servantMapMapHint = _servantMapMap.end();
+        for(size_t i = 0; i < servantMapShards; ++i)
+        {
+            IceUtil::Mutex::Lock shardSync(_servantMapShards[i].mutex);
+            servantMaps[i].swap(_servantMapShards[i].servants);
+        }
 
         defaultServantMap.swap(_defaultServantMap);
 
@@ -474,7 +474,7 @@ IceInternal::ServantManager::destroy()
     // hold any internal Ice mutex while running user code (such as servant
     // or servant locator destructors).
     //
-    servantMapMap.clear();
+    servantMaps.clear();
     locatorMap.clear();
     defaultServantMap.clear();
 }
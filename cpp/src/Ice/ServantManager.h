@@ -13,10 +13,13 @@
 #include <Ice/Identity.h>
 #include <Ice/FacetMap.h>
 
+#include <unordered_map>
+
 namespace Ice
 {
 
 class ObjectAdapterI;
+enum class ToStringMode : unsigned char;
 
 }
 
@@ -51,12 +54,89 @@ private:
     InstancePtr _instance;
 
     const std::string _adapterName;
-
-    typedef std::map<Ice::Identity, Ice::FacetMap> ServantMapMap;
+    const Ice::ToStringMode _toStringMode;
+
+    //
+    // The key of the servant maps: the identity and its FNV-1a hash. The hash
+    // is computed once when the key is created, it selects the shard and is
+    // reused by the shard servant map. A key created from an identity refers
+    // to this identity and is meant for lookups, a copy of a key, such as the
+    // keys stored in the servant maps, holds its own copy of the identity.
+    //
+    class IdentityKey
+    {
+    public:
+
+        explicit IdentityKey(const Ice::Identity&);
+        IdentityKey(const IdentityKey&);
+
+        const Ice::Identity&
+        identity() const
+        {
+            return _ref ? *_ref : _identity;
+        }
+
+        size_t
+        hash() const
+        {
+            return _hash;
+        }
+
+        bool
+        operator==(const IdentityKey& rhs) const
+        {
+            return _hash == rhs._hash && identity() == rhs.identity();
+        }
+
+    private:
+
+        IdentityKey& operator=(const IdentityKey&);
+
+        const size_t _hash;
+        const Ice::Identity _identity;
+        const Ice::Identity* const _ref;
+    };
+
+    struct IdentityKeyHash
+    {
+        size_t
+        operator()(const IdentityKey& key) const
+        {
+            return key.hash();
+        }
+    };
+
+    typedef std::unordered_map<IdentityKey, Ice::FacetMap, IdentityKeyHash> ServantMapMap;
     typedef std::map<std::string, Ice::ObjectPtr> DefaultServantMap;
 
-    ServantMapMap _servantMapMap;
-    mutable ServantMapMap::iterator _servantMapMapHint;
+    //
+    // The servants are spread over shards by identity hash, each shard has
+    // its own mutex so dispatch threads looking up different identities
+    // don't contend. The default servants and servant locators are protected
+    // by the servant manager mutex.
+    //
+    struct ServantMapShard
+    {
+        IceUtil::Mutex mutex;
+        ServantMapMap servants;
+    };
+    static const size_t servantMapShards = 64;
+
+    //
+    // Locks the shard of the given key.
+    //
+    class ShardLock : public IceUtil::Mutex::Lock
+    {
+    public:
+
+        ShardLock(const ServantManager&, const IdentityKey&);
+
+        ServantMapMap& servants;
+    };
+
+    ServantMapShard& shard(size_t) const;
+
+    mutable ServantMapShard _servantMapShards[servantMapShards];
 
     DefaultServantMap _defaultServantMap;
 
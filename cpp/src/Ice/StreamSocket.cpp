@@ -6,6 +6,12 @@
 #include <Ice/NetworkProxy.h>
 #include <Ice/ProtocolInstance.h>
 
+#if !defined(_WIN32)
+#   include <sys/uio.h>
+#endif
+
+#include <limits>
+
 using namespace IceInternal;
 
 StreamSocket::StreamSocket(const ProtocolInstancePtr& instance,
@@ -193,6 +199,131 @@ StreamSocket::write(Buffer& buf)
     return buf.i != buf.b.end() ? SocketOperationWrite : SocketOperationNone;
 }
 
+SocketOperation
+StreamSocket::write(std::vector<Buffer*>& buffers)
+{
+#if defined(_WIN32)
+    for(std::vector<Buffer*>::const_iterator p = buffers.begin(); p != buffers.end(); ++p)
+    {
+        if((*p)->i != (*p)->b.end())
+        {
+            SocketOperation op = write(**p);
+            if(op)
+            {
+                return op;
+            }
+        }
+    }
+    return SocketOperationNone;
+#else
+    assert(_fd != INVALID_SOCKET);
+
+    std::vector<Buffer*>::const_iterator p = buffers.begin();
+    while(true)
+    {
+        while(p != buffers.end() && (*p)->i == (*p)->b.end())
+        {
+            ++p;
+        }
+        if(p == buffers.end())
+        {
+            return SocketOperationNone;
+        }
+
+        if(_state == StateProxyWrite)
+        {
+            //
+            // The proxy handshake is written with write(Buffer&) to let the
+            // proxy check each buffer.
+            //
+            SocketOperation op = write(**p);
+            if(op)
+            {
+                return op;
+            }
+            continue;
+        }
+
+        //
+        // Gather the remaining data of the buffers, up to 64 buffers are
+        // written with each call to writev. The data written with each call
+        // is limited to the send packet size of the socket.
+        //
+        struct iovec iov[64];
+        int iovcnt = 0;
+        size_t packetSize = getSendPacketSize(std::numeric_limits<size_t>::max());
+        for(std::vector<Buffer*>::const_iterator q = p; q != buffers.end() && iovcnt < 64 && packetSize > 0; ++q)
+        {
+            if((*q)->i != (*q)->b.end())
+            {
+                size_t length = std::min(packetSize, static_cast<size_t>((*q)->b.end() - (*q)->i));
+                iov[iovcnt].iov_base = &*(*q)->i;
+                iov[iovcnt].iov_len = length;
+                packetSize -= length;
+                ++iovcnt;
+            }
+        }
+
+        ssize_t ret = ::writev(_fd, iov, iovcnt);
+        if(ret == 0)
+        {
+            throw Ice::ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(noBuffers())
+            {
+                //
+                // Fallback to write(Buffer&) which writes the buffer with
+                // smaller packets.
+                //
+                SocketOperation op = write(**p);
+                if(op)
+                {
+                    return op;
+                }
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                return SocketOperationWrite;
+            }
+
+            if(connectionLost())
+            {
+                throw Ice::ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            else
+            {
+                throw Ice::SocketException(__FILE__, __LINE__, getSocketErrno());
+            }
+        }
+
+        //
+        // Advance the buffer iterators over the written data.
+        //
+        size_t sent = static_cast<size_t>(ret);
+        for(; sent > 0; ++p)
+        {
+            size_t length = static_cast<size_t>((*p)->b.end() - (*p)->i);
+            if(sent < length)
+            {
+                (*p)->i += sent;
+                break;
+            }
+            (*p)->i = (*p)->b.end();
+            sent -= length;
+        }
+    }
+#endif
+}
+
 ssize_t
 StreamSocket::read(char* buf, size_t length)
 {
@@ -10,6 +10,8 @@
 #include <Ice/Buffer.h>
 #include <Ice/ProtocolInstanceF.h>
 
+#include <vector>
+
 namespace IceInternal
 {
 
@@ -30,6 +32,7 @@ public:
 
     SocketOperation read(Buffer&);
     SocketOperation write(Buffer&);
+    SocketOperation write(std::vector<Buffer*>&);
 
     ssize_t read(char*, size_t);
     ssize_t write(const char*, size_t);
@@ -55,6 +55,12 @@ IceInternal::TcpTransceiver::read(Buffer& buf)
     return _stream->read(buf);
 }
 
+SocketOperation
+IceInternal::TcpTransceiver::writeBuffers(vector<Buffer*>& buffers)
+{
+    return _stream->write(buffers);
+}
+
 #if defined(ICE_USE_IOCP)
 bool
 IceInternal::TcpTransceiver::startWrite(Buffer& buf)
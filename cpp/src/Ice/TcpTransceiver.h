@@ -28,6 +28,7 @@ public:
     virtual void close();
     virtual SocketOperation write(Buffer&);
     virtual SocketOperation read(Buffer&);
+    virtual SocketOperation writeBuffers(std::vector<Buffer*>&);
 #if defined(ICE_USE_IOCP)
     virtual bool startWrite(Buffer&);
     virtual void finishWrite(Buffer&);
@@ -262,7 +262,8 @@ IceInternal::ThreadPoolWorkQueue::getNativeInfo()
     return 0;
 }
 
-IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& prefix, int timeout) :
+IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& prefix, int timeout, int eventLoop,
+                                    int eventLoops) :
     _instance(instance),
 #ifdef ICE_SWIFT
     _dispatchQueue(dispatch_queue_create(prefixToDispatchQueueLabel(prefix).c_str(),
@@ -274,6 +275,9 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _prefix(prefix),
     _selector(instance),
     _nextThreadId(0),
+    _eventLoop(eventLoop),
+    _nextEventLoop(0),
+    _active(false),
     _size(0),
     _sizeIO(0),
     _sizeMax(0),
@@ -360,6 +364,43 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         threadIdleTime = 0;
     }
 
+    //
+    // Each event loop has its own selector and its own threads. Threads only
+    // perform IO for the event handlers of their event loop.
+    //
+    if(_eventLoop == 0)
+    {
+        eventLoops = properties->getPropertyAsIntWithDefault(_prefix + ".EventLoops", 1);
+        if(eventLoops == -1)
+        {
+            eventLoops = nProcessors;
+        }
+        else if(eventLoops < 1)
+        {
+            Warning out(_instance->initializationData().logger);
+            out << _prefix << ".EventLoops < 1; EventLoops adjusted to 1";
+            eventLoops = 1;
+        }
+    }
+
+    if(eventLoops > 1)
+    {
+        //
+        // The Size, SizeMax and SizeWarn threads are split across the event
+        // loops, the first event loops get the remaining threads. Each event
+        // loop has at least one thread.
+        //
+        const int loops = eventLoops;
+        const int loop = _eventLoop;
+        auto share = [loops, loop](int n) { return n / loops + (loop < n % loops ? 1 : 0); };
+        size = max(1, share(size));
+        sizeMax = max(size, share(sizeMax));
+        if(sizeWarn != 0)
+        {
+            sizeWarn = min(sizeMax, max(size, share(sizeWarn)));
+        }
+    }
+
     const_cast<int&>(_size) = size;
     const_cast<int&>(_sizeMax) = sizeMax;
     const_cast<int&>(_sizeWarn) = sizeWarn;
@@ -402,8 +443,16 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     if(_instance->traceLevels()->threadPool >= 1)
     {
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
-        out << "creating " << _prefix << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = "
-            << _sizeWarn;
+        out << "creating " << _prefix;
+        if(_eventLoop > 0)
+        {
+            out << " event loop " << _eventLoop;
+        }
+        out << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = " << _sizeWarn;
+        if(eventLoops > 1)
+        {
+            out << ", EventLoops = " << eventLoops;
+        }
     }
 
     __setNoDelete(true);
@@ -422,6 +471,20 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
             }
             _threads.insert(thread);
         }
+
+        //
+        // The thread pool is the first event loop. The additional event loops
+        // don't monitor the server idle time, the thread pool only considers
+        // the server idle if none of its event loops was active during the
+        // server idle time (see eventLoopsIdle()).
+        //
+        if(_eventLoop == 0)
+        {
+            for(int i = 1; i < eventLoops; ++i)
+            {
+                _eventLoops.push_back(new ThreadPool(_instance, _prefix, 0, i, eventLoops));
+            }
+        }
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -461,6 +524,11 @@ IceInternal::ThreadPool::destroy()
     }
     _destroyed = true;
     _workQueue->destroy();
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _eventLoops.begin(); p != _eventLoops.end(); ++p)
+    {
+        (*p)->destroy();
+    }
 }
 
 void
@@ -471,6 +539,11 @@ IceInternal::ThreadPool::updateObservers()
     {
         (*p)->updateObserver();
     }
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _eventLoops.begin(); p != _eventLoops.end(); ++p)
+    {
+        (*p)->updateObservers();
+    }
 }
 
 void
@@ -630,6 +703,52 @@ IceInternal::ThreadPool::joinWithAllThreads()
         (*p)->getThreadControl().join();
     }
     _selector.destroy();
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _eventLoops.begin(); p != _eventLoops.end(); ++p)
+    {
+        (*p)->joinWithAllThreads();
+    }
+}
+
+bool
+IceInternal::ThreadPool::eventLoopsIdle()
+{
+    //
+    // The event loops are idle if none of their threads is in use and if
+    // they didn't process any event since the last check. This is called
+    // by the thread pool when its own selector timed out, the event loops
+    // were therefore idle for at least the server idle time.
+    //
+    bool idle = true;
+    for(vector<ThreadPoolPtr>::const_iterator p = _eventLoops.begin(); p != _eventLoops.end(); ++p)
+    {
+        ThreadPool* eventLoop = p->get();
+        Lock sync(*eventLoop);
+        if(eventLoop->_active)
+        {
+            eventLoop->_active = false;
+            idle = false;
+        }
+        for(set<EventHandlerThreadPtr>::const_iterator q = eventLoop->_threads.begin();
+            idle && q != eventLoop->_threads.end(); ++q)
+        {
+            idle = (*q)->isIdle();
+        }
+    }
+    return idle;
+}
+
+ThreadPoolPtr
+IceInternal::ThreadPool::getEventLoop()
+{
+    if(_eventLoops.empty())
+    {
+        return this;
+    }
+
+    Lock sync(*this);
+    size_t eventLoop = _nextEventLoop++ % (_eventLoops.size() + 1);
+    return eventLoop == 0 ? ThreadPoolPtr(this) : _eventLoops[eventLoop - 1];
 }
 
 string
@@ -689,8 +808,9 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             }
             catch(const SelectorTimeoutException&)
             {
+                bool idle = eventLoopsIdle();
                 Lock sync(*this);
-                if(!_destroyed && _inUse == 0)
+                if(!_destroyed && _inUse == 0 && idle)
                 {
                     _workQueue->queue(new ShutdownWorkItem(_instance)); // Select timed-out.
                 }
@@ -758,6 +878,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                 current.operation = _nextHandler->second;
                 ++_nextHandler;
                 thread->setState(ThreadState::ThreadStateInUseForIO);
+                _active = true;
             }
             else
             {
@@ -849,8 +970,9 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             }
             catch(const SelectorTimeoutException&)
             {
+                bool idle = eventLoopsIdle();
                 Lock sync(*this);
-                if(!_destroyed)
+                if(!_destroyed && idle)
                 {
                     _workQueue->queue(new ShutdownWorkItem(_instance));
                 }
@@ -861,6 +983,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
         {
             IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
             thread->setState(ThreadState::ThreadStateInUseForIO);
+            _active = true;
         }
 
         try
@@ -1151,7 +1274,12 @@ string
 IceInternal::ThreadPool::nextThreadId()
 {
     ostringstream os;
-    os << _prefix << "-" << _nextThreadId++;
+    os << _prefix << "-";
+    if(_eventLoop > 0)
+    {
+        os << _eventLoop << "-";
+    }
+    os << _nextThreadId++;
     return os.str();
 }
 
@@ -1188,6 +1316,13 @@ IceInternal::ThreadPool::EventHandlerThread::setState(Ice::Instrumentation::Thre
     _state = s;
 }
 
+bool
+IceInternal::ThreadPool::EventHandlerThread::isIdle() const
+{
+    // Must be called with the thread pool mutex locked
+    return _state == ThreadState::ThreadStateIdle;
+}
+
 void
 IceInternal::ThreadPool::EventHandlerThread::run()
 {
@@ -23,6 +23,7 @@
 
 #include <set>
 #include <list>
+#include <vector>
 
 namespace IceInternal
 {
@@ -72,6 +73,7 @@ class ThreadPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mut
 
         void updateObserver();
         void setState(Ice::Instrumentation::ThreadState);
+        bool isIdle() const;
 
     private:
 
@@ -83,7 +85,11 @@ class ThreadPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mut
 
 public:
 
-    ThreadPool(const InstancePtr&, const std::string&, int);
+    //
+    // The thread pool creates its additional event loops with the index of
+    // the event loop and the number of event loops.
+    //
+    ThreadPool(const InstancePtr&, const std::string&, int, int = 0, int = 1);
     virtual ~ThreadPool();
 
     void destroy();
@@ -108,6 +114,13 @@ public:
 
     void joinWithAllThreads();
 
+    //
+    // Returns the event loop to use for a new event handler. A thread pool
+    // configured with several event loops returns its event loops in turn,
+    // otherwise the thread pool itself is returned.
+    //
+    ThreadPoolPtr getEventLoop();
+
     std::string prefix() const;
 
 #ifdef ICE_SWIFT
@@ -146,6 +159,13 @@ private:
     friend class ThreadPoolCurrent;
     friend class ThreadPoolWorkQueue;
 
+    bool eventLoopsIdle();
+
+    const int _eventLoop; // The index of this event loop, 0 for the thread pool itself.
+    std::vector<ThreadPoolPtr> _eventLoops; // The additional event loops, immutable after construction.
+    size_t _nextEventLoop;
+    bool _active; // True if the event loop processed an event since the last eventLoopsIdle() check.
+
     const int _size; // Number of threads that are pre-created.
     const int _sizeIO; // Maximum number of threads that can concurrently perform IO.
     const int _sizeMax; // Maximum number of threads.
@@ -15,10 +15,77 @@ TimerTask::~TimerTask()
     // Out of line to avoid weak vtable
 }
 
+namespace
+{
+
+inline int
+highestBit(IceUtil::Int64 value)
+{
+    assert(value > 0);
+#ifdef __GNUC__
+    return 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+#else
+    int n = 0;
+    while(value >>= 1)
+    {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline int
+lowestBit(unsigned long long value)
+{
+    assert(value != 0);
+#ifdef __GNUC__
+    return __builtin_ctzll(value);
+#else
+    int n = 0;
+    while(!(value & 1))
+    {
+        value >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+}
+
+//
+// Additional execution thread, it runs the timer loop like the timer thread.
+//
+class Timer::TimerThread : public IceUtil::Thread
+{
+public:
+
+    TimerThread(const TimerPtr& timer) :
+        Thread("IceUtil timer thread"),
+        _timer(timer)
+    {
+    }
+
+    virtual void run()
+    {
+        _timer->run();
+        _timer = 0;
+    }
+
+private:
+
+    TimerPtr _timer;
+};
+
 Timer::Timer() :
     Thread("IceUtil timer thread"),
-    _destroyed(false)
+    _destroyed(false),
+    _epoch(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+    _tick(0),
+    _hasPriority(false),
+    _priority(0)
 {
+    clearWheel();
     __setNoDelete(true);
     start();
     __setNoDelete(false);
@@ -26,16 +93,46 @@ Timer::Timer() :
 
 Timer::Timer(int priority) :
     Thread("IceUtil timer thread"),
-    _destroyed(false)
+    _destroyed(false),
+    _epoch(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+    _tick(0),
+    _hasPriority(true),
+    _priority(priority)
 {
+    clearWheel();
     __setNoDelete(true);
     start(0, priority);
     __setNoDelete(false);
 }
 
+void
+Timer::addThreads(int count)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    if(_destroyed)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
+    }
+
+    for(int i = 0; i < count; ++i)
+    {
+        IceUtil::ThreadPtr thread = new TimerThread(this);
+        if(_hasPriority)
+        {
+            thread->start(0, _priority);
+        }
+        else
+        {
+            thread->start();
+        }
+        _threads.push_back(thread);
+    }
+}
+
 void
 Timer::destroy()
 {
+    vector<IceUtil::ThreadPtr> threads;
     {
         IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
         if(_destroyed)
@@ -43,9 +140,14 @@ Timer::destroy()
             return;
         }
         _destroyed = true;
-        _monitor.notify();
+        _monitor.notifyAll();
+        for(unordered_map<TimerTask*, Token*>::const_iterator p = _tasks.begin(); p != _tasks.end(); ++p)
+        {
+            delete p->second;
+        }
         _tasks.clear();
-        _tokens.clear();
+        clearWheel();
+        threads.swap(_threads);
     }
 
     if(getThreadControl() == ThreadControl())
@@ -56,64 +158,30 @@ Timer::destroy()
     {
         getThreadControl().join();
     }
+
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        if((*p)->getThreadControl() == ThreadControl())
+        {
+            (*p)->getThreadControl().detach();
+        }
+        else
+        {
+            (*p)->getThreadControl().join();
+        }
+    }
 }
 
 void
 Timer::schedule(const TimerTaskPtr& task, const IceUtil::Time& delay)
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
-    if(_destroyed)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
-    }
-
-    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-    IceUtil::Time time = now + delay;
-    if(delay > IceUtil::Time() && time < now)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
-    }
-
-    bool inserted = _tasks.insert(make_pair(task, time)).second;
-    if(!inserted)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "task is already scheduled");
-    }
-    _tokens.insert(Token(time, IceUtil::Time(), task));
-
-    if(_wakeUpTime == IceUtil::Time() || time < _wakeUpTime)
-    {
-        _monitor.notify();
-    }
+    scheduleToken(task, delay, false);
 }
 
 void
 Timer::scheduleRepeated(const TimerTaskPtr& task, const IceUtil::Time& delay)
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
-    if(_destroyed)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
-    }
-
-    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-    const Token token(now + delay, delay, task);
-    if(delay > IceUtil::Time() && token.scheduledTime < now)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
-    }
-
-    bool inserted = _tasks.insert(make_pair(task, token.scheduledTime)).second;
-    if(!inserted)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "task is already scheduled");
-    }
-    _tokens.insert(token);
-
-    if(_wakeUpTime == IceUtil::Time() || token.scheduledTime < _wakeUpTime)
-    {
-        _monitor.notify();
-    }
+    scheduleToken(task, delay, true);
 }
 
 bool
@@ -125,14 +193,23 @@ Timer::cancel(const TimerTaskPtr& task)
         return false;
     }
 
-    map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare>::iterator p = _tasks.find(task);
+    unordered_map<TimerTask*, Token*>::iterator p = _tasks.find(task.get());
     if(p == _tasks.end())
     {
         return false;
     }
 
-    _tokens.erase(Token(p->second, IceUtil::Time(), p->first));
+    //
+    // A running repeated task isn't linked, the thread running it won't
+    // schedule it again since it's no longer registered.
+    //
+    Token* token = p->second;
+    if(!token->running)
+    {
+        unlink(token);
+    }
     _tasks.erase(p);
+    delete token;
 
     return true;
 }
@@ -140,65 +217,57 @@ Timer::cancel(const TimerTaskPtr& task)
 void
 Timer::run()
 {
-    Token token(IceUtil::Time(), IceUtil::Time(), 0);
+    TimerTaskPtr task;
+    IceUtil::Time delay;
     while(true)
     {
         {
             IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
 
-            if(!_destroyed)
+            if(!_destroyed && delay != IceUtil::Time())
             {
                 //
                 // If the task we just ran is a repeated task, schedule it
                 // again for executation if it wasn't canceled.
                 //
-                if(token.delay != IceUtil::Time())
-                {
-                    map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare>::iterator p = _tasks.find(token.task);
-                    if(p != _tasks.end())
-                    {
-                        token.scheduledTime = IceUtil::Time::now(IceUtil::Time::Monotonic) + token.delay;
-                        p->second = token.scheduledTime;
-                        _tokens.insert(token);
-                    }
-                }
-                token = Token(IceUtil::Time(), IceUtil::Time(), 0);
-
-                if(_tokens.empty())
+                unordered_map<TimerTask*, Token*>::iterator p = _tasks.find(task.get());
+                if(p != _tasks.end() && p->second->running)
                 {
-                    _wakeUpTime = IceUtil::Time();
-                    _monitor.wait();
+                    Token* token = p->second;
+                    token->running = false;
+                    token->expiration = expirationTick(IceUtil::Time::now(IceUtil::Time::Monotonic) + delay);
+                    insert(token);
                 }
             }
+            task = nullptr;
+            delay = IceUtil::Time();
 
-            if(_destroyed)
-            {
-                break;
-            }
-
-            while(!_tokens.empty() && !_destroyed)
+            while(!_destroyed && !_ready.head)
             {
                 const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-                const Token& first = *(_tokens.begin());
-                if(first.scheduledTime <= now)
+                advance((now - _epoch).toMilliSeconds());
+                if(_ready.head)
                 {
-                    token = first;
-                    _tokens.erase(_tokens.begin());
-                    if(token.delay == IceUtil::Time())
-                    {
-                        _tasks.erase(token.task);
-                    }
                     break;
                 }
 
-                _wakeUpTime = first.scheduledTime;
+                int level;
+                IceUtil::Int64 tick = nextTick(level);
+                if(tick < 0)
+                {
+                    _wakeUpTime = IceUtil::Time();
+                    _monitor.wait();
+                    continue;
+                }
+
+                _wakeUpTime = _epoch + IceUtil::Time::milliSeconds(tick);
                 try
                 {
-                    _monitor.timedWait(first.scheduledTime - now);
+                    _monitor.timedWait(_wakeUpTime - now);
                 }
                 catch(const IceUtil::InvalidTimeoutException&)
                 {
-                    IceUtil::Time timeout = (first.scheduledTime - now) / 2;
+                    IceUtil::Time timeout = (_wakeUpTime - now) / 2;
                     while(timeout > IceUtil::Time())
                     {
                         try
@@ -218,41 +287,60 @@ Timer::run()
             {
                 break;
             }
-        }
 
-        if(token.task)
-        {
-            try
-            {
-                runTimerTask(token.task);
-            }
-            catch(const IceUtil::Exception& e)
-            {
-                consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what();
-#ifdef __GNUC__
-                consoleErr << "\n" << e.ice_stackTrace();
-#endif
-                consoleErr << endl;
-            }
-            catch(const std::exception& e)
+            Token* token = _ready.head;
+            unlink(token);
+            task = token->task;
+            delay = token->delay;
+            if(delay == IceUtil::Time())
             {
-                consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what() << endl;
+                _tasks.erase(task.get());
+                delete token;
             }
-            catch(...)
+            else
             {
-                consoleErr << "IceUtil::Timer::run(): uncaught exception" << endl;
+                token->running = true;
             }
 
-            if(token.delay == IceUtil::Time())
+            //
+            // Wake up another thread if there are more tasks ready to run.
+            //
+            if(_ready.head && !_threads.empty())
             {
-                //
-                // If thisthe task is not a repeated task, clear the task reference now rather than
-                // in the synchronization block above. Clearing the task reference might end up
-                // calling user code which could trigger a deadlock. See also issue #352.
-                //
-                token.task = nullptr;
+                _monitor.notify();
             }
         }
+
+        try
+        {
+            runTimerTask(task);
+        }
+        catch(const IceUtil::Exception& e)
+        {
+            consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what();
+#ifdef __GNUC__
+            consoleErr << "\n" << e.ice_stackTrace();
+#endif
+            consoleErr << endl;
+        }
+        catch(const std::exception& e)
+        {
+            consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what() << endl;
+        }
+        catch(...)
+        {
+            consoleErr << "IceUtil::Timer::run(): uncaught exception" << endl;
+        }
+
+        if(delay == IceUtil::Time())
+        {
+            //
+            // If this task is not a repeated task, clear the task reference now rather than
+            // in the synchronization block above. Clearing the task reference might end up
+            // calling user code which could trigger a deadlock. See also issue #352.
+            //
+            task = nullptr;
+        }
     }
 }
 
@@ -261,3 +349,191 @@ Timer::runTimerTask(const TimerTaskPtr& task)
 {
     task->runTimerTask();
 }
+
+void
+Timer::scheduleToken(const TimerTaskPtr& task, const IceUtil::Time& delay, bool repeated)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    if(_destroyed)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    IceUtil::Time time = now + delay;
+    if(delay > IceUtil::Time() && time < now)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
+    }
+
+    pair<unordered_map<TimerTask*, Token*>::iterator, bool> p = _tasks.insert(make_pair(task.get(), nullptr));
+    if(!p.second)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "task is already scheduled");
+    }
+    Token* token = new Token(repeated ? delay : IceUtil::Time(), task, expirationTick(time));
+    p.first->second = token;
+    insert(token);
+
+    if(token->level < 0 || _wakeUpTime == IceUtil::Time() || time < _wakeUpTime)
+    {
+        _monitor.notify();
+    }
+}
+
+IceUtil::Int64
+Timer::expirationTick(const IceUtil::Time& time) const
+{
+    IceUtil::Int64 us = (time - _epoch).toMicroSeconds();
+    if(us <= 0)
+    {
+        return 0;
+    }
+
+    //
+    // The wheel covers 2^54 ticks (more than 500000 years) from the start of
+    // the current rotation of its last level, later expirations are clamped
+    // to the last tick of this rotation. Otherwise, round up to the next tick,
+    // the task must not run before its scheduled time.
+    //
+    const IceUtil::Int64 last = _tick | ((static_cast<IceUtil::Int64>(1) << (WheelBits * WheelLevels)) - 1);
+    return us / 1000 >= last ? last : (us + 999) / 1000;
+}
+
+void
+Timer::insert(Token* token)
+{
+    TokenList* list;
+    if(token->expiration <= _tick)
+    {
+        token->level = -1;
+        list = &_ready;
+    }
+    else
+    {
+        //
+        // The level is given by the highest 6-bit group where the expiration
+        // differs from the current tick, the slot by the value of this group.
+        //
+        token->level = highestBit(token->expiration ^ _tick) / WheelBits;
+        assert(token->level < WheelLevels);
+        token->slot = static_cast<int>((token->expiration >> (token->level * WheelBits)) & (WheelSlots - 1));
+        list = &_wheel[token->level][token->slot];
+        _occupied[token->level] |= 1ULL << token->slot;
+    }
+
+    token->next = 0;
+    token->prev = list->tail;
+    if(list->tail)
+    {
+        list->tail->next = token;
+    }
+    else
+    {
+        list->head = token;
+    }
+    list->tail = token;
+}
+
+void
+Timer::unlink(Token* token)
+{
+    TokenList* list = token->level < 0 ? &_ready : &_wheel[token->level][token->slot];
+    if(token->prev)
+    {
+        token->prev->next = token->next;
+    }
+    else
+    {
+        list->head = token->next;
+    }
+    if(token->next)
+    {
+        token->next->prev = token->prev;
+    }
+    else
+    {
+        list->tail = token->prev;
+    }
+    token->prev = 0;
+    token->next = 0;
+
+    if(token->level >= 0 && !list->head)
+    {
+        _occupied[token->level] &= ~(1ULL << token->slot);
+    }
+}
+
+void
+Timer::advance(IceUtil::Int64 now)
+{
+    while(true)
+    {
+        int level;
+        IceUtil::Int64 tick = nextTick(level);
+        if(tick < 0 || tick > now)
+        {
+            //
+            // Nothing to process until now, the slots of all the tokens are
+            // still ahead of the current slot of their level.
+            //
+            _tick = max(_tick, now);
+            return;
+        }
+
+        //
+        // Move to the slot and re-insert its tokens: they are ready if the
+        // slot is from the first level, they move to a lower level otherwise.
+        //
+        _tick = tick;
+        int slot = static_cast<int>((tick >> (level * WheelBits)) & (WheelSlots - 1));
+        Token* token = _wheel[level][slot].head;
+        _wheel[level][slot].head = 0;
+        _wheel[level][slot].tail = 0;
+        _occupied[level] &= ~(1ULL << slot);
+        while(token)
+        {
+            Token* next = token->next;
+            insert(token);
+            token = next;
+        }
+    }
+}
+
+IceUtil::Int64
+Timer::nextTick(int& level) const
+{
+    //
+    // Tokens are always in a slot after the current slot of their level, the
+    // next tick to process is the start of the first occupied slot of the
+    // lowest level with such a slot.
+    //
+    for(level = 0; level < WheelLevels; ++level)
+    {
+        int shift = level * WheelBits;
+        int current = static_cast<int>((_tick >> shift) & (WheelSlots - 1));
+        unsigned long long pending = _occupied[level] & ~((2ULL << current) - 1);
+        if(pending)
+        {
+            return ((_tick >> (shift + WheelBits)) << (shift + WheelBits)) |
+                (static_cast<IceUtil::Int64>(lowestBit(pending)) << shift);
+        }
+    }
+    return -1;
+}
+
+void
+Timer::clearWheel()
+{
+    for(int i = 0; i < WheelLevels; ++i)
+    {
+        for(int j = 0; j < WheelSlots; ++j)
+        {
+            _wheel[i][j].head = 0;
+            _wheel[i][j].tail = 0;
+        }
+        _occupied[i] = 0;
+    }
+    _ready.head = 0;
+    _ready.tail = 0;
+}
@@ -154,6 +154,11 @@ printHeader(ostream& s, InputStream& stream)
     stream.read(compress);
     s << "\ncompression status = "  << static_cast<int>(compress) << ' ';
 
+    if(type == validateConnectionMsg && compress > 0)
+    {
+        compress = static_cast<Byte>(0x80 | compress); // Compressors supported by the server.
+    }
+
     switch(compress)
     {
         case 0:
@@ -176,7 +181,14 @@ printHeader(ostream& s, InputStream& stream)
 
         default:
         {
-            s << "(unknown)";
+            if(compress & 0x80)
+            {
+                s << "(not compressed; supported compressors mask = " << static_cast<int>(compress & 0x7f) << ')';
+            }
+            else
+            {
+                s << "(compressed with compressor " << static_cast<int>(compress) << "; compress response, if any)";
+            }
             break;
         }
     }
@@ -3,6 +3,7 @@
 //
 
 #include <Ice/Transceiver.h>
+#include <Ice/Buffer.h>
 
 using namespace std;
 using namespace Ice;
@@ -16,3 +17,20 @@ IceInternal::Transceiver::bind()
     assert(false);
     return 0;
 }
+
+SocketOperation
+IceInternal::Transceiver::writeBuffers(vector<Buffer*>& buffers)
+{
+    for(vector<Buffer*>::const_iterator p = buffers.begin(); p != buffers.end(); ++p)
+    {
+        if((*p)->i != (*p)->b.end())
+        {
+            SocketOperation op = write(**p);
+            if(op)
+            {
+                return op;
+            }
+        }
+    }
+    return SocketOperationNone;
+}
@@ -11,6 +11,8 @@
 #include <Ice/EndpointIF.h>
 #include <Ice/Network.h>
 
+#include <vector>
+
 namespace IceInternal
 {
 
@@ -29,6 +31,13 @@ public:
     virtual EndpointIPtr bind();
     virtual SocketOperation write(Buffer&) = 0;
     virtual SocketOperation read(Buffer&) = 0;
+
+    //
+    // Write the given buffers in order. The default implementation writes
+    // the buffers one after the other, transceivers which support gather
+    // writes can override it to write all the buffers with a single call.
+    //
+    virtual SocketOperation writeBuffers(std::vector<Buffer*>&);
 #if defined(ICE_USE_IOCP)
     virtual bool startWrite(Buffer&) = 0;
     virtual void finishWrite(Buffer&) = 0;
@@ -12,6 +12,13 @@
 #include <Ice/Properties.h>
 #include <IceUtil/StringUtil.h>
 
+#if defined(ICE_USE_MMSG)
+#   include <netinet/udp.h>
+#   ifndef UDP_SEGMENT
+#       define UDP_SEGMENT 103
+#   endif
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -77,6 +84,9 @@ IceInternal::UdpTransceiver::close()
     SOCKET fd = _fd;
     _fd = INVALID_SOCKET;
     closeSocket(fd);
+#if defined(ICE_USE_MMSG)
+    clearBatch();
+#endif
 }
 
 EndpointIPtr
@@ -157,21 +167,7 @@ repeat:
     }
     else
     {
-        socklen_t len = static_cast<socklen_t>(sizeof(sockaddr_storage));
-        if(_peerAddr.saStorage.ss_family == AF_INET)
-        {
-            len = static_cast<socklen_t>(sizeof(sockaddr_in));
-        }
-        else if(_peerAddr.saStorage.ss_family == AF_INET6)
-        {
-            len = static_cast<socklen_t>(sizeof(sockaddr_in6));
-        }
-        else
-        {
-            // No peer has sent a datagram yet.
-            throw SocketException(__FILE__, __LINE__, 0);
-        }
-
+        socklen_t len = peerAddrLen();
 #ifdef _WIN32
         ret = ::sendto(_fd, reinterpret_cast<const char*>(&buf.b[0]), static_cast<int>(buf.b.size()), 0,
                        &_peerAddr.sa, len);
@@ -212,6 +208,13 @@ IceInternal::UdpTransceiver::read(Buffer& buf)
     assert(buf.i == buf.b.begin());
     assert(_fd != INVALID_SOCKET);
 
+#if defined(ICE_USE_MMSG)
+    if(_rcvBatch > 1 && _state != StateNeedConnect)
+    {
+        return readBatch(buf);
+    }
+#endif
+
 #ifdef _WIN32
     int packetSize = min(_maxPacketSize, _rcvSize - _udpOverhead);
 #else
@@ -307,6 +310,230 @@ repeat:
     return SocketOperationNone;
 }
 
+#if defined(ICE_USE_MMSG)
+SocketOperation
+IceInternal::UdpTransceiver::writeBuffers(vector<Buffer*>& buffers)
+{
+    vector<Buffer*>::const_iterator p = buffers.begin();
+    while(p != buffers.end() && (*p)->i == (*p)->b.end())
+    {
+        ++p;
+    }
+    if(buffers.end() - p <= 1)
+    {
+        return Transceiver::writeBuffers(buffers);
+    }
+    assert(_fd != INVALID_SOCKET && _state >= StateConnected);
+
+    //
+    // Each buffer is a datagram, up to 64 datagrams are sent with each call
+    // to sendmmsg. With UDP generic segmentation offload, consecutive
+    // datagrams of the same size are sent as a single message, segmented
+    // by the kernel or the network interface (only the last datagram of
+    // such a message can be smaller).
+    //
+    while(p != buffers.end())
+    {
+        struct mmsghdr msgs[64];
+        struct iovec iov[64];
+        union
+        {
+            char buf[CMSG_SPACE(sizeof(uint16_t))];
+            struct cmsghdr align;
+        } control[64];
+        vector<Buffer*>::const_iterator last[64];
+
+        socklen_t len = _state == StateConnected ? 0 : peerAddrLen();
+        const size_t maxSize = static_cast<size_t>(min(_maxPacketSize, _sndSize - _udpOverhead));
+        unsigned int count = 0;
+        int iovcnt = 0;
+        vector<Buffer*>::const_iterator q = p;
+        while(q != buffers.end() && count < 64 && iovcnt < 64)
+        {
+            assert((*q)->i == (*q)->b.begin());
+            size_t segment = (*q)->b.size();
+            struct msghdr& hdr = msgs[count].msg_hdr;
+            memset(&hdr, 0, sizeof(hdr));
+            hdr.msg_name = len > 0 ? &_peerAddr.sa : 0;
+            hdr.msg_namelen = len;
+            hdr.msg_iov = &iov[iovcnt];
+
+            size_t size = 0;
+            do
+            {
+                iov[iovcnt].iov_base = &(*q)->b[0];
+                iov[iovcnt].iov_len = (*q)->b.size();
+                size += (*q)->b.size();
+                ++iovcnt;
+                ++hdr.msg_iovlen;
+                last[count] = q++;
+            }
+            while(_gso && q != buffers.end() && iovcnt < 64 && (*last[count])->b.size() == segment &&
+                  (*q)->b.size() <= segment && size + (*q)->b.size() <= maxSize);
+
+            if(hdr.msg_iovlen > 1)
+            {
+                hdr.msg_control = control[count].buf;
+                hdr.msg_controllen = sizeof(control[count].buf);
+                struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t gsoSize = static_cast<uint16_t>(segment);
+                memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+            }
+            ++count;
+        }
+
+        int ret = ::sendmmsg(_fd, msgs, count, 0);
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                return SocketOperationWrite;
+            }
+
+            if(_gso && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT))
+            {
+                //
+                // The kernel or the network interface doesn't support
+                // segmentation offload, send the datagrams separately.
+                //
+                _gso = false;
+                continue;
+            }
+
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+
+        for(int i = 0; i < ret; ++i)
+        {
+            for(vector<Buffer*>::const_iterator r = p; r <= last[i]; ++r)
+            {
+                (*r)->i = (*r)->b.end();
+            }
+            p = last[i] + 1;
+        }
+
+        if(static_cast<unsigned int>(ret) < count)
+        {
+            //
+            // The datagrams which weren't sent are sent once the socket is
+            // writable again, or the error is reported by the next call.
+            //
+            return SocketOperationWrite;
+        }
+    }
+    return SocketOperationNone;
+}
+
+SocketOperation
+IceInternal::UdpTransceiver::readBatch(Buffer& buf)
+{
+    if(_rcvNext == _rcvCount)
+    {
+        const size_t packetSize = static_cast<size_t>(min(_maxPacketSize, _rcvSize - _udpOverhead));
+        if(_rcvBuffers.empty())
+        {
+            //
+            // Each buffer must be able to hold the largest datagram, the number
+            // of buffers is limited so that the batch buffers don't take more
+            // memory than the socket receive buffer.
+            //
+            size_t batch = min(static_cast<size_t>(_rcvBatch),
+                               max(static_cast<size_t>(_rcvSize) / packetSize, static_cast<size_t>(1)));
+            for(size_t i = 0; i < batch; ++i)
+            {
+                _rcvBuffers.push_back(new Buffer::Container());
+            }
+            _rcvAddrs.resize(batch);
+            _rcvSizes.resize(batch);
+        }
+
+        vector<struct mmsghdr> msgs(_rcvBuffers.size());
+        vector<struct iovec> iov(_rcvBuffers.size());
+        for(size_t i = 0; i < msgs.size(); ++i)
+        {
+            _rcvBuffers[i]->resize(packetSize);
+            iov[i].iov_base = &(*_rcvBuffers[i])[0];
+            iov[i].iov_len = packetSize;
+
+            struct msghdr& hdr = msgs[i].msg_hdr;
+            memset(&hdr, 0, sizeof(hdr));
+            if(_state != StateConnected)
+            {
+                memset(&_rcvAddrs[i].saStorage, 0, sizeof(sockaddr_storage));
+                hdr.msg_name = &_rcvAddrs[i].sa;
+                hdr.msg_namelen = static_cast<socklen_t>(sizeof(sockaddr_storage));
+            }
+            hdr.msg_iov = &iov[i];
+            hdr.msg_iovlen = 1;
+        }
+
+        int ret;
+        while(true)
+        {
+            ret = ::recvmmsg(_fd, &msgs[0], static_cast<unsigned int>(msgs.size()), 0, 0);
+            if(ret != SOCKET_ERROR)
+            {
+                break;
+            }
+
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                return SocketOperationRead;
+            }
+
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            else
+            {
+                throw SocketException(__FILE__, __LINE__, getSocketErrno());
+            }
+        }
+
+        //
+        // Truncated datagrams fill the whole buffer, this is detected at the
+        // connection level when the Ice message size is checked.
+        //
+        for(int i = 0; i < ret; ++i)
+        {
+            _rcvSizes[static_cast<size_t>(i)] = msgs[static_cast<size_t>(i)].msg_len;
+        }
+        _rcvCount = ret;
+        _rcvNext = 0;
+    }
+
+    size_t i = static_cast<size_t>(_rcvNext++);
+    buf.b.swap(*_rcvBuffers[i]);
+    buf.b.resize(_rcvSizes[i]);
+    buf.i = buf.b.end();
+    if(_state != StateConnected)
+    {
+        _peerAddr = _rcvAddrs[i];
+    }
+
+    //
+    // Tell the thread pool to call read again without waiting for the socket
+    // to be readable if datagrams are left from the batch.
+    //
+    ready(SocketOperationRead, _rcvNext < _rcvCount);
+    return SocketOperationNone;
+}
+#endif
+
 #if defined(ICE_USE_IOCP)
 bool
 IceInternal::UdpTransceiver::startWrite(Buffer& buf)
@@ -327,20 +554,7 @@ IceInternal::UdpTransceiver::startWrite(Buffer& buf)
     }
     else
     {
-        socklen_t len = static_cast<socklen_t>(sizeof(sockaddr_storage));
-        if(_peerAddr.saStorage.ss_family == AF_INET)
-        {
-            len = sizeof(sockaddr_in);
-        }
-        else if(_peerAddr.saStorage.ss_family == AF_INET6)
-        {
-            len = sizeof(sockaddr_in6);
-        }
-        else
-        {
-            // No peer has sent a datagram yet.
-            throw SocketException(__FILE__, __LINE__, 0);
-        }
+        socklen_t len = peerAddrLen();
         err = WSASendTo(_fd, &_write.buf, 1, &_write.count, 0, &_peerAddr.sa, len, &_write, nullptr);
     }
 
@@ -610,6 +824,12 @@ IceInternal::UdpTransceiver::UdpTransceiver(const ProtocolInstancePtr& instance,
     _bound(false),
     _addr(addr),
     _state(StateNeedConnect)
+#if defined(ICE_USE_MMSG)
+    , _rcvBatch(max(1, min(64, instance->properties()->getPropertyAsIntWithDefault("Ice.UDP.RcvBatch", 1)))),
+    _gso(instance->properties()->getPropertyAsInt("Ice.UDP.GSO") > 0),
+    _rcvCount(0),
+    _rcvNext(0)
+#endif
 #if defined(ICE_USE_IOCP)
     , _read(SocketOperationRead),
     _write(SocketOperationWrite)
@@ -671,6 +891,12 @@ IceInternal::UdpTransceiver::UdpTransceiver(const UdpEndpointIPtr& endpoint, con
     _mcastInterface(mcastInterface),
     _port(port),
     _state(connect ? StateNeedConnect : StateNotConnected)
+#if defined(ICE_USE_MMSG)
+    , _rcvBatch(max(1, min(64, instance->properties()->getPropertyAsIntWithDefault("Ice.UDP.RcvBatch", 1)))),
+    _gso(instance->properties()->getPropertyAsInt("Ice.UDP.GSO") > 0),
+    _rcvCount(0),
+    _rcvNext(0)
+#endif
 #ifdef ICE_USE_IOCP
     , _read(SocketOperationRead),
     _write(SocketOperationWrite)
@@ -689,8 +915,43 @@ IceInternal::UdpTransceiver::UdpTransceiver(const UdpEndpointIPtr& endpoint, con
 IceInternal::UdpTransceiver::~UdpTransceiver()
 {
     assert(_fd == INVALID_SOCKET);
+#if defined(ICE_USE_MMSG)
+    clearBatch();
+#endif
+}
+
+socklen_t
+IceInternal::UdpTransceiver::peerAddrLen() const
+{
+    if(_peerAddr.saStorage.ss_family == AF_INET)
+    {
+        return static_cast<socklen_t>(sizeof(sockaddr_in));
+    }
+    else if(_peerAddr.saStorage.ss_family == AF_INET6)
+    {
+        return static_cast<socklen_t>(sizeof(sockaddr_in6));
+    }
+    else
+    {
+        // No peer has sent a datagram yet.
+        throw SocketException(__FILE__, __LINE__, 0);
+    }
 }
 
+#if defined(ICE_USE_MMSG)
+void
+IceInternal::UdpTransceiver::clearBatch()
+{
+    for(vector<Buffer::Container*>::const_iterator p = _rcvBuffers.begin(); p != _rcvBuffers.end(); ++p)
+    {
+        delete *p;
+    }
+    _rcvBuffers.clear();
+    _rcvCount = 0;
+    _rcvNext = 0;
+}
+#endif
+
 //
 // Set UDP receive and send buffer sizes.
 //
@@ -9,8 +9,17 @@
 
 #include <Ice/ProtocolInstanceF.h>
 #include <Ice/Transceiver.h>
+#include <Ice/Buffer.h>
 #include <Ice/Network.h>
 
+#if defined(ICE_USE_EPOLL)
+//
+// Linux supports sending and receiving multiple datagrams with a single
+// system call.
+//
+#   define ICE_USE_MMSG 1
+#endif
+
 namespace IceInternal
 {
 
@@ -39,6 +48,9 @@ public:
     virtual EndpointIPtr bind();
     virtual SocketOperation write(Buffer&);
     virtual SocketOperation read(Buffer&);
+#if defined(ICE_USE_MMSG)
+    virtual SocketOperation writeBuffers(std::vector<Buffer*>&);
+#endif
 #if defined(ICE_USE_IOCP)
     virtual bool startWrite(Buffer&);
     virtual void finishWrite(Buffer&);
@@ -63,6 +75,11 @@ private:
     virtual ~UdpTransceiver();
 
     void setBufSize(int, int);
+    socklen_t peerAddrLen() const;
+#if defined(ICE_USE_MMSG)
+    SocketOperation readBatch(Buffer&);
+    void clearBatch();
+#endif
 
     friend class UdpEndpointI;
     friend class UdpConnector;
@@ -84,6 +101,20 @@ private:
     static const int _udpOverhead;
     static const int _maxPacketSize;
 
+#if defined(ICE_USE_MMSG)
+    //
+    // Datagrams received with a single recvmmsg call and not yet returned
+    // by read(), the buffers are swapped with the connection read buffer.
+    //
+    const int _rcvBatch;
+    bool _gso;
+    std::vector<Buffer::Container*> _rcvBuffers;
+    std::vector<Address> _rcvAddrs;
+    std::vector<size_t> _rcvSizes;
+    int _rcvCount;
+    int _rcvNext;
+#endif
+
 #ifdef ICE_USE_IOCP
     AsyncInfo _read;
     AsyncInfo _write;
@@ -58,7 +58,7 @@ IceInternal::WSAcceptor::accept()
     // WebSocket handshaking is performed in TransceiverI::initialize, since
     // accept must not block.
     //
-    return new WSTransceiver(_instance, _delegate->accept());
+    return new WSTransceiver(_instance, _delegate->accept(), _endpoint->deflate());
 }
 
 string
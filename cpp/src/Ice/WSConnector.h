@@ -27,7 +27,7 @@ public:
     virtual bool operator==(const Connector&) const;
     virtual bool operator<(const Connector&) const;
 
-    WSConnector(const ProtocolInstancePtr&, const ConnectorPtr&, const std::string&, const std::string&);
+    WSConnector(const ProtocolInstancePtr&, const ConnectorPtr&, const std::string&, const std::string&, int);
     virtual ~WSConnector();
 
 private:
@@ -36,6 +36,7 @@ private:
     const ConnectorPtr _delegate;
     const std::string _host;
     const std::string _resource;
+    const int _deflate;
 };
 
 }
@@ -0,0 +1,459 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/WSDeflate.h>
+#include <Ice/HttpParser.h>
+#include <Ice/LocalException.h>
+#include <Ice/InstrumentationI.h>
+#include <IceUtil/StringUtil.h>
+
+#include <set>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace
+{
+
+const string _extensionName = "permessage-deflate";
+
+//
+// Messages smaller than this aren't worth compressing, they are sent
+// uncompressed and don't enter the compression context.
+//
+const size_t compressMinSize = 64;
+
+//
+// The trailer removed from the end of each compressed message.
+//
+const Byte syncFlushTrailer[] = { 0x00, 0x00, 0xff, 0xff };
+
+//
+// The parameters of an extension offer or response. A window bits value
+// of -1 means the parameter isn't present and 0 means it's present
+// without a value (only valid for client_max_window_bits in an offer).
+//
+struct DeflateParams
+{
+    DeflateParams() :
+        serverNoContextTakeover(false),
+        clientNoContextTakeover(false),
+        serverMaxWindowBits(-1),
+        clientMaxWindowBits(-1)
+    {
+    }
+
+    bool serverNoContextTakeover;
+    bool clientNoContextTakeover;
+    int serverMaxWindowBits;
+    int clientMaxWindowBits;
+};
+
+bool
+parseWindowBits(const string& value, int& bits)
+{
+    if(value.empty() || value.size() > 2 || value.find_first_not_of("0123456789") != string::npos)
+    {
+        return false;
+    }
+    bits = atoi(value.c_str());
+    return bits >= 8 && bits <= 15;
+}
+
+//
+// Parse an extension offer or response of the form:
+//
+// permessage-deflate; server_no_context_takeover; client_max_window_bits=10
+//
+// Returns false if the extension isn't permessage-deflate or if a parameter
+// is unknown, duplicated or invalid.
+//
+bool
+parseExtension(const string& extension, DeflateParams& params)
+{
+    vector<string> tokens;
+    if(!IceUtilInternal::splitString(extension, ";", tokens) || tokens.empty() ||
+       IceUtilInternal::toLower(IceUtilInternal::trim(tokens[0])) != _extensionName)
+    {
+        return false;
+    }
+
+    set<string> seen;
+    for(vector<string>::const_iterator p = tokens.begin() + 1; p != tokens.end(); ++p)
+    {
+        string name = IceUtilInternal::trim(*p);
+        string value;
+        string::size_type pos = name.find('=');
+        if(pos != string::npos)
+        {
+            value = IceUtilInternal::trim(name.substr(pos + 1));
+            name = IceUtilInternal::trim(name.substr(0, pos));
+        }
+        name = IceUtilInternal::toLower(name);
+
+        if(!seen.insert(name).second)
+        {
+            return false;
+        }
+
+        if(name == "server_no_context_takeover" && pos == string::npos)
+        {
+            params.serverNoContextTakeover = true;
+        }
+        else if(name == "client_no_context_takeover" && pos == string::npos)
+        {
+            params.clientNoContextTakeover = true;
+        }
+        else if(name == "server_max_window_bits")
+        {
+            if(!parseWindowBits(value, params.serverMaxWindowBits))
+            {
+                return false;
+            }
+        }
+        else if(name == "client_max_window_bits")
+        {
+            if(pos == string::npos)
+            {
+                params.clientMaxWindowBits = 0;
+            }
+            else if(!parseWindowBits(value, params.clientMaxWindowBits))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+IceInternal::WSDeflate::WSDeflate(bool server, int windowBits, size_t messageSizeMax) :
+    _server(server),
+    _windowBits(windowBits),
+    _messageSizeMax(messageSizeMax),
+    _compressWindowBits(windowBits),
+    _compressNoContextTakeover(false),
+    _initialized(false),
+    _sentBytes(0),
+    _sentCompressedBytes(0),
+    _receivedBytes(0),
+    _receivedCompressedBytes(0)
+{
+    assert(_windowBits >= minWindowBits && _windowBits <= maxWindowBits);
+}
+
+IceInternal::WSDeflate::~WSDeflate()
+{
+    if(_observer)
+    {
+        _observer->detach();
+    }
+#ifdef ICE_HAS_ZLIB
+    if(_initialized)
+    {
+        deflateEnd(&_deflate);
+        inflateEnd(&_inflate);
+    }
+#endif
+}
+
+bool
+IceInternal::WSDeflate::supported()
+{
+#ifdef ICE_HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+string
+IceInternal::WSDeflate::offer() const
+{
+    assert(!_server);
+
+    //
+    // We accept any window size from the server, the client_max_window_bits
+    // parameter tells the server it can limit our window size.
+    //
+    ostringstream os;
+    os << _extensionName << "; client_max_window_bits";
+    if(_windowBits < maxWindowBits)
+    {
+        os << "=" << _windowBits;
+    }
+    return os.str();
+}
+
+void
+IceInternal::WSDeflate::accept(const string& response)
+{
+    assert(!_server);
+
+    //
+    // "The server MUST NOT include more than one extension with the same
+    //  name", the response must be a single valid permessage-deflate
+    //  extension since this is the only extension we offer.
+    //
+    DeflateParams params;
+    if(response.find(',') != string::npos || !parseExtension(response, params) || params.clientMaxWindowBits == 0)
+    {
+        throw WebSocketException("invalid value `" + response + "' for Sec-WebSocket-Extensions");
+    }
+
+    _compressWindowBits = _windowBits;
+    if(params.clientMaxWindowBits > 0)
+    {
+        _compressWindowBits = min(_compressWindowBits, params.clientMaxWindowBits);
+        if(_compressWindowBits < minWindowBits)
+        {
+            throw WebSocketException("unsupported value `" + response + "' for Sec-WebSocket-Extensions");
+        }
+    }
+    _compressNoContextTakeover = params.clientNoContextTakeover;
+    init();
+}
+
+bool
+IceInternal::WSDeflate::negotiate(const string& offers, string& response)
+{
+    assert(_server);
+
+    //
+    // Select the first permessage-deflate offer with parameters we support.
+    // We don't restrict the client window size: the decompression window
+    // is always the largest window.
+    //
+    vector<string> extensions;
+    if(!IceUtilInternal::splitString(offers, ",", extensions))
+    {
+        return false;
+    }
+
+    for(vector<string>::const_iterator p = extensions.begin(); p != extensions.end(); ++p)
+    {
+        DeflateParams params;
+        if(!parseExtension(*p, params) || params.serverMaxWindowBits == 0)
+        {
+            continue;
+        }
+
+        int windowBits = _windowBits;
+        if(params.serverMaxWindowBits > 0)
+        {
+            if(params.serverMaxWindowBits < minWindowBits)
+            {
+                continue;
+            }
+            windowBits = min(windowBits, params.serverMaxWindowBits);
+        }
+
+        ostringstream os;
+        os << _extensionName;
+        if(windowBits < maxWindowBits || params.serverMaxWindowBits > 0)
+        {
+            os << "; server_max_window_bits=" << windowBits;
+        }
+        if(params.serverNoContextTakeover)
+        {
+            os << "; server_no_context_takeover";
+        }
+        if(params.clientNoContextTakeover)
+        {
+            os << "; client_no_context_takeover";
+        }
+        response = os.str();
+
+        _compressWindowBits = windowBits;
+        _compressNoContextTakeover = params.serverNoContextTakeover;
+        init();
+        return true;
+    }
+    return false;
+}
+
+#ifdef ICE_HAS_ZLIB
+bool
+IceInternal::WSDeflate::compress(const Byte* data, size_t size, Buffer::Container& out)
+{
+    assert(_initialized);
+    if(size < compressMinSize)
+    {
+        return false;
+    }
+
+    out.resize(deflateBound(&_deflate, static_cast<uLong>(size)) + sizeof(syncFlushTrailer) + 8);
+    _deflate.next_in = const_cast<Bytef*>(data);
+    _deflate.avail_in = static_cast<uInt>(size);
+    size_t pos = 0;
+    do
+    {
+        if(pos == out.size())
+        {
+            out.resize(out.size() * 2);
+        }
+        _deflate.next_out = &out[pos];
+        _deflate.avail_out = static_cast<uInt>(out.size() - pos);
+        int rc = ::deflate(&_deflate, Z_SYNC_FLUSH);
+        if(rc != Z_OK && rc != Z_BUF_ERROR)
+        {
+            throw CompressionException(__FILE__, __LINE__, "deflate failed");
+        }
+        pos = out.size() - _deflate.avail_out;
+    }
+    while(_deflate.avail_out == 0);
+
+    //
+    // "Remove 4 octets (that are 0x00 0x00 0xff 0xff) from the tail end."
+    //
+    assert(pos >= sizeof(syncFlushTrailer) &&
+           memcmp(&out[pos - sizeof(syncFlushTrailer)], syncFlushTrailer, sizeof(syncFlushTrailer)) == 0);
+    out.resize(pos - sizeof(syncFlushTrailer));
+
+    if(_compressNoContextTakeover)
+    {
+        deflateReset(&_deflate);
+    }
+
+    _sentBytes += static_cast<Long>(size);
+    _sentCompressedBytes += static_cast<Long>(out.size());
+    if(_observer)
+    {
+        _observer->sent(static_cast<Long>(size), static_cast<Long>(out.size()));
+    }
+    return true;
+}
+#else
+bool
+IceInternal::WSDeflate::compress(const Byte*, size_t, Buffer::Container&)
+{
+    assert(false); // Never negotiated without zlib.
+    return false;
+}
+#endif
+
+void
+IceInternal::WSDeflate::decompress(const Byte* data, size_t size, bool last, vector<Byte>& out)
+{
+    assert(_initialized);
+    const size_t start = out.size();
+    inflate(data, size, out);
+    if(last)
+    {
+        //
+        // "Append 4 octets of 0x00 0x00 0xff 0xff to the tail end of the
+        //  payload of the message."
+        //
+        inflate(syncFlushTrailer, sizeof(syncFlushTrailer), out);
+    }
+    _receivedCompressedBytes += static_cast<Long>(size);
+    _receivedBytes += static_cast<Long>(out.size() - start);
+    if(_observer)
+    {
+        _observer->received(static_cast<Long>(out.size() - start), static_cast<Long>(size));
+    }
+}
+
+string
+IceInternal::WSDeflate::stats() const
+{
+    ostringstream os;
+    os << "permessage-deflate: sent " << _sentBytes << " bytes compressed to " << _sentCompressedBytes
+       << " bytes, received " << _receivedCompressedBytes << " bytes decompressed to " << _receivedBytes << " bytes";
+    return os.str();
+}
+
+void
+IceInternal::WSDeflate::setObserver(const WebSocketDeflateObserverIPtr& observer)
+{
+    if(_observer)
+    {
+        _observer->detach();
+    }
+    _observer = observer;
+    if(_observer)
+    {
+        _observer->attach();
+    }
+}
+
+void
+IceInternal::WSDeflate::init()
+{
+#ifdef ICE_HAS_ZLIB
+    assert(!_initialized);
+    memset(&_deflate, 0, sizeof(_deflate));
+    memset(&_inflate, 0, sizeof(_inflate));
+
+    //
+    // Negative window bits select raw deflate streams, without zlib header
+    // and trailer.
+    //
+    if(deflateInit2(&_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -_compressWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw CompressionException(__FILE__, __LINE__, "deflateInit2 failed");
+    }
+    if(inflateInit2(&_inflate, -maxWindowBits) != Z_OK)
+    {
+        deflateEnd(&_deflate);
+        throw CompressionException(__FILE__, __LINE__, "inflateInit2 failed");
+    }
+    _initialized = true;
+#else
+    throw FeatureNotSupportedException(__FILE__, __LINE__, "permessage-deflate requires zlib");
+#endif
+}
+
+#ifdef ICE_HAS_ZLIB
+void
+IceInternal::WSDeflate::inflate(const Byte* data, size_t size, vector<Byte>& out)
+{
+    _inflate.next_in = const_cast<Bytef*>(data);
+    _inflate.avail_in = static_cast<uInt>(size);
+    const size_t chunk = max(size * 4, static_cast<size_t>(4096));
+    do
+    {
+        size_t pos = out.size();
+        out.resize(pos + chunk);
+        _inflate.next_out = &out[pos];
+        _inflate.avail_out = static_cast<uInt>(chunk);
+        int rc = ::inflate(&_inflate, Z_SYNC_FLUSH);
+        out.resize(out.size() - _inflate.avail_out);
+        if(rc == Z_STREAM_END)
+        {
+            //
+            // The peer ended the deflate stream with a final block, the
+            // next message starts a new stream.
+            //
+            inflateReset(&_inflate);
+        }
+        else if(rc == Z_BUF_ERROR)
+        {
+            break; // No progress possible, all the input is consumed.
+        }
+        else if(rc != Z_OK)
+        {
+            throw CompressionException(__FILE__, __LINE__, "invalid permessage-deflate data");
+        }
+
+        if(out.size() > _messageSizeMax)
+        {
+            throw MemoryLimitException(__FILE__, __LINE__);
+        }
+    }
+    while(_inflate.avail_in > 0 || _inflate.avail_out == 0);
+}
+#else
+void
+IceInternal::WSDeflate::inflate(const Byte*, size_t, vector<Byte>&)
+{
+    assert(false); // Never negotiated without zlib.
+}
+#endif
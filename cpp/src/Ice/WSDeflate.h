@@ -0,0 +1,93 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_WS_DEFLATE_H
+#define ICE_WS_DEFLATE_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
+#include <Ice/Config.h>
+#include <Ice/Buffer.h>
+
+#ifdef ICE_HAS_ZLIB
+#   include <zlib.h>
+#endif
+
+namespace IceInternal
+{
+
+class WebSocketDeflateObserverI;
+
+//
+// The permessage-deflate WebSocket extension (RFC 7692).
+//
+// The client offers the extension with offer() and checks the server's
+// response with accept(), the server selects an offer with negotiate().
+// Once negotiated, each WebSocket message is compressed with compress()
+// and the frames of compressed messages are decompressed with
+// decompress(). The compression contexts are kept from one message to
+// the next unless the peer asked for no context takeover.
+//
+class WSDeflate : public IceUtil::Shared
+{
+public:
+
+    //
+    // The window bits used when the endpoint doesn't specify them and the
+    // range of window bits supported for compression (zlib doesn't support
+    // 8 bits windows for raw deflate streams).
+    //
+    static const int defaultWindowBits = 15;
+    static const int minWindowBits = 9;
+    static const int maxWindowBits = 15;
+
+    WSDeflate(bool, int, size_t);
+    ~WSDeflate();
+
+    static bool supported();
+
+    std::string offer() const;
+    void accept(const std::string&);
+    bool negotiate(const std::string&, std::string&);
+
+    bool compress(const Ice::Byte*, size_t, Buffer::Container&);
+    void decompress(const Ice::Byte*, size_t, bool, std::vector<Ice::Byte>&);
+
+    std::string stats() const;
+
+    //
+    // Set the observer updating the WebSocketDeflate metrics, the previous
+    // observer is detached.
+    //
+    void setObserver(const std::shared_ptr<WebSocketDeflateObserverI>&);
+
+private:
+
+    void init();
+    void inflate(const Ice::Byte*, size_t, std::vector<Ice::Byte>&);
+
+    const bool _server;
+    const int _windowBits;
+    const size_t _messageSizeMax;
+
+    int _compressWindowBits;
+    bool _compressNoContextTakeover;
+
+#ifdef ICE_HAS_ZLIB
+    z_stream _deflate;
+    z_stream _inflate;
+#endif
+    bool _initialized;
+
+    Ice::Long _sentBytes;
+    Ice::Long _sentCompressedBytes;
+    Ice::Long _receivedBytes;
+    Ice::Long _receivedCompressedBytes;
+    std::shared_ptr<WebSocketDeflateObserverI> _observer;
+};
+typedef IceUtil::Handle<WSDeflate> WSDeflatePtr;
+
+}
+
+#endif
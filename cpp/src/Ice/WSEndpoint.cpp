@@ -5,6 +5,7 @@
 #include <Ice/WSEndpoint.h>
 #include <Ice/WSAcceptor.h>
 #include <Ice/WSConnector.h>
+#include <Ice/WSDeflate.h>
 #include <Ice/OutputStream.h>
 #include <Ice/InputStream.h>
 #include <Ice/LocalException.h>
@@ -95,13 +96,14 @@ WSEndpointFactoryPlugin::destroy()
 {
 }
 
-IceInternal::WSEndpoint::WSEndpoint(const ProtocolInstancePtr& instance, const EndpointIPtr& del, const string& res) :
-    _instance(instance), _delegate(del), _resource(res)
+IceInternal::WSEndpoint::WSEndpoint(const ProtocolInstancePtr& instance, const EndpointIPtr& del, const string& res,
+                                    int deflate) :
+    _instance(instance), _delegate(del), _resource(res), _deflate(deflate)
 {
 }
 
 IceInternal::WSEndpoint::WSEndpoint(const ProtocolInstancePtr& inst, const EndpointIPtr& del, vector<string>& args) :
-    _instance(inst), _delegate(del)
+    _instance(inst), _delegate(del), _deflate(0)
 {
     initWithOptions(args);
 
@@ -112,7 +114,7 @@ IceInternal::WSEndpoint::WSEndpoint(const ProtocolInstancePtr& inst, const Endpo
 }
 
 IceInternal::WSEndpoint::WSEndpoint(const ProtocolInstancePtr& instance, const EndpointIPtr& del, InputStream* s) :
-    _instance(instance), _delegate(del)
+    _instance(instance), _delegate(del), _deflate(0)
 {
     s->read(const_cast<string&>(_resource), false);
 }
@@ -162,7 +164,7 @@ IceInternal::WSEndpoint::timeout(Int timeout) const
     }
     else
     {
-        return std::make_shared<WSEndpoint>(_instance, _delegate->timeout(timeout), _resource);
+        return std::make_shared<WSEndpoint>(_instance, _delegate->timeout(timeout), _resource, _deflate);
     }
 }
 
@@ -181,7 +183,7 @@ IceInternal::WSEndpoint::connectionId(const string& connectionId) const
     }
     else
     {
-        return std::make_shared<WSEndpoint>(_instance, _delegate->connectionId(connectionId), _resource);
+        return std::make_shared<WSEndpoint>(_instance, _delegate->connectionId(connectionId), _resource, _deflate);
     }
 }
 
@@ -200,7 +202,7 @@ IceInternal::WSEndpoint::compress(bool compress) const
     }
     else
     {
-        return std::make_shared<WSEndpoint>(_instance, _delegate->compress(compress), _resource);
+        return std::make_shared<WSEndpoint>(_instance, _delegate->compress(compress), _resource, _deflate);
     }
 }
 
@@ -231,8 +233,8 @@ IceInternal::WSEndpoint::connectors_async(EndpointSelectionType selType,
     public:
 
         CallbackI(const EndpointI_connectorsPtr& callback, const ProtocolInstancePtr& instance,
-                  const string& host, const string& resource) :
-            _callback(callback), _instance(instance), _host(host), _resource(resource)
+                  const string& host, const string& resource, int deflate) :
+            _callback(callback), _instance(instance), _host(host), _resource(resource), _deflate(deflate)
         {
         }
 
@@ -241,7 +243,7 @@ IceInternal::WSEndpoint::connectors_async(EndpointSelectionType selType,
             vector<ConnectorPtr> connectors = c;
             for(vector<ConnectorPtr>::iterator p = connectors.begin(); p != connectors.end(); ++p)
             {
-                *p = new WSConnector(_instance, *p, _host, _resource);
+                *p = new WSConnector(_instance, *p, _host, _resource, _deflate);
             }
             _callback->connectors(connectors);
         }
@@ -257,6 +259,7 @@ IceInternal::WSEndpoint::connectors_async(EndpointSelectionType selType,
         const ProtocolInstancePtr _instance;
         const string _host;
         const string _resource;
+        const int _deflate;
     };
 
     ostringstream host;
@@ -265,7 +268,8 @@ IceInternal::WSEndpoint::connectors_async(EndpointSelectionType selType,
     {
         host << info->host << ":" << info->port;
     }
-    _delegate->connectors_async(selType, std::make_shared<CallbackI>(callback, _instance, host.str(), _resource));
+    _delegate->connectors_async(selType, std::make_shared<CallbackI>(callback, _instance, host.str(), _resource,
+                                                                       _deflate));
 }
 
 AcceptorPtr
@@ -284,10 +288,16 @@ IceInternal::WSEndpoint::endpoint(const EndpointIPtr& delEndp) const
     }
     else
     {
-        return std::make_shared<WSEndpoint>(_instance, delEndp, _resource);
+        return std::make_shared<WSEndpoint>(_instance, delEndp, _resource, _deflate);
     }
 }
 
+int
+IceInternal::WSEndpoint::deflate() const
+{
+    return _deflate;
+}
+
 vector<EndpointIPtr>
 IceInternal::WSEndpoint::expandIfWildcard() const
 {
@@ -300,7 +310,7 @@ IceInternal::WSEndpoint::expandIfWildcard() const
         }
         else
         {
-            *p = std::make_shared<WSEndpoint>(_instance, *p, _resource);
+            *p = std::make_shared<WSEndpoint>(_instance, *p, _resource, _deflate);
         }
     }
     return endps;
@@ -316,7 +326,7 @@ IceInternal::WSEndpoint::expandHost(EndpointIPtr& publish) const
     }
     else if(publish.get())
     {
-        publish = std::make_shared<WSEndpoint>(_instance, publish, _resource);
+        publish = std::make_shared<WSEndpoint>(_instance, publish, _resource, _deflate);
     }
     for(vector<EndpointIPtr>::iterator p = endps.begin(); p != endps.end(); ++p)
     {
@@ -326,7 +336,7 @@ IceInternal::WSEndpoint::expandHost(EndpointIPtr& publish) const
         }
         else
         {
-            *p = std::make_shared<WSEndpoint>(_instance, *p, _resource);
+            *p = std::make_shared<WSEndpoint>(_instance, *p, _resource, _deflate);
         }
     }
     return endps;
@@ -348,6 +358,7 @@ IceInternal::WSEndpoint::hash() const
 {
     int h = _delegate->hash();
     hashAdd(h, _resource);
+    hashAdd(h, _deflate);
     return h;
 }
 
@@ -379,6 +390,15 @@ IceInternal::WSEndpoint::options() const
         }
     }
 
+    if(_deflate > 0)
+    {
+        s << " --deflate";
+        if(_deflate != WSDeflate::defaultWindowBits)
+        {
+            s << " " << _deflate;
+        }
+    }
+
     return s.str();
 }
 
@@ -406,6 +426,11 @@ IceInternal::WSEndpoint::operator==(const Endpoint& r) const
         return false;
     }
 
+    if(_deflate != p->_deflate)
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -446,12 +471,47 @@ IceInternal::WSEndpoint::operator<(const Endpoint& r) const
         return false;
     }
 
+    if(_deflate < p->_deflate)
+    {
+        return true;
+    }
+    else if (p->_deflate < _deflate)
+    {
+        return false;
+    }
+
     return false;
 }
 
 bool
 IceInternal::WSEndpoint::checkOption(const string& option, const string& argument, const string& endpoint)
 {
+    if(option == "--deflate")
+    {
+        if(!WSDeflate::supported())
+        {
+            throw EndpointParseException(__FILE__, __LINE__, "--deflate option not supported in endpoint " +
+                                         endpoint + _delegate->options() + ", Ice was built without zlib");
+        }
+
+        int windowBits = WSDeflate::defaultWindowBits;
+        if(!argument.empty())
+        {
+            istringstream p(argument);
+            if(!(p >> windowBits) || !p.eof() || windowBits < WSDeflate::minWindowBits ||
+               windowBits > WSDeflate::maxWindowBits)
+            {
+                ostringstream os;
+                os << "invalid window bits value `" << argument << "' for --deflate option in endpoint " << endpoint
+                   << _delegate->options() << ", expected a value between " << WSDeflate::minWindowBits << " and "
+                   << WSDeflate::maxWindowBits;
+                throw EndpointParseException(__FILE__, __LINE__, os.str());
+            }
+        }
+        const_cast<int&>(_deflate) = windowBits;
+        return true;
+    }
+
     switch(option[1])
     {
     case 'r':
@@ -20,7 +20,7 @@ class WSEndpoint : public EndpointI
 {
 public:
 
-    WSEndpoint(const ProtocolInstancePtr&, const EndpointIPtr&, const std::string&);
+    WSEndpoint(const ProtocolInstancePtr&, const EndpointIPtr&, const std::string&, int);
     WSEndpoint(const ProtocolInstancePtr&, const EndpointIPtr&, std::vector<std::string>&);
     WSEndpoint(const ProtocolInstancePtr&, const EndpointIPtr&, Ice::InputStream*);
 
@@ -49,6 +49,7 @@ public:
     virtual std::string options() const;
 
     WSEndpointPtr endpoint(const EndpointIPtr&) const;
+    int deflate() const;
 
     virtual bool operator==(const Ice::Endpoint&) const;
     virtual bool operator<(const Ice::Endpoint&) const;
@@ -65,6 +66,13 @@ private:
     const ProtocolInstancePtr _instance;
     const EndpointIPtr _delegate;
     const std::string _resource;
+
+    //
+    // The window bits for the permessage-deflate extension, 0 if the
+    // extension is disabled. This is a local option: it isn't marshaled
+    // with the endpoint.
+    //
+    const int _deflate;
 };
 
 class ICE_API WSEndpointFactory : public EndpointFactoryWithUnderlying
@@ -7,6 +7,8 @@
 #include <Ice/Connection.h>
 #include <Ice/ProtocolInstance.h>
 #include <Ice/HttpParser.h>
+#include <Ice/WSDeflate.h>
+#include <Ice/InstrumentationI.h>
 #include <Ice/Communicator.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Buffer.h>
@@ -20,6 +22,15 @@
 #include <stdint.h>
 #include <climits>
 
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define ICE_WS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   include <arm_neon.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -44,6 +55,7 @@ using namespace IceInternal;
 #define OP_RES_0xE  0xE     // Reserved
 #define OP_RES_0xF  0xF     // Reserved
 #define FLAG_FINAL  0x80    // Last frame
+#define FLAG_COMPRESSED 0x40 // Compressed message (RSV1, permessage-deflate)
 #define FLAG_MASKED 0x80    // Payload is masked
 
 #define CLOSURE_NORMAL         1000
@@ -125,6 +137,67 @@ Long ice_nlltoh(const Byte* src)
 
 }
 
+//
+// XOR n bytes from src with the 32-bit WebSocket masking key and store the
+// result in dst (src and dst can be the same). The offset is the position
+// of src[0] in the frame payload, the key is rotated accordingly. Blocks of
+// 32, 16 or 8 bytes are masked at once depending on the instruction set the
+// code is compiled for, the remaining bytes one by one.
+//
+void
+IceInternal::applyMask(Byte* dst, const Byte* src, size_t n, const unsigned char* mask, size_t offset)
+{
+    Byte key[32];
+    for(size_t i = 0; i < sizeof(key); ++i)
+    {
+        key[i] = mask[(offset + i) % 4];
+    }
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i k256 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key));
+    for(; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(v, k256));
+    }
+    const __m128i k128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    for(; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, k128));
+    }
+#elif defined(ICE_WS_SSE2)
+    const __m128i k128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    for(; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, k128));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const uint8x16_t k128 = vld1q_u8(key);
+    for(; i + 16 <= n; i += 16)
+    {
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), k128));
+    }
+#endif
+
+    uint64_t k64;
+    memcpy(&k64, key, sizeof(k64));
+    for(; i + 8 <= n; i += 8)
+    {
+        uint64_t v;
+        memcpy(&v, src + i, sizeof(v));
+        v ^= k64;
+        memcpy(dst + i, &v, sizeof(v));
+    }
+
+    for(; i < n; ++i)
+    {
+        dst[i] = src[i] ^ key[i % 4];
+    }
+}
+
 NativeInfoPtr
 IceInternal::WSTransceiver::getNativeInfo()
 {
@@ -181,8 +254,15 @@ IceInternal::WSTransceiver::initialize(Buffer& readBuffer, Buffer& writeBuffer)
                     << "Upgrade: websocket\r\n"
                     << "Connection: Upgrade\r\n"
                     << "Sec-WebSocket-Protocol: " << _iceProtocol << "\r\n"
-                    << "Sec-WebSocket-Version: 13\r\n"
-                    << "Sec-WebSocket-Key: ";
+                    << "Sec-WebSocket-Version: 13\r\n";
+
+                if(_deflateWindowBits > 0)
+                {
+                    _deflate = new WSDeflate(false, _deflateWindowBits, _instance->messageSizeMax());
+                    out << "Sec-WebSocket-Extensions: " << _deflate->offer() << "\r\n";
+                }
+
+                out << "Sec-WebSocket-Key: ";
 
                 //
                 // The value for Sec-WebSocket-Key is a 16-byte random number,
@@ -246,14 +326,15 @@ IceInternal::WSTransceiver::initialize(Buffer& readBuffer, Buffer& writeBuffer)
                     }
 
                     //
-                    // Enlarge the buffer and try to read more.
+                    // Enlarge the buffer and try to read more. The buffer size is doubled
+                    // to limit the number of reads and parser scans for large requests.
                     //
                     const size_t oldSize = static_cast<size_t>(_readBuffer.i - _readBuffer.b.begin());
                     if(oldSize + 1024 > _instance->messageSizeMax())
                     {
                         throw MemoryLimitException(__FILE__, __LINE__);
                     }
-                    _readBuffer.b.resize(oldSize + 1024);
+                    _readBuffer.b.resize(min(oldSize * 2, _instance->messageSizeMax()));
                     _readBuffer.i = _readBuffer.b.begin() + oldSize;
                     continue; // Try again to read the response/request
                 }
@@ -421,6 +502,16 @@ IceInternal::WSTransceiver::closing(bool initiator, const Ice::LocalException& r
 void
 IceInternal::WSTransceiver::close()
 {
+    if(_deflate)
+    {
+        if(_state >= StateOpened && _instance->traceLevel() >= 2)
+        {
+            Trace out(_instance->logger(), _instance->traceCategory());
+            out << _deflate->stats() << "\n" << toString();
+        }
+        _deflate->setObserver(nullptr);
+    }
+
     _delegate->close();
     _state = StateClosed;
 
@@ -430,6 +521,7 @@ IceInternal::WSTransceiver::close()
     if(!_writePending)
     {
         _writeBuffer.b.clear();
+        _deflateBuffer.b.clear();
     }
     if(!_readPending)
     {
@@ -471,7 +563,7 @@ IceInternal::WSTransceiver::write(Buffer& buf)
             }
             else if(_incoming && !buf.b.empty() && _writeState == WriteStatePayload)
             {
-                SocketOperation s = _delegate->write(buf);
+                SocketOperation s = _delegate->write(_writeCompressed ? _deflateBuffer : buf);
                 if(s)
                 {
                     return s;
@@ -521,7 +613,7 @@ IceInternal::WSTransceiver::read(Buffer& buf)
     //
     if(buf.i == buf.b.end())
     {
-        if(_readI < _readBuffer.i)
+        if(_readI < _readBuffer.i || _inflatedPos < _inflated.size())
         {
             _delegate->getNativeInfo()->ready(SocketOperationRead, true);
         }
@@ -569,7 +661,7 @@ IceInternal::WSTransceiver::read(Buffer& buf)
 
     if(buf.i == buf.b.end())
     {
-        if(_readI < _readBuffer.i)
+        if(_readI < _readBuffer.i || _inflatedPos < _inflated.size())
         {
             _delegate->getNativeInfo()->ready(SocketOperationRead, true);
         }
@@ -616,14 +708,15 @@ IceInternal::WSTransceiver::startWrite(Buffer& buf)
         {
             if(_delegate->startWrite(_writeBuffer))
             {
-                return buf.b.size() == _writePayloadLength; // Return true only if we've written the whole buffer.
+                // Return true only if we've written the whole buffer.
+                return (_writeCompressed ? _deflateBuffer : buf).b.size() == _writePayloadLength;
             }
             return false;
         }
         else
         {
             assert(_incoming);
-            return _delegate->startWrite(buf);
+            return _delegate->startWrite(_writeCompressed ? _deflateBuffer : buf);
         }
     }
     else
@@ -658,7 +751,7 @@ IceInternal::WSTransceiver::finishWrite(Buffer& buf)
     else if(!buf.b.empty() && buf.i != buf.b.end())
     {
         assert(_incoming);
-        _delegate->finishWrite(buf);
+        _delegate->finishWrite(_writeCompressed ? _deflateBuffer : buf);
     }
 
     if(_state == StateClosed)
@@ -800,7 +893,7 @@ IceInternal::WSTransceiver::setBufferSize(int rcvSize, int sndSize)
 }
 
 IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, const TransceiverPtr& del,
-                                          const string& host, const string& resource) :
+                                          const string& host, const string& resource, int deflate) :
     _instance(instance),
     _delegate(del),
     _host(host),
@@ -808,14 +901,19 @@ IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, c
     _incoming(false),
     _state(StateInitializeDelegate),
     _parser(new HttpParser),
+    _deflateWindowBits(deflate),
     _readState(ReadStateOpcode),
     _readBufferSize(1024),
     _readLastFrame(true),
     _readOpCode(0),
     _readHeaderLength(0),
     _readPayloadLength(0),
+    _readCompressed(false),
+    _readMaskOffset(0),
+    _inflatedPos(0),
     _writeState(WriteStateHeader),
     _writeBufferSize(16 * 1024),
+    _writeCompressed(false),
     _readPending(false),
     _writePending(false),
     _closingInitiator(false),
@@ -830,20 +928,25 @@ IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, c
     //
 }
 
-IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, const TransceiverPtr& del) :
+IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, const TransceiverPtr& del, int deflate) :
     _instance(instance),
     _delegate(del),
     _incoming(true),
     _state(StateInitializeDelegate),
     _parser(new HttpParser),
+    _deflateWindowBits(deflate),
     _readState(ReadStateOpcode),
     _readBufferSize(1024),
     _readLastFrame(true),
     _readOpCode(0),
     _readHeaderLength(0),
     _readPayloadLength(0),
+    _readCompressed(false),
+    _readMaskOffset(0),
+    _inflatedPos(0),
     _writeState(WriteStateHeader),
     _writeBufferSize(1024),
+    _writeCompressed(false),
     _readPending(false),
     _writePending(false),
     _closingInitiator(false),
@@ -948,6 +1051,21 @@ IceInternal::WSTransceiver::handleRequest(Buffer& responseBuffer)
         throw WebSocketException("invalid value `" + key + "' for WebSocket key");
     }
 
+    //
+    // Accept the first permessage-deflate offer we support if the extension
+    // is enabled for the endpoint, other extensions are ignored.
+    //
+    string extensions;
+    if(_deflateWindowBits > 0 && _parser->getHeader("Sec-WebSocket-Extensions", val, false))
+    {
+        WSDeflatePtr deflate = new WSDeflate(true, _deflateWindowBits, _instance->messageSizeMax());
+        if(deflate->negotiate(val, extensions))
+        {
+            _deflate = deflate;
+            initDeflateObserver();
+        }
+    }
+
     //
     // Retain the target resource.
     //
@@ -964,6 +1082,10 @@ IceInternal::WSTransceiver::handleRequest(Buffer& responseBuffer)
     {
         out << "Sec-WebSocket-Protocol: " << _iceProtocol << "\r\n";
     }
+    if(_deflate)
+    {
+        out << "Sec-WebSocket-Extensions: " << extensions << "\r\n";
+    }
 
     //
     // The response includes:
@@ -1081,6 +1203,37 @@ IceInternal::WSTransceiver::handleResponse()
     {
         throw WebSocketException("invalid value `" + val + "' for Sec-WebSocket-Accept");
     }
+
+    //
+    // "If the response includes a |Sec-WebSocket-Extensions| header
+    //  field and this header field indicates the use of an extension
+    //  that was not present in the client's handshake (the server has
+    //  indicated an extension not requested by the client), the client
+    //  MUST _Fail the WebSocket Connection_."
+    //
+    if(_parser->getHeader("Sec-WebSocket-Extensions", val, false))
+    {
+        if(!_deflate)
+        {
+            throw WebSocketException("invalid value `" + val + "' for Sec-WebSocket-Extensions");
+        }
+        _deflate->accept(val);
+        initDeflateObserver();
+    }
+    else
+    {
+        _deflate = 0; // The server declined the extension.
+    }
+}
+
+void
+IceInternal::WSTransceiver::initDeflateObserver()
+{
+    CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI, _instance->observer());
+    if(observer)
+    {
+        _deflate->setObserver(observer->getWebSocketDeflateObserver(getInfo()));
+    }
 }
 
 bool
@@ -1088,6 +1241,31 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
 {
     while(true)
     {
+        if(_inflatedPos < _inflated.size())
+        {
+            //
+            // Copy the decompressed data to the message buffer, we don't
+            // read more data until it's all consumed.
+            //
+            size_t n = min(_inflated.size() - _inflatedPos, static_cast<size_t>(buf.b.end() - buf.i));
+            if(n > 0)
+            {
+                memcpy(buf.i, &_inflated[_inflatedPos], n);
+                buf.i += n;
+                _inflatedPos += n;
+            }
+            if(_inflatedPos == _inflated.size())
+            {
+                _inflated.clear();
+                _inflatedPos = 0;
+            }
+            if(buf.i == buf.b.end())
+            {
+                _readStart = _readBuffer.i;
+                return false;
+            }
+        }
+
         if(_readState == ReadStateOpcode)
         {
             //
@@ -1118,6 +1296,16 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                     throw ProtocolException(__FILE__, __LINE__, "invalid data frame, no FIN on previous frame");
                 }
                 _readLastFrame = (ch & FLAG_FINAL) == FLAG_FINAL;
+
+                //
+                // The RSV1 bit of the first frame of a message indicates a
+                // compressed message if permessage-deflate is negotiated.
+                //
+                _readCompressed = (ch & FLAG_COMPRESSED) == FLAG_COMPRESSED;
+                if(_readCompressed && !_deflate)
+                {
+                    throw ProtocolException(__FILE__, __LINE__, "invalid data frame, RSV1 set");
+                }
             }
             else if(_readOpCode == OP_CONT)
             {
@@ -1125,6 +1313,10 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                 {
                     throw ProtocolException(__FILE__, __LINE__, "invalid continuation frame, previous frame FIN set");
                 }
+                if((ch & FLAG_COMPRESSED) == FLAG_COMPRESSED)
+                {
+                    throw ProtocolException(__FILE__, __LINE__, "invalid continuation frame, RSV1 set");
+                }
                 _readLastFrame = (ch & FLAG_FINAL) == FLAG_FINAL;
             }
 
@@ -1228,6 +1420,12 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                 {
                     throw ProtocolException(__FILE__, __LINE__, "payload length is 0");
                 }
+                if(_readCompressed)
+                {
+                    _readState = ReadStateCompressedPayload;
+                    _readMaskOffset = 0;
+                    break;
+                }
                 _readState = ReadStatePayload;
                 assert(buf.i != buf.b.end());
                 _readFrameStart = buf.i;
@@ -1333,6 +1531,39 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
             _readState = ReadStateOpcode;
         }
 
+        if(_readState == ReadStateCompressedPayload)
+        {
+            if(_readI == _readBuffer.i)
+            {
+                //
+                // Read the compressed payload in the internal buffer, up to
+                // 64KB at a time.
+                //
+                _readBuffer.b.resize(max(_readBufferSize, min(_readPayloadLength, static_cast<size_t>(64 * 1024))));
+                _readI = _readBuffer.i = _readBuffer.b.begin();
+                _readStart = _readBuffer.i;
+                return true;
+            }
+
+            size_t n = min(static_cast<size_t>(_readBuffer.i - _readI), _readPayloadLength);
+            if(_incoming)
+            {
+                applyMask(_readI, _readI, n, _readMask, _readMaskOffset);
+                _readMaskOffset += n;
+            }
+            _readPayloadLength -= n;
+            _deflate->decompress(_readI, n, _readPayloadLength == 0 && _readLastFrame, _inflated);
+            _readI += n;
+            if(_readPayloadLength == 0)
+            {
+                //
+                // We've read the complete payload, we're ready to read a new frame.
+                //
+                _readState = ReadStateOpcode;
+            }
+            continue;
+        }
+
         if(_readState == ReadStatePayload)
         {
             //
@@ -1386,11 +1617,8 @@ IceInternal::WSTransceiver::postRead(Buffer& buf)
         //
         // Unmask the data we just read.
         //
-        IceInternal::Buffer::Container::iterator p = _readStart;
-        for(size_t n = static_cast<size_t>(_readStart - _readFrameStart); p < buf.i; ++p, ++n)
-        {
-            *p ^= _readMask[n % 4];
-        }
+        applyMask(_readStart, _readStart, static_cast<size_t>(buf.i - _readStart), _readMask,
+                  static_cast<size_t>(_readStart - _readFrameStart));
     }
 
     _readPayloadLength -= static_cast<size_t>(buf.i - _readStart);
@@ -1418,7 +1646,22 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
             }
 
             assert(buf.i == buf.b.begin());
-            prepareWriteHeader(OP_DATA, buf.b.size());
+
+            //
+            // With permessage-deflate, the message is compressed in the
+            // deflate buffer which is sent instead of the message buffer.
+            //
+            _writeCompressed = _deflate && _deflate->compress(&buf.b[0], buf.b.size(), _deflateBuffer.b);
+            if(_writeCompressed)
+            {
+                _deflateBuffer.i = _deflateBuffer.b.begin();
+                prepareWriteHeader(OP_DATA, _deflateBuffer.b.size());
+                _writeBuffer.b[0] |= FLAG_COMPRESSED;
+            }
+            else
+            {
+                prepareWriteHeader(OP_DATA, buf.b.size());
+            }
 
             _writeState = WriteStatePayload;
         }
@@ -1479,6 +1722,8 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
 
     if(_writeState == WriteStatePayload)
     {
+        Buffer& payload = _writeCompressed ? _deflateBuffer : buf;
+
         //
         // For an outgoing connection, each message must be masked with a random
         // 32-bit value, so we copy the entire message into the internal buffer
@@ -1495,12 +1740,11 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
                 _writeBuffer.i = _writeBuffer.b.begin();
             }
 
-            size_t n = static_cast<size_t>(buf.i - buf.b.begin());
-            for(; n < buf.b.size() && _writeBuffer.i < _writeBuffer.b.end(); ++_writeBuffer.i, ++n)
-            {
-                *_writeBuffer.i = buf.b[n] ^ _writeMask[n % 4];
-            }
-            _writePayloadLength = n;
+            size_t n = static_cast<size_t>(payload.i - payload.b.begin());
+            size_t sz = min(payload.b.size() - n, static_cast<size_t>(_writeBuffer.b.end() - _writeBuffer.i));
+            applyMask(_writeBuffer.i, &payload.b[0] + n, sz, _writeMask, n);
+            _writeBuffer.i += sz;
+            _writePayloadLength = n + sz;
             if(_writeBuffer.i < _writeBuffer.b.end())
             {
                 _writeBuffer.b.resize(static_cast<size_t>(_writeBuffer.i - _writeBuffer.b.begin()));
@@ -1510,10 +1754,10 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
         else if(_writePayloadLength == 0)
         {
             size_t n = min(static_cast<size_t>(_writeBuffer.b.end() - _writeBuffer.i),
-                           static_cast<size_t>(buf.b.end() - buf.i));
-            memcpy(_writeBuffer.i, buf.i, n);
+                           static_cast<size_t>(payload.b.end() - payload.i));
+            memcpy(_writeBuffer.i, payload.i, n);
             _writeBuffer.i += n;
-            buf.i += n;
+            payload.i += n;
             _writePayloadLength = n;
             if(_writeBuffer.i < _writeBuffer.b.end())
             {
@@ -1587,14 +1831,24 @@ IceInternal::WSTransceiver::postWrite(Buffer& buf)
         }
     }
 
-    if((!_incoming || buf.i == buf.b.begin()) && _writePayloadLength > 0)
+    Buffer& payload = _writeCompressed ? _deflateBuffer : buf;
+    if((!_incoming || payload.i == payload.b.begin()) && _writePayloadLength > 0)
     {
         if(_writeBuffer.i == _writeBuffer.b.end())
         {
-            buf.i = buf.b.begin() + _writePayloadLength;
+            payload.i = payload.b.begin() + _writePayloadLength;
         }
     }
 
+    if(_writeCompressed && _deflateBuffer.i == _deflateBuffer.b.end())
+    {
+        //
+        // The compressed message is sent.
+        //
+        buf.i = buf.b.end();
+        _writeCompressed = false;
+    }
+
     if(buf.b.empty() || buf.i == buf.b.end())
     {
         _writeState = WriteStateHeader;
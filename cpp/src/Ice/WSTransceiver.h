@@ -7,6 +7,7 @@
 
 #include <Ice/ProtocolInstance.h>
 #include <Ice/HttpParser.h>
+#include <Ice/WSDeflate.h>
 
 #include <Ice/LoggerF.h>
 #include <Ice/Transceiver.h>
@@ -19,6 +20,12 @@ namespace IceInternal
 class ConnectorI;
 class AcceptorI;
 
+//
+// XOR n bytes from src with the WebSocket masking key and store the result
+// in dst. The offset is the position of src[0] in the frame payload.
+//
+ICE_API void applyMask(Ice::Byte*, const Ice::Byte*, size_t, const unsigned char*, size_t);
+
 class WSTransceiver : public Transceiver
 {
 public:
@@ -48,8 +55,8 @@ public:
 
 private:
 
-    WSTransceiver(const ProtocolInstancePtr&, const TransceiverPtr&, const std::string&, const std::string&);
-    WSTransceiver(const ProtocolInstancePtr&, const TransceiverPtr&);
+    WSTransceiver(const ProtocolInstancePtr&, const TransceiverPtr&, const std::string&, const std::string&, int);
+    WSTransceiver(const ProtocolInstancePtr&, const TransceiverPtr&, int);
     virtual ~WSTransceiver();
 
     void handleRequest(Buffer&);
@@ -62,6 +69,7 @@ private:
     bool postWrite(Buffer&);
 
     bool readBuffered(Buffer::Container::size_type);
+    void initDeflateObserver();
     void prepareWriteHeader(Ice::Byte, Buffer::Container::size_type);
 
     friend class WSConnector;
@@ -93,12 +101,20 @@ private:
     HttpParserPtr _parser;
     std::string _key;
 
+    //
+    // The window bits of the permessage-deflate extension (0 if disabled)
+    // and the compression state, only set once the extension is negotiated.
+    //
+    const int _deflateWindowBits;
+    WSDeflatePtr _deflate;
+
     enum ReadState
     {
         ReadStateOpcode,
         ReadStateHeader,
         ReadStateControlFrame,
         ReadStatePayload,
+        ReadStateCompressedPayload,
     };
 
     ReadState _readState;
@@ -113,6 +129,10 @@ private:
     Buffer::Container::iterator _readStart;
     Buffer::Container::iterator _readFrameStart;
     unsigned char _readMask[4];
+    bool _readCompressed;
+    size_t _readMaskOffset;
+    std::vector<Ice::Byte> _inflated;
+    size_t _inflatedPos;
 
     enum WriteState
     {
@@ -126,6 +146,8 @@ private:
     const Buffer::Container::size_type _writeBufferSize;
     unsigned char _writeMask[4];
     size_t _writePayloadLength;
+    bool _writeCompressed;
+    Buffer _deflateBuffer;
 
     bool _readPending;
     bool _writePending;
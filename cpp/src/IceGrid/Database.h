@@ -20,6 +20,8 @@
 
 #include <IceDB/IceDB.h>
 
+#include <set>
+
 namespace IceGrid
 {
 
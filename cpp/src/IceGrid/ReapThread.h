@@ -11,6 +11,7 @@
 #include <Ice/Connection.h>
 
 #include <list>
+#include <set>
 
 namespace IceGrid
 {
@@ -15,6 +15,7 @@
 #include <Ice/Logger.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Properties.h>
+#include <Ice/InstrumentationI.h>
 
 #include <IceUtil/StringUtil.h>
 #include <IceUtil/Mutex.h>
@@ -37,6 +38,57 @@ using namespace IceSSL;
 namespace
 {
 
+//
+// The helper for the SSLSession metrics map, the map provides by default
+// a metrics object for the hits and one for the misses of the client
+// session cache.
+//
+class SessionHelper : public IceMX::MetricsHelperT<IceMX::Metrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<SessionHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &SessionHelper::getParent);
+            add("id", &SessionHelper::getId);
+            add("server", &SessionHelper::_server);
+        }
+    };
+    static Attributes attributes;
+
+    SessionHelper(const string& server, bool resumed) : MetricsHelperT(attributes), _server(server), _resumed(resumed)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+    string
+    getId() const
+    {
+        return _resumed ? "hit" : "miss";
+    }
+
+private:
+
+    const string _server;
+    const bool _resumed;
+};
+
+SessionHelper::Attributes SessionHelper::attributes;
+
 IceUtil::Mutex* staticMutex = 0;
 int instanceCount = 0;
 bool initOpenSSL = false;
@@ -122,6 +174,17 @@ IceSSL_opensslPasswordCallback(char* buf, int size, int flag, void* userData)
     return sz;
 }
 
+//
+// OpenSSL new session callback, called once the handshake completes or when
+// a TLS 1.3 session ticket is received.
+//
+int
+IceSSL_opensslNewSessionCallback(SSL* ssl, SSL_SESSION* session)
+{
+    OpenSSL::TransceiverI* p = reinterpret_cast<OpenSSL::TransceiverI*>(SSL_get_ex_data(ssl, 0));
+    return p ? p->newSession(session) : 0;
+}
+
 #ifndef OPENSSL_NO_DH
 DH*
 IceSSL_opensslDHCallback(SSL* ssl, int /*isExport*/, int keyLength)
@@ -198,7 +261,11 @@ OpenSSL::upCast(OpenSSL::SSLEngine* p)
 
 OpenSSL::SSLEngine::SSLEngine(const CommunicatorPtr& communicator) :
     IceSSL::SSLEngine(communicator),
-    _ctx(0)
+    _ctx(0),
+    _ktls(false),
+    _sessionCacheSize(0),
+    _sessionHits(0),
+    _sessionMisses(0)
 {
     //
     // Initialize OpenSSL if necessary.
@@ -392,6 +459,35 @@ OpenSSL::SSLEngine::initialize()
         const string propPrefix = "IceSSL.";
         PropertiesPtr properties = communicator()->getProperties();
 
+        //
+        // KTLS enables kernel TLS offload for the connections using a socket, this requires
+        // Linux and an OpenSSL 3 library built with kTLS support.
+        //
+        _ktls = properties->getPropertyAsInt(propPrefix + "KTLS") > 0;
+#ifndef ICE_HAS_KTLS
+        if(_ktls && securityTraceLevel() >= 1)
+        {
+            getLogger()->trace(securityTraceCategory(), "IceSSL: kernel TLS isn't supported by this OpenSSL version");
+        }
+        _ktls = false;
+#endif
+
+        //
+        // SessionCacheSize is the number of client sessions kept for resumption, one per
+        // server host and address. Servers resume sessions with stateless session tickets.
+        //
+        _sessionCacheSize = static_cast<size_t>(max(0, properties->getPropertyAsInt(propPrefix + "SessionCacheSize")));
+        if(_sessionCacheSize > 0)
+        {
+            IceInternal::CommunicatorObserverIPtr observer =
+                ICE_DYNAMIC_CAST(IceInternal::CommunicatorObserverI, communicator()->getObserver());
+            if(observer)
+            {
+                _sessionObservers.reset(new IceMX::ObserverFactoryT<IceMX::ObserverI>(observer->getFacet(),
+                                                                                       "SSLSession"));
+            }
+        }
+
         //
         // Protocols selects which protocols to enable, by default we only enable TLS1.0
         // TLS1.1 and TLS1.2 to avoid security issues with SSLv3
@@ -832,17 +928,31 @@ OpenSSL::SSLEngine::initialize()
         //
         SSL_CTX_set_ex_data(_ctx, 0, this);
 
-        //
-        // This is necessary for successful interop with Java. Without it, a Java
-        // client would fail to reestablish a connection: the server gets the
-        // error "session id context uninitialized" and the client receives
-        // "SSLHandshakeException: Remote host closed connection during handshake".
-        //
-        SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_OFF);
+        if(_sessionCacheSize > 0)
+        {
+            //
+            // Client sessions are stored in our own cache from the new session
+            // callback. The server doesn't keep sessions: resumption relies on
+            // the stateless session tickets, which are encrypted with a key
+            // private to this context.
+            //
+            SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_sess_set_new_cb(_ctx, IceSSL_opensslNewSessionCallback);
+        }
+        else
+        {
+            //
+            // This is necessary for successful interop with Java. Without it, a Java
+            // client would fail to reestablish a connection: the server gets the
+            // error "session id context uninitialized" and the client receives
+            // "SSLHandshakeException: Remote host closed connection during handshake".
+            //
+            SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_OFF);
+        }
 
         //
-        // Although we disable session caching, we still need to set a session ID
-        // context (ICE-5103). The value can be anything; here we just use the
+        // We still need to set a session ID context (ICE-5103), even if session
+        // caching is disabled. The value can be anything; here we just use the
         // pointer to this SharedInstance object.
         //
         SSL_CTX_set_session_id_context(_ctx, reinterpret_cast<unsigned char*>(this),
@@ -925,9 +1035,149 @@ OpenSSL::SSLEngine::sslErrors() const
     return getSslErrors(securityTraceLevel() >= 1);
 }
 
+bool
+OpenSSL::SSLEngine::ktls() const
+{
+    return _ktls;
+}
+
+size_t
+OpenSSL::SSLEngine::sessionCacheSize() const
+{
+    return _sessionCacheSize;
+}
+
+bool
+OpenSSL::SSLEngine::setSession(SSL* ssl, const string& key)
+{
+    IceUtil::Mutex::Lock sync(_sessionMutex);
+    if(_sessionCacheSize == 0)
+    {
+        return false;
+    }
+
+    map<string, SessionList::iterator>::iterator p = _sessionMap.find(key);
+    if(p == _sessionMap.end())
+    {
+        return false;
+    }
+
+    SSL_SESSION* session = p->second->second;
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
+    if(!SSL_SESSION_is_resumable(session))
+    {
+        SSL_SESSION_free(session);
+        _sessions.erase(p->second);
+        _sessionMap.erase(p);
+        return false;
+    }
+#endif
+
+    //
+    // SSL_set_session takes its own reference on the session.
+    //
+    SSL_set_session(ssl, session);
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
+    //
+    // TLS 1.3 tickets are single-use (RFC 8446, appendix C.4), the session is
+    // removed from the cache once offered. The connection stores the tickets
+    // sent by the server after the handshake.
+    //
+    if(SSL_SESSION_get_protocol_version(session) == TLS1_3_VERSION)
+    {
+        SSL_SESSION_free(session);
+        _sessions.erase(p->second);
+        _sessionMap.erase(p);
+    }
+#endif
+    return true;
+}
+
+bool
+OpenSSL::SSLEngine::addSession(const string& key, SSL_SESSION* session)
+{
+    IceUtil::Mutex::Lock sync(_sessionMutex);
+    if(_sessionCacheSize == 0)
+    {
+        return false;
+    }
+
+    map<string, SessionList::iterator>::iterator p = _sessionMap.find(key);
+    if(p != _sessionMap.end())
+    {
+        SSL_SESSION_free(p->second->second);
+        _sessions.erase(p->second);
+        _sessionMap.erase(p);
+    }
+
+    _sessions.push_front(make_pair(key, session));
+    _sessionMap.insert(make_pair(key, _sessions.begin()));
+
+    if(_sessions.size() > _sessionCacheSize)
+    {
+        SSL_SESSION_free(_sessions.back().second);
+        _sessionMap.erase(_sessions.back().first);
+        _sessions.pop_back();
+    }
+    return true;
+}
+
+void
+OpenSSL::SSLEngine::sessionResumed(const string& server, bool resumed)
+{
+    {
+        IceUtil::Mutex::Lock sync(_sessionMutex);
+        if(resumed)
+        {
+            ++_sessionHits;
+        }
+        else
+        {
+            ++_sessionMisses;
+        }
+    }
+
+    if(_sessionObservers && _sessionObservers->isEnabled())
+    {
+        try
+        {
+            shared_ptr<IceMX::ObserverI> observer = _sessionObservers->getObserver(SessionHelper(server, resumed));
+            if(observer)
+            {
+                observer->attach();
+                observer->detach();
+            }
+        }
+        catch(const exception& ex)
+        {
+            Error error(getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+}
+
 void
 OpenSSL::SSLEngine::destroy()
 {
+    {
+        IceUtil::Mutex::Lock sync(_sessionMutex);
+        if(_sessionCacheSize > 0 && securityTraceLevel() >= 1)
+        {
+            ostringstream os;
+            os << "session cache: " << _sessionHits << " hits, " << _sessionMisses << " misses, "
+               << _sessions.size() << " cached sessions";
+            getLogger()->trace(securityTraceCategory(), os.str());
+        }
+        for(SessionList::const_iterator p = _sessions.begin(); p != _sessions.end(); ++p)
+        {
+            SSL_SESSION_free(p->second);
+        }
+        _sessions.clear();
+        _sessionMap.clear();
+    }
+    _sessionObservers.reset(); // Unregisters the SSLSession metrics map.
+
     if(_ctx)
     {
         SSL_CTX_free(_ctx);
@@ -11,6 +11,19 @@
 
 #include <Ice/BuiltinSequences.h>
 
+#include <list>
+#include <map>
+#include <memory>
+
+namespace IceMX
+{
+
+class Metrics;
+template<typename> class ObserverT;
+template<typename> class ObserverFactoryT;
+
+}
+
 namespace IceSSL
 {
 
@@ -36,6 +49,12 @@ public:
     SSL_CTX* context() const;
     void context(SSL_CTX*);
     std::string sslErrors() const;
+    bool ktls() const;
+
+    size_t sessionCacheSize() const;
+    bool setSession(SSL*, const std::string&);
+    bool addSession(const std::string&, SSL_SESSION*);
+    void sessionResumed(const std::string&, bool);
 
 private:
 
@@ -46,6 +65,20 @@ private:
     int parseProtocols(const Ice::StringSeq&) const;
 
     SSL_CTX* _ctx;
+    bool _ktls;
+
+    //
+    // The client session cache, keyed by server host and address. The most
+    // recently added sessions are first in the list.
+    //
+    typedef std::list<std::pair<std::string, SSL_SESSION*> > SessionList;
+    IceUtil::Mutex _sessionMutex;
+    size_t _sessionCacheSize;
+    SessionList _sessions;
+    std::map<std::string, SessionList::iterator> _sessionMap;
+    Ice::Long _sessionHits;
+    Ice::Long _sessionMisses;
+    std::unique_ptr<IceMX::ObserverFactoryT<IceMX::ObserverT<IceMX::Metrics> > > _sessionObservers;
 
 #ifndef OPENSSL_NO_DH
     IceSSL::OpenSSL::DHParamsPtr _dhParams;
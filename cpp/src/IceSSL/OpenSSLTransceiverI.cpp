@@ -140,11 +140,33 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
         }
         SSL_set_bio(_ssl, bio, bio);
 
+#ifdef ICE_HAS_KTLS
+        //
+        // With kernel TLS the record encryption is done by the kernel once the
+        // handshake completes, this only works with a socket BIO.
+        //
+        if(_engine->ktls() && !_memBio)
+        {
+            SSL_set_options(_ssl, SSL_OP_ENABLE_KTLS);
+        }
+#endif
+
         //
         // Store a pointer to ourself for use in OpenSSL callbacks.
         //
         SSL_set_ex_data(_ssl, 0, this);
 
+        //
+        // Offer the last session established with this server for resumption.
+        //
+        IceInternal::Address remoteAddr;
+        if(!_incoming && _engine->sessionCacheSize() > 0 && fd != INVALID_SOCKET &&
+           IceInternal::fdToRemoteAddress(fd, remoteAddr))
+        {
+            _sessionKey = _host + "/" + IceInternal::addrToString(remoteAddr);
+            _sessionOffered = _engine->setSession(_ssl, _sessionKey);
+        }
+
         //
         // Determine whether a certificate is required from the peer.
         //
@@ -359,6 +381,15 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
 #endif
     _engine->verifyPeer(_host, ICE_DYNAMIC_CAST(ConnectionInfo, getInfo()), toString());
 
+#ifdef ICE_HAS_KTLS
+    _ktlsSend = !_memBio && BIO_get_ktls_send(SSL_get_wbio(_ssl));
+#endif
+
+    if(!_sessionKey.empty())
+    {
+        _engine->sessionResumed(_sessionKey, _sessionOffered && SSL_session_reused(_ssl));
+    }
+
     if(_engine->securityTraceLevel() >= 1)
     {
         Trace out(_instance->logger(), _instance->traceCategory());
@@ -379,6 +410,17 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
             out << "bits = " << SSL_CIPHER_get_bits(cipher, 0) << "\n";
             out << "protocol = " << SSL_get_version(_ssl) << "\n";
         }
+        if(SSL_session_reused(_ssl))
+        {
+            out << "resumed session\n";
+        }
+#ifdef ICE_HAS_KTLS
+        if(_engine->ktls() && !_memBio)
+        {
+            out << "kernel TLS = " << (_ktlsSend ? "send" : "none")
+                << (BIO_get_ktls_recv(SSL_get_rbio(_ssl)) ? "/receive" : "") << "\n";
+        }
+#endif
         out << toString();
     }
 
@@ -424,7 +466,7 @@ OpenSSL::TransceiverI::close()
 IceInternal::SocketOperation
 OpenSSL::TransceiverI::write(IceInternal::Buffer& buf)
 {
-    if(!_connected)
+    if(!_connected || ktlsSend())
     {
         return _delegate->write(buf);
     }
@@ -551,6 +593,20 @@ OpenSSL::TransceiverI::write(IceInternal::Buffer& buf)
     return IceInternal::SocketOperationNone;
 }
 
+IceInternal::SocketOperation
+OpenSSL::TransceiverI::writeBuffers(vector<IceInternal::Buffer*>& bufs)
+{
+    //
+    // With kernel TLS send offload, the buffers are gathered with a single
+    // system call by the delegate.
+    //
+    if(!_connected || ktlsSend())
+    {
+        return _delegate->writeBuffers(bufs);
+    }
+    return IceInternal::Transceiver::writeBuffers(bufs);
+}
+
 IceInternal::SocketOperation
 OpenSSL::TransceiverI::read(IceInternal::Buffer& buf)
 {
@@ -905,6 +961,8 @@ OpenSSL::TransceiverI::TransceiverI(const InstancePtr& instance,
     _ssl(0),
     _memBio(0),
     _sentBytes(0),
+    _ktlsSend(false),
+    _sessionOffered(false),
     _maxSendPacketSize(0),
     _maxRecvPacketSize(0)
 {
@@ -914,6 +972,35 @@ OpenSSL::TransceiverI::~TransceiverI()
 {
 }
 
+int
+OpenSSL::TransceiverI::newSession(SSL_SESSION* session)
+{
+    //
+    // Returning 1 transfers the ownership of the session to the cache,
+    // returning 0 lets OpenSSL release it.
+    //
+    if(_incoming || _sessionKey.empty())
+    {
+        return 0;
+    }
+    return _engine->addSession(_sessionKey, session) ? 1 : 0;
+}
+
+bool
+OpenSSL::TransceiverI::ktlsSend() const
+{
+#ifdef ICE_HAS_KTLS
+    //
+    // Plain writes on the socket are encrypted by the kernel as application
+    // data records. OpenSSL must still send the pending key update records
+    // itself, SSL_write is used in this case.
+    //
+    return _ktlsSend && _ssl && SSL_get_key_update_type(_ssl) == SSL_KEY_UPDATE_NONE;
+#else
+    return false;
+#endif
+}
+
 bool
 OpenSSL::TransceiverI::receive()
 {
@@ -18,6 +18,7 @@
 
 typedef struct ssl_st SSL;
 typedef struct bio_st BIO;
+typedef struct ssl_session_st SSL_SESSION;
 
 namespace IceSSL
 {
@@ -35,6 +36,7 @@ public:
     virtual IceInternal::SocketOperation closing(bool, const Ice::LocalException&);
     virtual void close();
     virtual IceInternal::SocketOperation write(IceInternal::Buffer&);
+    virtual IceInternal::SocketOperation writeBuffers(std::vector<IceInternal::Buffer*>&);
     virtual IceInternal::SocketOperation read(IceInternal::Buffer&);
 #ifdef ICE_USE_IOCP
     virtual bool startWrite(IceInternal::Buffer&);
@@ -50,6 +52,7 @@ public:
     virtual void setBufferSize(int rcvSize, int sndSize);
 
     int verifyCallback(int , X509_STORE_CTX*);
+    int newSession(SSL_SESSION*);
 
 private:
 
@@ -58,6 +61,7 @@ private:
 
     bool receive();
     bool send();
+    bool ktlsSend() const;
 
     friend class IceSSL::OpenSSL::SSLEngine;
 
@@ -77,6 +81,9 @@ private:
     IceInternal::Buffer _writeBuffer;
     IceInternal::Buffer _readBuffer;
     int _sentBytes;
+    bool _ktlsSend;
+    std::string _sessionKey;
+    bool _sessionOffered;
     size_t _maxSendPacketSize;
     size_t _maxRecvPacketSize;
 };
@@ -13,6 +13,13 @@
 
 #include <list>
 
+//
+// Kernel TLS offload requires OpenSSL 3 built with kTLS support (Linux).
+//
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#   define ICE_HAS_KTLS
+#endif
+
 namespace IceSSL
 {
 
@@ -7,6 +7,7 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/InstrumentationI.h>
+#include <IceStorm/PublishPool.h>
 #include <IceUtil/Timer.h>
 
 #include <Ice/InstrumentationI.h>
@@ -64,6 +65,9 @@ Instance::Instance(const string& instanceName,
     _sendQueueSizeMax(_communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.QueueSizeMax", -1)),
     _sendQueueSizeMaxPolicy(RemoveSubscriber),
     _topicReaper(make_shared<TopicReaper>()),
+    // default no workers, the publishing thread queues the events.
+    _publishPool(make_shared<PublishPool>(
+        max(_communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Publish.Workers", 0), 0))),
     _observers(make_shared<Observers>(_traceLevels))
 {
     try
@@ -226,6 +230,12 @@ Instance::topicReaper() const
     return _topicReaper;
 }
 
+shared_ptr<PublishPool>
+Instance::publishPool() const
+{
+    return _publishPool;
+}
+
 chrono::seconds
 Instance::discardInterval() const
 {
@@ -273,6 +283,8 @@ Instance::shutdown()
     {
         _timer->destroy();
     }
+
+    _publishPool->destroy();
 }
 
 void
@@ -24,6 +24,7 @@ namespace IceStorm
 {
 
 class TraceLevels;
+class PublishPool;
 
 class TopicReaper
 {
@@ -74,6 +75,7 @@ public:
     std::shared_ptr<Ice::ObjectPrx> publisherReplicaProxy() const;
     std::shared_ptr<IceStorm::Instrumentation::TopicManagerObserver> observer() const;
     std::shared_ptr<TopicReaper> topicReaper() const;
+    std::shared_ptr<PublishPool> publishPool() const;
 
     std::chrono::seconds discardInterval() const;
     std::chrono::milliseconds flushInterval() const;
@@ -102,6 +104,7 @@ private:
     const std::shared_ptr<Ice::ObjectPrx> _topicReplicaProxy;
     const std::shared_ptr<Ice::ObjectPrx> _publisherReplicaProxy;
     const std::shared_ptr<TopicReaper> _topicReaper;
+    const std::shared_ptr<PublishPool> _publishPool;
     std::shared_ptr<IceStormElection::NodeI> _node;
     std::shared_ptr<IceStormElection::Observers> _observers;
     IceUtil::TimerPtr _timer;
@@ -34,7 +34,7 @@ public:
     };
     static Attributes attributes;
 
-    TopicHelper(const string& service, const string& name) : _service(service), _name(name)
+    TopicHelper(const string& service, const string& name) : MetricsHelperT(attributes), _service(service), _name(name)
     {
     }
 
@@ -91,7 +91,8 @@ public:
 
     SubscriberHelper(const string& svc, const string& topic, const shared_ptr<Ice::ObjectPrx>& proxy,
                      const IceStorm::QoS& qos, shared_ptr<IceStorm::TopicPrx> link, SubscriberState state) :
-        _service(svc), _topic(topic), _proxy(proxy), _qos(qos), _link(move(link)), _state(state)
+        MetricsHelperT(attributes), _service(svc), _topic(topic), _proxy(proxy), _qos(qos), _link(move(link)),
+        _state(state)
     {
     }
 
@@ -219,6 +220,23 @@ SubscriberHelper::Attributes SubscriberHelper::attributes;
 
 }
 
+void
+IceMX::addMetrics(TopicMetrics& to, const TopicMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.published += from.published;
+    to.forwarded += from.forwarded;
+}
+
+void
+IceMX::addMetrics(SubscriberMetrics& to, const SubscriberMetrics& from)
+{
+    addMetrics(static_cast<Metrics&>(to), from);
+    to.queued += from.queued;
+    to.outstanding += from.outstanding;
+    to.delivered += from.delivered;
+}
+
 void
 TopicObserverI::published()
 {
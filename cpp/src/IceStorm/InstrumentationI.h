@@ -10,6 +10,14 @@
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Metrics.h>
 
+namespace IceMX
+{
+
+void addMetrics(TopicMetrics&, const TopicMetrics&);
+void addMetrics(SubscriberMetrics&, const SubscriberMetrics&);
+
+}
+
 namespace IceStorm
 {
 
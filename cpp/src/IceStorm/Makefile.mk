@@ -17,6 +17,7 @@ IceStormService_sources         := $(addprefix $(currentdir)/,Instance.cpp \
                                                              InstrumentationI.cpp \
                                                              NodeI.cpp \
                                                              Observers.cpp \
+                                                             PublishPool.cpp \
                                                              Service.cpp \
                                                              Subscriber.cpp \
                                                              TopicI.cpp \
@@ -10,6 +10,8 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Replica.h>
 
+#include <set>
+
 namespace IceStorm
 {
 class TraceLevels;
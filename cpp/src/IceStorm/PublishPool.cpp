@@ -0,0 +1,191 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/PublishPool.h>
+#include <IceStorm/Subscriber.h>
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// The minimum number of subscribers of a shard, queuing the events to
+// fewer subscribers isn't worth the hand-off to a worker.
+//
+const size_t shardSizeMin = 32;
+
+void
+queue(const vector<shared_ptr<Subscriber>>& subscribers, size_t begin, size_t end, bool forwarded,
+      const EventDataPtrSeq& events, Ice::IdentitySeq& reap)
+{
+    for(size_t i = begin; i < end; ++i)
+    {
+        if(!subscribers[i]->queue(forwarded, events) && subscribers[i]->reap())
+        {
+            reap.push_back(subscribers[i]->id());
+        }
+    }
+}
+
+}
+
+PublishPool::PublishPool(int size) :
+    _destroyed(false)
+{
+    for(int i = 0; i < size; ++i)
+    {
+        _threads.emplace_back([this] { run(); });
+    }
+}
+
+PublishPool::~PublishPool()
+{
+    destroy();
+}
+
+Ice::IdentitySeq
+PublishPool::publish(const vector<shared_ptr<Subscriber>>& subscribers, bool forwarded, const EventDataPtrSeq& events)
+{
+    size_t shards = min(_threads.size() + 1, subscribers.size() / shardSizeMin);
+    Ice::IdentitySeq reap;
+    if(shards <= 1)
+    {
+        queue(subscribers, 0, subscribers.size(), forwarded, events, reap);
+        return reap;
+    }
+
+    //
+    // The shards other than the first one are queued by the workers, the
+    // last worker to complete its shard notifies the publishing thread.
+    //
+    vector<Ice::IdentitySeq> reaped(shards);
+    size_t pending = shards - 1;
+    exception_ptr failure;
+    mutex doneMutex;
+    condition_variable done;
+    {
+        lock_guard<mutex> lock(_mutex);
+        if(_destroyed)
+        {
+            queue(subscribers, 0, subscribers.size(), forwarded, events, reap);
+            return reap;
+        }
+
+        for(size_t i = 1; i < shards; ++i)
+        {
+            size_t begin = subscribers.size() * i / shards;
+            size_t end = subscribers.size() * (i + 1) / shards;
+            _tasks.push_back([&, i, begin, end]
+                {
+                    try
+                    {
+                        queue(subscribers, begin, end, forwarded, events, reaped[i]);
+                    }
+                    catch(...)
+                    {
+                        lock_guard<mutex> lk(doneMutex);
+                        failure = current_exception();
+                    }
+
+                    lock_guard<mutex> lk(doneMutex);
+                    if(--pending == 0)
+                    {
+                        done.notify_one();
+                    }
+                });
+        }
+    }
+    _conditionVariable.notify_all();
+
+    try
+    {
+        queue(subscribers, 0, subscribers.size() / shards, forwarded, events, reaped[0]);
+    }
+    catch(...)
+    {
+        lock_guard<mutex> lk(doneMutex);
+        failure = current_exception();
+    }
+
+    //
+    // Help the workers while waiting, this thread might be a worker
+    // publishing from a collocated dispatch.
+    //
+    while(true)
+    {
+        function<void()> task;
+        {
+            lock_guard<mutex> lock(_mutex);
+            if(_tasks.empty())
+            {
+                break;
+            }
+            task = move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+
+    {
+        unique_lock<mutex> lk(doneMutex);
+        done.wait(lk, [&pending] { return pending == 0; });
+    }
+
+    if(failure)
+    {
+        rethrow_exception(failure);
+    }
+
+    for(const auto& r : reaped)
+    {
+        reap.insert(reap.end(), r.begin(), r.end());
+    }
+    return reap;
+}
+
+void
+PublishPool::destroy()
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        if(_destroyed)
+        {
+            return;
+        }
+        _destroyed = true;
+    }
+    _conditionVariable.notify_all();
+
+    for(auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void
+PublishPool::run()
+{
+    while(true)
+    {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(_mutex);
+            _conditionVariable.wait(lock, [this] { return _destroyed || !_tasks.empty(); });
+
+            //
+            // Pending tasks are still run after the pool is destroyed, a
+            // publishing thread is waiting for them.
+            //
+            if(_tasks.empty())
+            {
+                return;
+            }
+            task = move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
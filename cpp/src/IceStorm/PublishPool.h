@@ -0,0 +1,55 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_STORM_PUBLISH_POOL_H
+#define ICE_STORM_PUBLISH_POOL_H
+
+#include <IceStorm/Util.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace IceStorm
+{
+
+class Subscriber;
+
+//
+// The publish pool spreads the queuing of published events over several
+// cores: the subscribers of a topic are split in contiguous shards, the
+// publishing thread queues the events to the first shard and the pool
+// workers to the other shards. The publish returns once every shard is
+// done, the events of a publisher are therefore queued in order to each
+// subscriber. Topics with fewer subscribers than two shards are published
+// by the calling thread only.
+//
+class PublishPool
+{
+public:
+
+    PublishPool(int);
+    ~PublishPool();
+
+    // Queue the events, returns the subscribers that must be reaped.
+    Ice::IdentitySeq publish(const std::vector<std::shared_ptr<Subscriber>>&, bool, const EventDataPtrSeq&);
+
+    void destroy();
+
+private:
+
+    void run();
+
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _conditionVariable;
+    std::deque<std::function<void()>> _tasks;
+    bool _destroyed;
+};
+
+}
+
+#endif
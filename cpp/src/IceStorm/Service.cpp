@@ -508,6 +508,7 @@ ServiceI::validateProperties(const string& name, const shared_ptr<Properties>& p
         "Send.Timeout",
         "Send.QueueSizeMax",
         "Send.QueueSizeMaxPolicy",
+        "Publish.Workers",
         "Discard.Interval",
         "LMDB.Path",
         "LMDB.MapSize"
@@ -52,14 +52,11 @@ public:
         // Use cached reads.
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
 
-        EventData event = { current.operation, current.mode, Ice::ByteSeq(), current.ctx };
-
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event.data.swap(data);
-
-        EventDataSeq e;
-        e.push_back(move(event));
-        _subscriber->queue(false, move(e));
+        EventDataPtrSeq e;
+        e.push_back(make_shared<EventData>(EventData { current.operation, current.mode,
+                                                       Ice::ByteSeq(inParams.first, inParams.second),
+                                                       current.ctx }));
+        _subscriber->queue(false, e);
         return true;
     }
 
@@ -167,7 +164,7 @@ SubscriberOneway::flush()
         // Dequeue the head event, count one more outstanding AMI
         // request.
         //
-        EventData e = move(_events.front());
+        EventDataPtr e = move(_events.front());
         _events.pop_front();
         if(_observer)
         {
@@ -180,7 +177,7 @@ SubscriberOneway::flush()
             auto isSent = make_shared<promise<bool>>();
             auto future = isSent->get_future();
 
-            _obj->ice_invokeAsync(e.op, e.mode, e.data, nullptr,
+            _obj->ice_invokeAsync(e->op, e->mode, e->data, nullptr,
                 [self](exception_ptr ex)
                 {
                     self->error(true, ex);
@@ -193,7 +190,7 @@ SubscriberOneway::flush()
                         self->sentAsynchronously();
                     }
                 },
-                e.context);
+                e->context);
 
             //
             // Check if the request is (or potentially was) sent asynchronously
@@ -280,7 +277,7 @@ SubscriberTwoway::flush()
         // Dequeue the head event, count one more outstanding AMI
         // request.
         //
-        EventData e = move(_events.front());
+        EventDataPtr e = move(_events.front());
         _events.pop_front();
 
         ++_outstanding;
@@ -293,7 +290,7 @@ SubscriberTwoway::flush()
         try
         {
             auto self = static_pointer_cast<SubscriberTwoway>(shared_from_this());
-            _obj->ice_invokeAsync(e.op, e.mode, e.data,
+            _obj->ice_invokeAsync(e->op, e->mode, e->data,
                 [self](bool, vector<Ice::Byte>)
                 {
                     self->completed();
@@ -302,7 +299,7 @@ SubscriberTwoway::flush()
                 {
                     self->error(true, ex);
                 },
-                nullptr, e.context);
+                nullptr, e->context);
         }
         catch(const std::exception&)
         {
@@ -333,11 +330,15 @@ SubscriberLink::flush()
         return;
     }
 
-    EventDataSeq v;
-    v.swap(_events);
+    EventDataPtrSeq events;
+    events.swap(_events);
 
-    auto p = v.begin();
-    while(p != v.end())
+    //
+    // The events are copied here for marshaling, links are few compared
+    // to the other subscribers.
+    //
+    EventDataSeq v;
+    for(const auto& p : events)
     {
         if(_rec.cost != 0)
         {
@@ -356,11 +357,10 @@ SubscriberLink::flush()
             }
             if(cost > _rec.cost)
             {
-                p = v.erase(p);
                 continue;
             }
         }
-        ++p;
+        v.push_back(*p);
     }
 
     if(!v.empty())
@@ -534,7 +534,7 @@ Subscriber::record() const
 }
 
 bool
-Subscriber::queue(bool forwarded, const EventDataSeq& events)
+Subscriber::queue(bool forwarded, const EventDataPtrSeq& events)
 {
     lock_guard<recursive_mutex> lg(_mutex);
 
@@ -564,7 +564,7 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
 
     case SubscriberStateOnline:
     {
-        for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+        for(EventDataPtrSeq::const_iterator p = events.begin(); p != events.end(); ++p)
         {
             if(static_cast<int>(_events.size()) == _instance->sendQueueSizeMax())
             {
@@ -8,6 +8,7 @@
 #include <IceStorm/IceStormInternal.h>
 #include <IceStorm/SubscriberRecord.h>
 #include <IceStorm/Instrumentation.h>
+#include <IceStorm/Util.h>
 #include <Ice/ObserverHelper.h>
 
 #include<condition_variable>
@@ -28,7 +29,7 @@ public:
     IceStorm::SubscriberRecord record() const; // Get the subscriber record.
 
     // Returns false if the subscriber should be reaped.
-    bool queue(bool, const EventDataSeq&);
+    bool queue(bool, const EventDataPtrSeq&);
     bool reap();
     void resetIfReaped();
     bool errored() const;
@@ -76,7 +77,7 @@ protected:
 
     int _outstanding; // The current number of outstanding responses.
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
-    EventDataSeq _events; // The queue of events to send.
+    EventDataPtrSeq _events; // The queue of events to send.
 
     // The next time to try sending a new event if we're offline.
     std::chrono::steady_clock::time_point _next;
@@ -8,6 +8,7 @@
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Observers.h>
+#include <IceStorm/PublishPool.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
 #include <algorithm>
@@ -46,13 +47,10 @@ public:
                const Ice::Current& current) override
     {
         // The publish call does a cached read.
-        EventData event = { current.operation, current.mode, Ice::ByteSeq(), current.ctx };
-
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event.data = move(data);
-
-        EventDataSeq v;
-        v.push_back(move(event));
+        EventDataPtrSeq v;
+        v.push_back(make_shared<EventData>(EventData { current.operation, current.mode,
+                                                       Ice::ByteSeq(inParams.first, inParams.second),
+                                                       current.ctx }));
         _topic->publish(false, v);
 
         return true;
@@ -81,7 +79,7 @@ public:
     forward(EventDataSeq v, const Ice::Current&) override
     {
         // The publish call does a cached read.
-        _impl->publish(true, move(v));
+        _impl->publish(true, IceStormInternal::toEventDataPtrSeq(move(v)));
     }
 
 private:
@@ -921,7 +919,7 @@ TopicImpl::proxy() const
 }
 
 void
-TopicImpl::publish(bool forwarded, const EventDataSeq& events)
+TopicImpl::publish(bool forwarded, const EventDataPtrSeq& events)
 {
     shared_ptr<TopicInternalPrx> masterInternal;
     Ice::Long generation = -1;
@@ -956,13 +954,7 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         // Queue each event, gathering a list of those subscribers that
         // must be reaped.
         //
-        for(const auto& subscriber : copy)
-        {
-            if(!subscriber->queue(forwarded, events) && subscriber->reap())
-            {
-                reap.push_back(subscriber->id());
-            }
-        }
+        reap = _instance->publishPool()->publish(copy, forwarded, events);
 
         // If there are no subscribers in error then we're done.
         if(reap.empty())
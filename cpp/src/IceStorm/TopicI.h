@@ -50,7 +50,7 @@ public:
     Ice::Identity id() const;
     std::shared_ptr<TopicPrx> proxy() const;
     void shutdown();
-    void publish(bool, const EventDataSeq&);
+    void publish(bool, const EventDataPtrSeq&);
 
     // Observer methods.
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const SubscriberRecord&);
@@ -12,6 +12,8 @@
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
 
+#include <set>
+
 namespace IceStorm
 {
 
@@ -5,6 +5,7 @@
 #include <IceStorm/TransientTopicI.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/Subscriber.h>
+#include <IceStorm/PublishPool.h>
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/Util.h>
 
@@ -36,13 +37,10 @@ public:
     ice_invoke(pair<const Ice::Byte*, const Ice::Byte*> inParams, Ice::ByteSeq&, const Ice::Current& current) override
     {
         // Use cached reads.
-        EventData event = { current.operation, current.mode, Ice::ByteSeq(), current.ctx };
-
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event.data.swap(data);
-
-        EventDataSeq v;
-        v.push_back(move(event));
+        EventDataPtrSeq v;
+        v.push_back(make_shared<EventData>(EventData { current.operation, current.mode,
+                                                       Ice::ByteSeq(inParams.first, inParams.second),
+                                                       current.ctx }));
         _impl->publish(false, v);
 
         return true;
@@ -69,7 +67,7 @@ public:
     void
     forward(EventDataSeq v, const Ice::Current&) override
     {
-        _impl->publish(true, move(v));
+        _impl->publish(true, IceStormInternal::toEventDataPtrSeq(move(v)));
     }
 
 private:
@@ -420,7 +418,7 @@ TransientTopicImpl::id() const
 }
 
 void
-TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
+TransientTopicImpl::publish(bool forwarded, const EventDataPtrSeq& events)
 {
     //
     // Copy of the subscriber list so that event publishing can occur
@@ -436,14 +434,7 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
     // Queue each event, gathering a list of those subscribers that
     // must be reaped.
     //
-    vector<Ice::Identity> ids;
-    for(const auto& subscriber : copy)
-    {
-        if(!subscriber->queue(forwarded, events) && subscriber->reap())
-        {
-            ids.push_back(subscriber->id());
-        }
-    }
+    vector<Ice::Identity> ids = _instance->publishPool()->publish(copy, forwarded, events);
 
     //
     // Run through the error list removing those subscribers that are
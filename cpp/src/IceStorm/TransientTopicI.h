@@ -6,6 +6,7 @@
 #define TRANSIENT_TOPIC_I_H
 
 #include <IceStorm/IceStormInternal.h>
+#include <IceStorm/Util.h>
 
 namespace IceStorm
 {
@@ -37,7 +38,7 @@ public:
     // Internal methods
     bool destroyed() const;
     Ice::Identity id() const;
-    void publish(bool, const EventDataSeq&);
+    void publish(bool, const EventDataPtrSeq&);
 
     void shutdown();
 
@@ -61,6 +61,17 @@ IceStormInternal::describeEndpoints(const shared_ptr<Ice::ObjectPrx>& proxy)
     return os.str();
 }
 
+EventDataPtrSeq
+IceStormInternal::toEventDataPtrSeq(EventDataSeq events)
+{
+    EventDataPtrSeq v;
+    for(auto& event : events)
+    {
+        v.push_back(make_shared<EventData>(move(event)));
+    }
+    return v;
+}
+
 int
 IceStormInternal::compareSubscriberRecordKey(const MDB_val* v1, const MDB_val* v2)
 {
@@ -7,6 +7,7 @@
 
 #include <Ice/Ice.h>
 #include <IceDB/IceDB.h>
+#include <IceStorm/IceStormInternal.h>
 #include <IceStorm/LLURecord.h>
 #include <IceStorm/SubscriberRecord.h>
 
@@ -26,6 +27,13 @@ using LLUMap = IceDB::Dbi<std::string, IceStormElection::LogUpdate, IceDB::IceCo
 
 const std::string lluDbKey = "_manager";
 
+//
+// Events are immutable once published: the queue of each subscriber shares
+// the same event records instead of copying them.
+//
+using EventDataPtr = std::shared_ptr<const EventData>;
+using EventDataPtrSeq = std::deque<EventDataPtr>;
+
 }
 
 namespace IceStormInternal
@@ -40,6 +48,9 @@ nameToIdentity(const std::shared_ptr<IceStorm::Instance>&, const std::string&);
 std::string
 describeEndpoints(const std::shared_ptr<Ice::ObjectPrx>&);
 
+IceStorm::EventDataPtrSeq
+toEventDataPtrSeq(IceStorm::EventDataSeq);
+
 int
 compareSubscriberRecordKey(const MDB_val* v1, const MDB_val* v2);
 
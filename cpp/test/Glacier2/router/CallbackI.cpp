@@ -200,6 +200,33 @@ CallbackI::initiateCallbackWithPayloadAsync(shared_ptr<CallbackReceiverPrx> prox
     proxy->callbackWithPayloadAsync(seq, move(response), move(error), nullptr, current.ctx);
 }
 
+void
+CallbackI::ordered(string session, int seq, const Current&)
+{
+    lock_guard<mutex> lg(_mutex);
+    _ordered[session].push_back(seq);
+}
+
+bool
+CallbackI::checkOrdered(string session, int count, const Current&)
+{
+    lock_guard<mutex> lg(_mutex);
+    const vector<int>& seqs = _ordered[session];
+    if(static_cast<int>(seqs.size()) != count)
+    {
+        return false;
+    }
+    for(int i = 0; i < count; ++i)
+    {
+        if(seqs[static_cast<size_t>(i)] != i)
+        {
+            return false;
+        }
+    }
+    _ordered.erase(session);
+    return true;
+}
+
 void
 CallbackI::shutdown(const Ice::Current& current)
 {
@@ -6,6 +6,7 @@
 #define CALLBACK_I_H
 
 #include <Callback.h>
+#include <map>
 #include <vector>
 
 class CallbackReceiverI final : public Test::CallbackReceiver
@@ -62,7 +63,15 @@ public:
                                           std::function<void()>, std::function<void(std::exception_ptr)>,
                                           const Ice::Current&) override;
 
+    void ordered(std::string, int, const Ice::Current&) override;
+    bool checkOrdered(std::string, int, const Ice::Current&) override;
+
     void shutdown(const Ice::Current&) override;
+
+private:
+
+    std::map<std::string, std::vector<int>> _ordered;
+    std::mutex _mutex;
 };
 
 #endif
@@ -8,6 +8,7 @@
 #include <CallbackI.h>
 #include <mutex>
 #include <random>
+#include <thread>
 
 using namespace std;
 using namespace std::chrono_literals;
@@ -396,6 +397,91 @@ public:
     }
 };
 
+class OrderedClient final
+{
+public:
+
+    explicit OrderedClient(int id) : _id(id)
+    {
+    }
+
+    void run(int nRequests)
+    {
+        Ice::CommunicatorHolder communicator(initData);
+        auto router = checkedCast<Glacier2::RouterPrx>(communicator->stringToProxy(
+            "Glacier2/router:" + TestHelper::getTestEndpoint(communicator->getProperties(), 50)));
+        communicator->setDefaultRouter(router);
+
+        ostringstream os;
+        os << "userid-" << _id;
+        router->createSession(os.str(), "abc123");
+
+        auto callback = uncheckedCast<CallbackPrx>(communicator->stringToProxy(
+            "c1/callback:" + TestHelper::getTestEndpoint(communicator->getProperties(), 1)));
+        auto oneway = callback->ice_oneway();
+        for(int i = 0; i < nRequests; ++i)
+        {
+            oneway->ordered(os.str(), i);
+        }
+        test(callback->checkOrdered(os.str(), nRequests));
+
+        router->destroySession();
+    }
+
+private:
+
+    int _id;
+};
+
+//
+// The router is configured with a long sleep time and a flush threshold of
+// 10 requests. A session with 10 queued requests must be flushed without
+// waiting for the end of the sleep time.
+//
+static void
+testFlushThreshold(const shared_ptr<Communicator>& communicator)
+{
+    auto router = checkedCast<Glacier2::RouterPrx>(communicator->stringToProxy(
+        "Glacier2/router:" + TestHelper::getTestEndpoint(communicator->getProperties(), 50)));
+    communicator->setDefaultRouter(router);
+    router->createSession("userid", "abc123");
+
+    auto callback = uncheckedCast<CallbackPrx>(communicator->stringToProxy(
+        "c1/callback:" + TestHelper::getTestEndpoint(communicator->getProperties(), 1)));
+
+    cout << "testing flush threshold... " << flush;
+    {
+        //
+        // Once the ping is flushed, the queue thread waits for the sleep time
+        // before flushing again.
+        //
+        callback->ice_ping();
+
+        auto start = chrono::steady_clock::now();
+        auto oneway = callback->ice_oneway();
+        for(int i = 0; i < 9; ++i)
+        {
+            oneway->ordered("userid", i);
+        }
+        test(callback->checkOrdered("userid", 9));
+        test(chrono::steady_clock::now() - start < 1500ms);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing server shutdown... " << flush;
+    callback->shutdown();
+    router->destroySession();
+    communicator->setDefaultRouter(0);
+    cout << "ok" << endl;
+
+    cout << "testing Glacier2 shutdown... " << flush;
+    auto process = checkedCast<Ice::ProcessPrx>(communicator->stringToProxy(
+        "Glacier2/admin -f Process:" + TestHelper::getTestEndpoint(communicator->getProperties(), 51)));
+    test(process);
+    process->shutdown();
+    cout << "ok" << endl;
+}
+
 class CallbackClient final : public Test::TestHelper
 {
 public:
@@ -416,6 +502,12 @@ CallbackClient::run(int argc, char** argv)
 
     Ice::CommunicatorHolder communicator = initialize(argc, argv, initData);
     shared_ptr<ObjectPrx> routerBase;
+
+    if(argc >= 2 && strcmp(argv[1], "--threshold") == 0)
+    {
+        testFlushThreshold(communicator.communicator());
+        return;
+    }
     {
         cout << "testing stringToProxy for router... " << flush;
         routerBase = communicator->stringToProxy("Glacier2/router:" + getTestEndpoint(50));
@@ -739,6 +831,26 @@ CallbackClient::run(int argc, char** argv)
         cout << "ok" << endl;
     }
 
+    //
+    // The router only forwards the requests of a session in order when it
+    // buffers them.
+    //
+    if(argc >= 2 && strcmp(argv[1], "--ordered") == 0)
+    {
+        cout << "testing request ordering with several sessions... " << flush;
+        const int nClients = 4; // Passwords need to be added to the password file if more clients are needed.
+        vector<future<void>> futures;
+        for(int i = 0; i < nClients; ++i)
+        {
+            futures.push_back(std::async(launch::async, [i] { OrderedClient(i).run(200); }));
+        }
+        for(auto& f : futures)
+        {
+            f.get();
+        }
+        cout << "ok" << endl;
+    }
+
     {
         cout << "testing with blocking clients... " << flush;
 
@@ -31,6 +31,17 @@ CallbackServer::run(int argc, char** argv)
     adapter->add(make_shared<CallbackI>(), Ice::stringToIdentity("c3/callback")); // The test rejects "c3" as category.
     adapter->add(make_shared<CallbackI>(), Ice::stringToIdentity("_userid/callback")); // The test allows the prefixed userid.
     adapter->activate();
+
+    //
+    // The requests forwarded by the router in buffered mode are dispatched in
+    // order only if they are dispatched by a single thread.
+    //
+    communicator->getProperties()->setProperty("OrderedAdapter.Endpoints", getTestEndpoint(1));
+    communicator->getProperties()->setProperty("OrderedAdapter.ThreadPool.Size", "1");
+    auto orderedAdapter = communicator->createObjectAdapter("OrderedAdapter");
+    orderedAdapter->add(make_shared<CallbackI>(), Ice::stringToIdentity("c1/callback"));
+    orderedAdapter->activate();
+
     communicator->waitForShutdown();
 }
 
@@ -7,6 +7,8 @@
 #include <TestHelper.h>
 #include <Test.h>
 
+#include <thread>
+
 using namespace std;
 
 namespace
@@ -1632,6 +1634,118 @@ allTests(Test::TestHelper* helper, bool collocated)
 
     if(p->ice_getConnection())
     {
+        cout << "testing concurrent senders... " << flush;
+        {
+            //
+            // Several threads send requests concurrently on the same connection,
+            // the requests with a payload fill up the connection so the other
+            // requests are queued. The server dispatches the requests with a
+            // single thread, the requests of each thread must be dispatched in
+            // the order they were sent.
+            //
+            auto ordered = Ice::uncheckedCast<Test::TestIntfPrx>(
+                communicator->stringToProxy("test:" + helper->getTestEndpoint(2)));
+            const int senders = 8;
+            const int count = 200;
+            Ice::ByteSeq seq(64 * 1024);
+            vector<thread> threads;
+            for(int i = 0; i < senders; ++i)
+            {
+                threads.push_back(thread([ordered, i, &seq]()
+                    {
+                        vector<future<void>> results;
+                        for(int j = 1; j <= count; ++j)
+                        {
+                            if(j % 20 == 0)
+                            {
+                                results.push_back(ordered->opWithPayloadAsync(seq));
+                            }
+                            if(j % 2 == 0)
+                            {
+                                results.push_back(ordered->opOrderedAsync(i, j));
+                            }
+                            else
+                            {
+                                ordered->opOrdered(i, j);
+                            }
+                        }
+                        for(vector<future<void>>::iterator q = results.begin(); q != results.end(); ++q)
+                        {
+                            q->get();
+                        }
+                    }));
+            }
+            for(vector<thread>::iterator q = threads.begin(); q != threads.end(); ++q)
+            {
+                q->join();
+            }
+            test(ordered->waitForOrdered(senders, count));
+        }
+        cout << "ok" << endl;
+
+        cout << "testing cancel of queued requests... " << flush;
+        {
+            //
+            // The adapter is on hold so the connection fills up and the requests
+            // are queued, they're canceled by the invocation timeout while other
+            // threads queue requests. The adapter is resumed well after the
+            // invocation timeouts expired, so each request must fail with the
+            // invocation timeout.
+            //
+            auto q = p->ice_connectionId("cancel");
+            q->ice_ping();
+
+            testController->holdAdapter();
+            const int senders = 8;
+            const int count = 200;
+            Ice::ByteSeq seq(64 * 1024);
+            vector<future<void>> payloads;
+            for(int i = 0; i < 100; ++i)
+            {
+                payloads.push_back(q->opWithPayloadAsync(seq));
+            }
+
+            vector<vector<future<void>>> results(senders);
+            vector<thread> threads;
+            for(int i = 0; i < senders; ++i)
+            {
+                threads.push_back(thread([q, i, &results]()
+                    {
+                        for(int j = 0; j < count; ++j)
+                        {
+                            results[i].push_back(q->ice_invocationTimeout(j % 4 + 1)->opAsync());
+                        }
+                    }));
+            }
+            for(vector<thread>::iterator t = threads.begin(); t != threads.end(); ++t)
+            {
+                t->join();
+            }
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+            testController->resumeAdapter();
+
+            for(vector<future<void>>::iterator t = payloads.begin(); t != payloads.end(); ++t)
+            {
+                t->get();
+            }
+            for(int i = 0; i < senders; ++i)
+            {
+                for(vector<future<void>>::iterator t = results[i].begin(); t != results[i].end(); ++t)
+                {
+                    try
+                    {
+                        t->get();
+                        test(false);
+                    }
+                    catch(const Ice::InvocationTimeoutException&)
+                    {
+                    }
+                }
+            }
+            q->ice_ping();
+        }
+        cout << "ok" << endl;
+
         cout << "testing bidir... " << flush;
         auto adapter = communicator->createObjectAdapter("");
         auto replyI = make_shared<PingReplyI>();
@@ -36,8 +36,16 @@ Server::run(int argc, char** argv)
     communicator->getProperties()->setProperty("ControllerAdapter.Endpoints", getTestEndpoint(1));
     communicator->getProperties()->setProperty("ControllerAdapter.ThreadPool.Size", "1");
 
+    //
+    // The requests received over a connection are dispatched in order only if
+    // they are dispatched by a single thread.
+    //
+    communicator->getProperties()->setProperty("OrderedAdapter.Endpoints", getTestEndpoint(2));
+    communicator->getProperties()->setProperty("OrderedAdapter.ThreadPool.Size", "1");
+
     Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
     Ice::ObjectAdapterPtr adapter2 = communicator->createObjectAdapter("ControllerAdapter");
+    Ice::ObjectAdapterPtr adapter3 = communicator->createObjectAdapter("OrderedAdapter");
 
     TestIntfControllerIPtr testController = std::make_shared<TestIntfControllerI>(adapter);
 
@@ -48,6 +56,9 @@ Server::run(int argc, char** argv)
     adapter2->add(testController, Ice::stringToIdentity("testController"));
     adapter2->activate();
 
+    adapter3->add(std::make_shared<TestIntfI>(), Ice::stringToIdentity("test"));
+    adapter3->activate();
+
     serverReady();
 
     communicator->waitForShutdown();
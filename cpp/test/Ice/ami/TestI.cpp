@@ -9,7 +9,7 @@ using namespace std;
 using namespace Ice;
 
 TestIntfI::TestIntfI() :
-    _batchCount(0), _shutdown(false)
+    _batchCount(0), _ordered(true), _shutdown(false)
 {
 }
 
@@ -87,6 +87,45 @@ TestIntfI::waitForBatch(Ice::Int count, const Ice::Current&)
     return result;
 }
 
+void
+TestIntfI::opOrdered(Ice::Int sender, Ice::Int seq, const Ice::Current&)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    int& last = _orderedSeqs[sender];
+    if(seq != last + 1)
+    {
+        _ordered = false;
+    }
+    last = seq;
+    notifyAll();
+}
+
+bool
+TestIntfI::waitForOrdered(Ice::Int senders, Ice::Int count, const Ice::Current&)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    while(true)
+    {
+        int done = 0;
+        for(map<int, int>::const_iterator p = _orderedSeqs.begin(); p != _orderedSeqs.end(); ++p)
+        {
+            if(p->second >= count)
+            {
+                ++done;
+            }
+        }
+        if(done == senders)
+        {
+            break;
+        }
+        test(timedWait(IceUtil::Time::milliSeconds(30000)));
+    }
+    bool result = _ordered;
+    _orderedSeqs.clear();
+    _ordered = true;
+    return result;
+}
+
 void
 TestIntfI::close(Test::CloseMode mode, const Ice::Current& current)
 {
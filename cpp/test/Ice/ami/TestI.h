@@ -27,6 +27,8 @@ public:
     virtual void opWithArgs(Ice::Int&, Ice::Int&, Ice::Int&, Ice::Int&, Ice::Int&, Ice::Int&, Ice::Int&,
                             Ice::Int&, Ice::Int&, Ice::Int&, Ice::Int&, const Ice::Current&);
     virtual bool waitForBatch(Ice::Int, const Ice::Current&);
+    virtual void opOrdered(Ice::Int, Ice::Int, const Ice::Current&);
+    virtual bool waitForOrdered(Ice::Int, Ice::Int, const Ice::Current&);
     virtual void close(Test::CloseMode, const Ice::Current&);
     virtual void sleep(Ice::Int, const Ice::Current&);
     virtual void startDispatchAsync(std::function<void()>, std::function<void(std::exception_ptr)>,
@@ -42,6 +44,8 @@ public:
 private:
 
     int _batchCount;
+    std::map<int, int> _orderedSeqs;
+    bool _ordered;
     bool _shutdown;
     std::function<void()> _pending;
 };
@@ -752,6 +752,106 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing binding with connection attempt delay... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ConnectAttemptDelay", "200");
+        Ice::CommunicatorHolder ich(initData);
+
+        vector<RemoteObjectAdapterPrxPtr> adapters;
+        adapters.push_back(com->createObjectAdapter("Adapter91", "default"));
+        adapters.push_back(com->createObjectAdapter("Adapter92", "default"));
+        adapters.push_back(com->createObjectAdapter("Adapter93", "default"));
+
+        TestIntfPrxPtr test = createTestIntfPrx(adapters);
+        test = ICE_UNCHECKED_CAST(TestIntfPrx, ich->stringToProxy(test->ice_toString()));
+        test = ICE_UNCHECKED_CAST(TestIntfPrx, test->ice_endpointSelection(Ice::EndpointSelectionType::Ordered));
+
+        //
+        // With a blackholed first endpoint, the connection to the second
+        // endpoint is established once the attempt delay elapses instead of
+        // once the first endpoint connect timeout expires.
+        //
+        {
+            Ice::EndpointSeq endpoints = test->ice_getEndpoints();
+            endpoints.insert(endpoints.begin(),
+                             ich->stringToProxy("test:tcp -h 192.0.2.1 -p 4061 -t 10000")->ice_getEndpoints()[0]);
+            TestIntfPrxPtr blackholed = test->ice_endpoints(endpoints);
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            test(blackholed->getAdapterName() == "Adapter91");
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(5));
+            blackholed->ice_getConnection()->close(Ice::ConnectionClose::GracefullyWithWait);
+        }
+
+        //
+        // The first connector is tried first, the first adapter should win
+        // unless its connection takes longer than the attempt delay.
+        //
+        string name = test->getAdapterName();
+        test(name == "Adapter91" || name == "Adapter92" || name == "Adapter93");
+        test->ice_getConnection()->close(Ice::ConnectionClose::GracefullyWithWait);
+
+        //
+        // A connector failure starts the next connector right away.
+        //
+        com->deactivateObjectAdapter(adapters[0]);
+        test(test->getAdapterName() == "Adapter92");
+        test->ice_getConnection()->close(Ice::ConnectionClose::GracefullyWithWait);
+        com->deactivateObjectAdapter(adapters[1]);
+        test(test->getAdapterName() == "Adapter93");
+        test->ice_getConnection()->close(Ice::ConnectionClose::GracefullyWithWait);
+        com->deactivateObjectAdapter(adapters[2]);
+
+        try
+        {
+            test->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ConnectFailedException&)
+        {
+        }
+        catch(const Ice::ConnectTimeoutException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing binding with connection pool... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ConnectionPoolSize", "3");
+        Ice::CommunicatorHolder ich(initData);
+
+        RemoteObjectAdapterPrxPtr adapter = com->createObjectAdapter("AdapterPool", "default");
+        TestIntfPrxPtr test = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                                 ich->stringToProxy(adapter->getTestIntf()->ice_toString()));
+        test = ICE_UNCHECKED_CAST(TestIntfPrx, test->ice_connectionCached(false));
+
+        //
+        // The pool grows in the background up to its size, the requests use
+        // the established connections meanwhile.
+        //
+        set<Ice::ConnectionPtr> connections;
+        for(int i = 0; i < 100 && connections.size() < 3; ++i)
+        {
+            test(test->getAdapterName() == "AdapterPool");
+            connections.insert(test->ice_getConnection());
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(connections.size() == 3);
+
+        for(int i = 0; i < 10; ++i)
+        {
+            connections.insert(test->ice_getConnection());
+        }
+        test(connections.size() == 3);
+
+        com->deactivateObjectAdapter(adapter);
+    }
+    cout << "ok" << endl;
+
     cout << "testing endpoint mode filtering... " << flush;
     {
         vector<RemoteObjectAdapterPrxPtr> adapters;
@@ -0,0 +1,580 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <Ice/Network.h>
+#include <Ice/Protocol.h>
+#include <IceUtil/Thread.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+#include <fstream>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+//
+// Records the message type and compression status of the protocol
+// messages traced with Ice.Trace.Protocol.
+//
+class LoggerI : public Ice::Logger, public enable_shared_from_this<LoggerI>, private IceUtil::Mutex
+{
+public:
+
+    struct Message
+    {
+        bool sent;
+        int type;
+        int compress;
+    };
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string& category, const string& message)
+    {
+        if(category != "Protocol")
+        {
+            return;
+        }
+
+        Message m;
+        m.sent = message.find("sending ") == 0;
+        m.type = parse(message, "message type = ");
+        m.compress = parse(message, "compression status = ");
+
+        Lock sync(*this);
+        _messages.push_back(m);
+    }
+
+    virtual void
+    warning(const string&)
+    {
+    }
+
+    virtual void
+    error(const string&)
+    {
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return shared_from_this();
+    }
+
+    //
+    // Returns the compression status of the last message of the given
+    // type sent or received, -1 if there's none.
+    //
+    int
+    status(bool sent, int type)
+    {
+        Lock sync(*this);
+        for(vector<Message>::const_reverse_iterator p = _messages.rbegin(); p != _messages.rend(); ++p)
+        {
+            if(p->sent == sent && p->type == type)
+            {
+                return p->compress;
+            }
+        }
+        return -1;
+    }
+
+private:
+
+    static int
+    parse(const string& message, const string& key)
+    {
+        string::size_type pos = message.find(key);
+        return pos == string::npos ? -1 : atoi(message.c_str() + pos + key.size());
+    }
+
+    vector<Message> _messages;
+};
+using LoggerIPtr = shared_ptr<LoggerI>;
+
+const int requestMsg = 0;
+const int replyMsg = 2;
+const int validateConnectionMsg = 3;
+
+const int maskFlag = 0x80;
+
+const Ice::Byte magic[] = { 0x49, 0x63, 0x65, 0x50 }; // 'I', 'c', 'e', 'P'
+
+bool
+supported(int mask, int id)
+{
+    return (mask & (1 << (id - 1))) != 0;
+}
+
+Ice::CommunicatorPtr
+createCommunicator(TestHelper* helper, const LoggerIPtr& logger, const string& codecs,
+                   const Ice::PropertyDict& props = Ice::PropertyDict())
+{
+    Ice::InitializationData initData;
+    initData.properties = helper->communicator()->getProperties()->clone();
+    initData.properties->setProperty("Ice.Trace.Protocol", "1");
+    if(!codecs.empty())
+    {
+        initData.properties->setProperty("Ice.Compression.Codecs", codecs);
+    }
+    for(Ice::PropertyDict::const_iterator p = props.begin(); p != props.end(); ++p)
+    {
+        initData.properties->setProperty(p->first, p->second);
+    }
+    initData.logger = logger;
+    return Ice::initialize(initData);
+}
+
+//
+// Helpers for the raw socket peers which emulate peers without
+// compressor negotiation.
+//
+void
+writeBytes(SOCKET fd, const vector<Ice::Byte>& bytes)
+{
+    size_t pos = 0;
+    while(pos < bytes.size())
+    {
+        ssize_t ret = ::send(fd, reinterpret_cast<const char*>(&bytes[pos]), static_cast<int>(bytes.size() - pos), 0);
+        test(ret > 0);
+        pos += static_cast<size_t>(ret);
+    }
+}
+
+bool
+readBytes(SOCKET fd, vector<Ice::Byte>& bytes, size_t size)
+{
+    bytes.resize(size);
+    size_t pos = 0;
+    while(pos < size)
+    {
+        ssize_t ret = ::recv(fd, reinterpret_cast<char*>(&bytes[pos]), static_cast<int>(size - pos), 0);
+        if(ret <= 0)
+        {
+            return false; // Connection closed by the peer.
+        }
+        pos += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+Ice::Int
+readInt(const vector<Ice::Byte>& bytes, size_t pos)
+{
+    return static_cast<Ice::Int>(bytes[pos] | (bytes[pos + 1] << 8) | (bytes[pos + 2] << 16) | (bytes[pos + 3] << 24));
+}
+
+//
+// Reads a protocol message and returns its header, the message body is
+// discarded.
+//
+bool
+readMessage(SOCKET fd, vector<Ice::Byte>& header)
+{
+    if(!readBytes(fd, header, IceInternal::headerSize))
+    {
+        return false;
+    }
+    test(equal(magic, magic + sizeof(magic), header.begin()));
+    Ice::Int size = readInt(header, 10);
+    test(size >= IceInternal::headerSize);
+    vector<Ice::Byte> body;
+    return readBytes(fd, body, static_cast<size_t>(size - IceInternal::headerSize));
+}
+
+void
+writeHeader(Ice::OutputStream& os, Ice::Byte type, Ice::Byte compress)
+{
+    os.writeBlob(magic, sizeof(magic));
+    os.write(Ice::currentProtocol);
+    os.write(Ice::currentProtocolEncoding);
+    os.write(type);
+    os.write(compress);
+    os.write(IceInternal::headerSize);
+}
+
+//
+// Emulates a server without compressor negotiation, the compression
+// status of its validate connection message is always 0. It records the
+// header of the requests it receives.
+//
+class OldServer : public IceUtil::Thread, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    OldServer(TestHelper* helper, int port) : _fd(INVALID_SOCKET)
+    {
+        IceInternal::Address addr = IceInternal::getAddressForServer(helper->getTestHost(), port,
+                                                                      IceInternal::EnableBoth, false, true);
+        _fd = IceInternal::createServerSocket(false, addr, IceInternal::getProtocolSupport(addr));
+        IceInternal::setBlock(_fd, true);
+        IceInternal::setReuseAddress(_fd, true);
+        IceInternal::doBind(_fd, addr);
+        IceInternal::doListen(_fd, 1);
+    }
+
+    virtual void
+    run()
+    {
+        SOCKET fd = IceInternal::doAccept(_fd);
+        IceInternal::setBlock(fd, true);
+
+        Ice::OutputStream os;
+        writeHeader(os, IceInternal::validateConnectionMsg, 0);
+        writeBytes(fd, vector<Ice::Byte>(os.b.begin(), os.b.end()));
+
+        vector<Ice::Byte> header;
+        while(readMessage(fd, header) && header[8] != IceInternal::closeConnectionMsg)
+        {
+            Lock sync(*this);
+            _headers.push_back(header);
+            notifyAll();
+        }
+        IceInternal::closeSocketNoThrow(fd);
+    }
+
+    vector<Ice::Byte>
+    waitForRequest(size_t n)
+    {
+        Lock sync(*this);
+        while(_headers.size() <= n)
+        {
+            test(timedWait(IceUtil::Time::seconds(30)));
+        }
+        return _headers[n];
+    }
+
+    void
+    destroy()
+    {
+        IceInternal::closeSocketNoThrow(_fd);
+    }
+
+private:
+
+    SOCKET _fd;
+    vector<vector<Ice::Byte> > _headers;
+};
+using OldServerPtr = IceUtil::Handle<OldServer>;
+
+}
+
+void
+allTests(TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+    string ref = "test:" + helper->getTestEndpoint();
+
+    //
+    // A large and compressible sequence, and a sequence smaller than
+    // Ice.CompressionMinSize which is never compressed.
+    //
+    Ice::ByteSeq large(100 * 1024);
+    for(size_t i = 0; i < large.size(); ++i)
+    {
+        large[i] = static_cast<Ice::Byte>((i / 16) % 32);
+    }
+    Ice::ByteSeq small(10, 1);
+
+    cout << "testing compressor negotiation... " << flush;
+    int serverMask;
+    int expected;
+    {
+        LoggerIPtr logger = make_shared<LoggerI>();
+        Ice::CommunicatorPtr com = createCommunicator(helper, logger, "");
+        auto p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy(ref))->ice_compress(true);
+
+        //
+        // The server advertises the compressors built in Ice in its validate
+        // connection message, bzip2 is always built in.
+        //
+        test(p->echo(small) == small);
+        serverMask = logger->status(false, validateConnectionMsg);
+        test(serverMask > 0 && serverMask < maskFlag);
+        test(supported(serverMask, 2));
+
+        //
+        // Uncompressed messages advertise the compressors of the client.
+        //
+        test(logger->status(true, requestMsg) == (maskFlag | serverMask));
+        test(logger->status(false, replyMsg) == (maskFlag | serverMask));
+
+        //
+        // The client uses its preferred compressor, zstd, lz4 and then bzip2 by
+        // default, and the server compresses the reply with the same compressor.
+        //
+        expected = supported(serverMask, 3) ? 3 : (supported(serverMask, 4) ? 4 : 2);
+        test(p->echo(large) == large);
+        test(logger->status(true, requestMsg) == expected);
+        test(logger->status(false, replyMsg) == expected);
+
+        //
+        // Messages aren't compressed when compression isn't requested.
+        //
+        test(p->ice_compress(false)->echo(large) == large);
+        test(logger->status(true, requestMsg) == 0);
+        test(logger->status(false, replyMsg) == 0);
+
+        com->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing codecs... " << flush;
+    {
+        const char* codecs[] = { "bzip2", "zstd", "lz4" };
+        for(int id = 2; id <= 4; ++id)
+        {
+            LoggerIPtr logger = make_shared<LoggerI>();
+            Ice::CommunicatorPtr com = createCommunicator(helper, logger, codecs[id - 2]);
+            auto p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy(ref))->ice_compress(true);
+            for(int i = 0; i < 10; ++i)
+            {
+                test(p->echo(large) == large);
+                if(supported(serverMask, id))
+                {
+                    test(logger->status(true, requestMsg) == id);
+                    test(logger->status(false, replyMsg) == id);
+                }
+                else
+                {
+                    //
+                    // The codec isn't built in Ice, the client has no compressor.
+                    //
+                    test(logger->status(true, requestMsg) == 1);
+                }
+            }
+
+            //
+            // Sequences of different sizes and contents, including a sequence
+            // which doesn't compress.
+            //
+            Ice::ByteSeq seq;
+            for(size_t i = 0; i < 10; ++i)
+            {
+                seq.resize(i * 997 + 100);
+                for(size_t j = 0; j < seq.size(); ++j)
+                {
+                    seq[j] = static_cast<Ice::Byte>(i < 5 ? j % (i + 2) : (j * 7919 + i) % 251);
+                }
+                test(p->echo(seq) == seq);
+            }
+            com->destroy();
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing negotiation with a bzip2 only peer... " << flush;
+    {
+        //
+        // A bzip2 only server, the client compresses with bzip2.
+        //
+        LoggerIPtr serverLogger = make_shared<LoggerI>();
+        Ice::PropertyDict props;
+        props["TestAdapter.Endpoints"] = helper->getTestEndpoint(1);
+        Ice::CommunicatorPtr server = createCommunicator(helper, serverLogger, "bzip2", props);
+        Ice::ObjectAdapterPtr adapter = server->createObjectAdapter("TestAdapter");
+        adapter->add(make_shared<TestIntfI>(), Ice::stringToIdentity("test"));
+        adapter->activate();
+
+        LoggerIPtr logger = make_shared<LoggerI>();
+        Ice::CommunicatorPtr com = createCommunicator(helper, logger, "");
+        auto p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy("test:" + helper->getTestEndpoint(1)));
+        p = p->ice_compress(true);
+        test(p->echo(large) == large);
+        test(logger->status(false, validateConnectionMsg) == 2);
+        test(logger->status(true, requestMsg) == 2);
+        test(logger->status(false, replyMsg) == 2);
+        com->destroy();
+
+        //
+        // A bzip2 only client, the server compresses the reply with bzip2.
+        //
+        logger = make_shared<LoggerI>();
+        com = createCommunicator(helper, logger, "bzip2");
+        p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy(ref))->ice_compress(true);
+        test(p->echo(small) == small);
+        test(logger->status(true, requestMsg) == (maskFlag | 2));
+        test(p->echo(large) == large);
+        test(logger->status(true, requestMsg) == 2);
+        test(logger->status(false, replyMsg) == 2);
+        com->destroy();
+
+        server->destroy();
+    }
+    cout << "ok" << endl;
+
+    if(supported(serverMask, 3))
+    {
+        cout << "testing zstd dictionary... " << flush;
+        const string file = "zstd.dict";
+        {
+            ofstream out(file.c_str(), ios::binary);
+            for(int i = 0; i < 8192; ++i)
+            {
+                out.put(static_cast<char>((i / 16) % 32));
+            }
+        }
+
+        Ice::PropertyDict props;
+        props["Ice.Compression.Zstd.Dictionary"] = file;
+        props["TestAdapter.Endpoints"] = helper->getTestEndpoint(1);
+        Ice::CommunicatorPtr server = createCommunicator(helper, make_shared<LoggerI>(), "zstd", props);
+        Ice::ObjectAdapterPtr adapter = server->createObjectAdapter("TestAdapter");
+        adapter->add(make_shared<TestIntfI>(), Ice::stringToIdentity("test"));
+        adapter->activate();
+
+        LoggerIPtr logger = make_shared<LoggerI>();
+        Ice::CommunicatorPtr com = createCommunicator(helper, logger, "zstd", props);
+        auto p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy("test:" + helper->getTestEndpoint(1)));
+        p = p->ice_compress(true);
+        for(int i = 0; i < 10; ++i)
+        {
+            test(p->echo(large) == large);
+            test(logger->status(true, requestMsg) == 3);
+            test(logger->status(false, replyMsg) == 3);
+        }
+        com->destroy();
+        server->destroy();
+
+        //
+        // An invalid dictionary file fails the communicator initialization.
+        //
+        props["Ice.Compression.Zstd.Dictionary"] = "nodict.dict";
+        try
+        {
+            createCommunicator(helper, make_shared<LoggerI>(), "zstd", props);
+            test(false);
+        }
+        catch(const Ice::InitializationException&)
+        {
+        }
+
+        remove(file.c_str());
+        cout << "ok" << endl;
+    }
+
+    //
+    // The peers without compressor negotiation are emulated with raw TCP
+    // sockets.
+    //
+    if(helper->getTestProtocol() == "tcp")
+    {
+        cout << "testing server without compressor negotiation... " << flush;
+        {
+            OldServerPtr server = new OldServer(helper, helper->getTestPort(2));
+            IceUtil::ThreadControl control = server->start();
+
+            LoggerIPtr logger = make_shared<LoggerI>();
+            Ice::CommunicatorPtr com = createCommunicator(helper, logger, "");
+            auto p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy("test:" + helper->getTestEndpoint(2)));
+            p = p->ice_compress(true)->ice_oneway();
+
+            //
+            // The client only sends status 1 and bzip2 compressed messages to
+            // a server which doesn't negotiate compressors.
+            //
+            p->echo(small);
+            test(server->waitForRequest(0)[9] == 1);
+            p->echo(large);
+            vector<Ice::Byte> header = server->waitForRequest(1);
+            test(header[9] == 2);
+            test(static_cast<size_t>(readInt(header, 10)) < large.size());
+            com->destroy();
+
+            server->destroy();
+            control.join();
+
+            //
+            // A client without bzip2 doesn't compress its requests.
+            //
+            server = new OldServer(helper, helper->getTestPort(2));
+            control = server->start();
+            com = createCommunicator(helper, make_shared<LoggerI>(), "zstd lz4");
+            p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy("test:" + helper->getTestEndpoint(2)));
+            p = p->ice_compress(true)->ice_oneway();
+            p->echo(large);
+            header = server->waitForRequest(0);
+            test(header[9] == 1);
+            test(static_cast<size_t>(readInt(header, 10)) > large.size());
+            com->destroy();
+
+            server->destroy();
+            control.join();
+        }
+        cout << "ok" << endl;
+
+        cout << "testing client without compressor negotiation... " << flush;
+        {
+            IceInternal::Address addr = IceInternal::getAddressForServer(helper->getTestHost(), helper->getTestPort(),
+                                                                          IceInternal::EnableBoth, false, true);
+            SOCKET fd = IceInternal::createSocket(false, addr);
+            IceInternal::setBlock(fd, true);
+            IceInternal::doConnect(fd, addr, IceInternal::Address());
+
+            vector<Ice::Byte> header;
+            test(readMessage(fd, header));
+            test(header[8] == IceInternal::validateConnectionMsg);
+            test(header[9] == serverMask);
+
+            for(int i = 0; i < 4; ++i)
+            {
+                //
+                // Requests with status 0 or 1, the server replies with status 0,
+                // 1 or 2 (bzip2), which are the only status known to the client.
+                //
+                const Ice::ByteSeq& seq = i < 2 ? small : large;
+                Ice::Byte compress = static_cast<Ice::Byte>(i % 2);
+
+                Ice::OutputStream os(communicator);
+                writeHeader(os, IceInternal::requestMsg, compress);
+                os.write(i + 1);
+                os.write(Ice::stringToIdentity("test"));
+                os.write(vector<string>());
+                os.write(string("echo"));
+                os.write(static_cast<Ice::Byte>(Ice::OperationMode::Normal));
+                os.write(Ice::Context());
+                os.startEncapsulation();
+                os.write(seq);
+                os.endEncapsulation();
+                os.rewrite(static_cast<Ice::Int>(os.b.size()), 10);
+                writeBytes(fd, vector<Ice::Byte>(os.b.begin(), os.b.end()));
+
+                test(readMessage(fd, header));
+                test(header[8] == IceInternal::replyMsg);
+                if(compress == 0)
+                {
+                    test(header[9] == 0);
+                }
+                else if(seq.size() < 100)
+                {
+                    test(header[9] == 1);
+                }
+                else
+                {
+                    test(header[9] == 2);
+                    test(static_cast<size_t>(readInt(header, 10)) < large.size());
+                }
+            }
+            IceInternal::closeSocket(fd);
+        }
+        cout << "ok" << endl;
+    }
+
+    auto p = Ice::checkedCast<TestIntfPrx>(communicator->stringToProxy(ref));
+    p->shutdown();
+}
@@ -0,0 +1,9 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_cppflags                := -I$(srcdir)
+
+$(test)_client_sources          = Test.ice Client.cpp AllTests.cpp TestI.cpp
+
+tests += $(test)
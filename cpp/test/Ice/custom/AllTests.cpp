@@ -229,6 +229,43 @@ allTests(Test::TestHelper* helper)
         test(ret == in);
     }
 
+    {
+        Ice::SharedByteSeq in;
+        Ice::SharedByteSeq out;
+        Ice::SharedByteSeq ret = t->opSharedByteSeq(in, out);
+        test(out.empty());
+        test(ret.empty());
+
+        Ice::ByteSeq small(5);
+        for(size_t i = 0; i < small.size(); ++i)
+        {
+            small[i] = static_cast<Ice::Byte>('1' + i);
+        }
+        in = Ice::SharedByteSeq(small);
+        ret = t->opSharedByteSeq(in, out);
+        test(Ice::ByteSeq(out.begin(), out.end()) == small);
+        test(Ice::ByteSeq(ret.begin(), ret.end()) == small);
+
+        //
+        // Large sequences reference the reply buffer, make sure they remain
+        // valid after the buffer is released by the connection and reused
+        // for other invocations.
+        //
+        Ice::ByteSeq large(256 * 1024);
+        for(size_t i = 0; i < large.size(); ++i)
+        {
+            large[i] = static_cast<Ice::Byte>(i % 251);
+        }
+        in = Ice::SharedByteSeq(large);
+        ret = t->opSharedByteSeq(in, out);
+        Ice::SharedByteSeq out2;
+        Ice::SharedByteSeq ret2 = t->opSharedByteSeq(Ice::SharedByteSeq(Ice::ByteSeq(large.size(), 0)), out2);
+        test(Ice::ByteSeq(out.begin(), out.end()) == large);
+        test(Ice::ByteSeq(ret.begin(), ret.end()) == large);
+        test(out2.size() == large.size() && ret2.size() == large.size());
+        test(ret2[0] == 0 && ret2[1] == 0 && ret2[ret2.size() - 1] == 0);
+    }
+
     {
         deque<string> in(5);
         in[0] = "THESE";
@@ -726,6 +763,19 @@ allTests(Test::TestHelper* helper)
             test(r.returnValue == in);
         }
 
+        {
+            Ice::ByteSeq large(256 * 1024);
+            for(size_t i = 0; i < large.size(); ++i)
+            {
+                large[i] = static_cast<Ice::Byte>(i % 251);
+            }
+
+            auto r = t->opSharedByteSeqAsync(Ice::SharedByteSeq(large)).get();
+            t->ice_ping();
+            test(Ice::ByteSeq(r.outSeq.begin(), r.outSeq.end()) == large);
+            test(Ice::ByteSeq(r.returnValue.begin(), r.returnValue.end()) == large);
+        }
+
         {
             deque<string> in(5);
             in[0] = "THESE";
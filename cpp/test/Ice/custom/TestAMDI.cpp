@@ -81,6 +81,14 @@ TestIntfI::opMyByteSeqAsync(MyByteSeq in,
     response(in, in);
 }
 
+void
+TestIntfI::opSharedByteSeqAsync(Ice::SharedByteSeq in,
+                                std::function<void(const Ice::SharedByteSeq&, const Ice::SharedByteSeq&)> response,
+                                std::function<void(std::exception_ptr)>, const Ice::Current&)
+{
+    response(in, in);
+}
+
 void
 TestIntfI::opStringAsync(Util::string_view in,
                          std::function<void(const Util::string_view&, const Util::string_view&)> response,
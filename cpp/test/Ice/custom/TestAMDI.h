@@ -48,6 +48,10 @@ public:
                           std::function<void(const MyByteSeq&, const MyByteSeq&)>,
                           std::function<void(std::exception_ptr)>, const Ice::Current&) override;
 
+    void opSharedByteSeqAsync(Ice::SharedByteSeq,
+                              std::function<void(const Ice::SharedByteSeq&, const Ice::SharedByteSeq&)>,
+                              std::function<void(std::exception_ptr)>, const Ice::Current&) override;
+
     void opStringAsync(Util::string_view,
                        std::function<void(const Util::string_view&, const Util::string_view&)>,
                        std::function<void(std::exception_ptr)>, const Ice::Current&) override;
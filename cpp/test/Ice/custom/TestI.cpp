@@ -105,6 +105,15 @@ TestIntfI::opMyByteSeq(MyByteSeq inSeq,
     return inSeq;
 }
 
+Ice::SharedByteSeq
+TestIntfI::opSharedByteSeq(Ice::SharedByteSeq inSeq,
+                           Ice::SharedByteSeq& outSeq,
+                           const Ice::Current&)
+{
+    outSeq = inSeq;
+    return inSeq;
+}
+
 std::string
 TestIntfI::opString(Util::string_view inString,
                     std::string& outString,
@@ -55,6 +55,10 @@ public:
                                   MyByteSeq&,
                                   const Ice::Current&);
 
+    virtual Ice::SharedByteSeq opSharedByteSeq(Ice::SharedByteSeq,
+                                               Ice::SharedByteSeq&,
+                                               const Ice::Current&);
+
     virtual std::string opString(Util::string_view,
                                  std::string&,
                                  const Ice::Current&);
@@ -153,4 +153,109 @@ allTests(Test::TestHelper* helper)
     }
 
     cout << "ok" << endl;
+
+    cout << "testing servants with many identities... " << flush;
+
+    //
+    // The active servants are spread over the shards of the servant map by
+    // identity hash, enough identities are used to span all the shards. The
+    // lookups use copies of the identities used to add the servants.
+    //
+    {
+        const int count = 1000;
+        const string categories[] = { "foo", "", "bar" };
+        Ice::ObjectPtr facet = std::make_shared<MyObjectI>();
+        vector<Ice::ObjectPtr> servants;
+        for(idx = 0; idx < count; ++idx)
+        {
+            ostringstream os;
+            os << "servant" << idx;
+            Ice::Identity id;
+            id.name = os.str();
+            id.category = categories[idx % 3];
+            servants.push_back(std::make_shared<MyObjectI>());
+            oa->add(servants.back(), id);
+            if(idx % 2 == 0)
+            {
+                oa->addFacet(facet, id, "facet");
+            }
+        }
+
+        for(idx = 0; idx < count; ++idx)
+        {
+            ostringstream os;
+            os << "servant" << idx;
+            identity.name = os.str();
+            identity.category = categories[idx % 3];
+            test(oa->find(identity) == servants[idx]);
+            test(oa->findAllFacets(identity).size() == (idx % 2 == 0 ? 2 : 1));
+            if(idx % 2 == 0)
+            {
+                test(oa->findFacet(identity, "facet") == facet);
+            }
+            else
+            {
+                test(oa->findFacet(identity, "facet") == servant); // The default servant.
+            }
+
+            try
+            {
+                oa->add(servants[idx], identity);
+                test(false);
+            }
+            catch(const Ice::AlreadyRegisteredException&)
+            {
+            }
+        }
+
+        identity.name = "servant10";
+        identity.category = categories[10 % 3];
+        prx = ICE_UNCHECKED_CAST(MyObjectPrx, oa->createProxy(identity));
+        test(prx->getName() == "servant10");
+        test(ICE_UNCHECKED_CAST(MyObjectPrx, prx->ice_facet("facet"))->getName() == "servant10");
+
+        //
+        // Remove the servants of every other identity, the default servant is
+        // found for the removed identities.
+        //
+        for(idx = 0; idx < count; idx += 2)
+        {
+            ostringstream os;
+            os << "servant" << idx;
+            identity.name = os.str();
+            identity.category = categories[idx % 3];
+            test(oa->remove(identity) == servants[idx]);
+            test(oa->removeFacet(identity, "facet") == facet);
+            try
+            {
+                oa->remove(identity);
+                test(false);
+            }
+            catch(const Ice::NotRegisteredException&)
+            {
+            }
+        }
+
+        for(idx = 0; idx < count; ++idx)
+        {
+            ostringstream os;
+            os << "servant" << idx;
+            identity.name = os.str();
+            identity.category = categories[idx % 3];
+            if(idx % 2 == 0)
+            {
+                test(oa->find(identity) == servant);
+                test(oa->findAllFacets(identity).empty());
+            }
+            else
+            {
+                test(oa->find(identity) == servants[idx]);
+                Ice::FacetMap facets = oa->removeAllFacets(identity);
+                test(facets.size() == 1 && facets[""] == servants[idx]);
+                test(oa->find(identity) == servant);
+            }
+        }
+    }
+
+    cout << "ok" << endl;
 }
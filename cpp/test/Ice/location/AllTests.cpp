@@ -584,6 +584,56 @@ allTests(Test::TestHelper* helper, const string& ref)
     }
     cout << "ok" << endl;
 
+    cout << "testing locator cache refresh threshold... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheRefreshThreshold", "50");
+        Ice::CommunicatorHolder ic(initData);
+
+        registry->setAdapterDirectProxy("TestAdapter6", locator->findAdapterById("TestAdapter"));
+
+        count = locator->getRequestCount();
+        ic->stringToProxy("test@TestAdapter6")->ice_locatorCacheTimeout(3)->ice_ping(); // 3s timeout.
+        test(++count == locator->getRequestCount());
+        ic->stringToProxy("test@TestAdapter6")->ice_locatorCacheTimeout(3)->ice_ping(); // 3s timeout.
+        test(count == locator->getRequestCount());
+
+        registry->setAdapterDirectProxy("TestAdapter6",
+                                        communicator->stringToProxy("dummy:" + helper->getTestEndpoint(99)));
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1600));
+
+        //
+        // Past half of the timeout, the next request still uses the cached endpoints but triggers a
+        // background refresh of the cache entry.
+        //
+        ic->stringToProxy("test@TestAdapter6")->ice_locatorCacheTimeout(3)->ice_ping(); // 3s timeout.
+        for(i = 0; i < 100 && locator->getRequestCount() == count; ++i)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(50));
+        }
+        test(++count == locator->getRequestCount());
+
+        //
+        // Once the locator reply is processed, the refreshed entry has the new endpoints.
+        //
+        bool refreshed = false;
+        for(i = 0; i < 100 && !refreshed; ++i)
+        {
+            try
+            {
+                ic->stringToProxy("test@TestAdapter6")->ice_locatorCacheTimeout(3)->ice_ping(); // 3s timeout.
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+            catch(const Ice::LocalException&)
+            {
+                refreshed = true;
+            }
+        }
+        test(refreshed);
+    }
+    cout << "ok" << endl;
+
     cout << "testing proxy from server after shutdown... " << flush;
     hello = obj->getReplicatedHello();
     obj->shutdown();
@@ -1396,6 +1396,170 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     }
     cout << "ok" << endl;
 
+    cout << "testing buffer pool metrics... " << flush;
+
+    props["IceMX.Metrics.View.Map.BufferPool.GroupBy"] = "id";
+    updateProps(clientProps, serverProps, update.get(), props, "BufferPool");
+
+    for(int i = 0; i < 10; ++i)
+    {
+        metrics->op();
+    }
+
+    IceMX::MetricsMap bufferPool = clientMetrics->getMetricsView("View", timestamp)["BufferPool"];
+    test(!bufferPool.empty());
+    Ice::Long hits = 0;
+    for(IceMX::MetricsMap::const_iterator p = bufferPool.begin(); p != bufferPool.end(); ++p)
+    {
+        IceMX::BufferPoolMetricsPtr m = ICE_DYNAMIC_CAST(IceMX::BufferPoolMetrics, *p);
+        test(m && m->current == 1 && m->total == 1);
+        hits += m->hits;
+    }
+    test(hits > 0);
+
+    testAttribute(clientMetrics, clientProps, update.get(), "BufferPool", "parent", "Communicator");
+
+    cout << "ok" << endl;
+
+    cout << "testing sharded metrics... " << flush;
+
+    props["IceMX.Metrics.View.Map.Dispatch.GroupBy"] = "operation";
+    props["IceMX.Metrics.View.Map.Dispatch.Shards"] = "4";
+    updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+    test(serverMetrics->getMetricsView("View", timestamp)["Dispatch"].empty());
+
+    for(int i = 0; i < 10; ++i)
+    {
+        metrics->op();
+        try
+        {
+            metrics->opWithUserException();
+            test(false);
+        }
+        catch(const Test::UserEx&)
+        {
+        }
+        try
+        {
+            metrics->opWithLocalException();
+            test(false);
+        }
+        catch(const Ice::LocalException&)
+        {
+        }
+    }
+
+    map = toMap(serverMetrics->getMetricsView("View", timestamp)["Dispatch"]);
+    test(map.size() == 3);
+
+    dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["op"]);
+    test(dm1->current <= 1 && dm1->total == 10 && dm1->failures == 0 && dm1->userException == 0);
+    test(dm1->size == 210 && dm1->replySize == 70);
+
+    dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["opWithUserException"]);
+    test(dm1->current <= 1 && dm1->total == 10 && dm1->failures == 0 && dm1->userException == 10);
+    test(dm1->size == 380 && dm1->replySize == 230);
+
+    dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["opWithLocalException"]);
+    test(dm1->current <= 1 && dm1->total == 10 && dm1->failures == 10 && dm1->userException == 0);
+    checkFailure(serverMetrics, "Dispatch", dm1->id, "::Ice::SyscallException", 10);
+
+    props.erase("IceMX.Metrics.View.Map.Dispatch.Shards");
+
+    cout << "ok" << endl;
+
+    cout << "testing lifetime histograms... " << flush;
+
+    props["IceMX.Metrics.View.Map.Dispatch.Histogram"] = "1";
+    updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+    test(serverMetrics->getMetricsView("View", timestamp)["Dispatch"].empty());
+
+    for(int i = 0; i < 10; ++i)
+    {
+        metrics->op();
+    }
+
+    map = toMap(serverMetrics->getMetricsView("View", timestamp)["Dispatch"]);
+    dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["op"]);
+    test(dm1->total == 10 && dm1->lifetimeHistogram);
+    Ice::Long count = 0;
+    for(IceMX::LatencyHistogram::const_iterator p = dm1->lifetimeHistogram->begin();
+        p != dm1->lifetimeHistogram->end(); ++p)
+    {
+        test(p->first >= 0 && p->first <= dm1->totalLifetime && p->second > 0);
+        count += p->second;
+    }
+    test(count == dm1->total - dm1->current);
+
+    props.erase("IceMX.Metrics.View.Map.Dispatch.Histogram");
+    updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+    metrics->op();
+    map = toMap(serverMetrics->getMetricsView("View", timestamp)["Dispatch"]);
+    test(!ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["op"])->lifetimeHistogram);
+
+    cout << "ok" << endl;
+
+    cout << "testing group by reconfiguration... " << flush;
+
+    //
+    // Each map caches the resolvers of its GroupBy attributes, make sure the
+    // resolvers of a previous configuration are never used. The context
+    // attributes don't have a resolver and are resolved by name.
+    //
+    {
+        Ice::Context ctx;
+        ctx["entry1"] = "test";
+
+        const char* groupBys[][2] =
+        {
+            { "identity", "metrics" },
+            { "context.entry1", "test" },
+            { "operation-context.entry1", "op-test" },
+            { "identity:operation", "metrics:op" },
+            { "context.entry1/identity", "test/metrics" },
+            { "operation", "op" }
+        };
+
+        for(size_t i = 0; i < sizeof(groupBys) / sizeof(groupBys[0]); ++i)
+        {
+            props["IceMX.Metrics.View.Map.Dispatch.GroupBy"] = groupBys[i][0];
+            updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+            test(serverMetrics->getMetricsView("View", timestamp)["Dispatch"].empty());
+
+            metrics->op(ctx);
+            metrics->op(ctx);
+
+            IceMX::MetricsMap dispatch = serverMetrics->getMetricsView("View", timestamp)["Dispatch"];
+            test(dispatch.size() == 1);
+            test(dispatch[0]->id == groupBys[i][1] && dispatch[0]->total == 2);
+        }
+
+        //
+        // Check the resolvers of a map with an accept filter.
+        //
+        props["IceMX.Metrics.View.Map.Dispatch.Accept.operation"] = "op";
+        props["IceMX.Metrics.View.Map.Dispatch.GroupBy"] = "identity";
+        updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+
+        metrics->op(ctx);
+        try
+        {
+            metrics->opWithUserException(ctx);
+            test(false);
+        }
+        catch(const Test::UserEx&)
+        {
+        }
+        IceMX::MetricsMap dispatch = serverMetrics->getMetricsView("View", timestamp)["Dispatch"];
+        test(dispatch.size() == 1 && dispatch[0]->id == "metrics" && dispatch[0]->total == 1);
+
+        props.erase("IceMX.Metrics.View.Map.Dispatch.Accept.operation");
+        props["IceMX.Metrics.View.Map.Dispatch.GroupBy"] = "operation";
+        updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+    }
+
+    cout << "ok" << endl;
+
     cout << "testing metrics view enable/disable..." << flush;
 
     Ice::StringSeq disabledViews;
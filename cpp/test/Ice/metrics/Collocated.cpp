@@ -26,6 +26,7 @@ Collocated::run(int argc, char** argv)
     initData.properties->setProperty("Ice.Admin.InstanceName", "client");
     initData.properties->setProperty("Ice.Admin.DelayCreation", "1");
     initData.properties->setProperty("Ice.Warn.Connections", "0");
+    initData.properties->setProperty("Ice.CacheMessageBuffers", "1");
     initData.properties->setProperty("Ice.Warn.Dispatch", "0");
     CommunicatorObserverIPtr observer = std::make_shared<CommunicatorObserverI>();
     initData.observer = observer;
@@ -3679,4 +3679,37 @@ twowaysAMI(const Ice::CommunicatorPtr& communicator, const Test::MyClassPrxPtr&
         }
         cb->check();
     }
+
+    {
+        //
+        // Send many requests of different sizes without waiting for the
+        // replies. The requests queued behind the request being sent are
+        // written together and the socket is likely to only accept part of
+        // them, leaving a request partially written. The replies are sent
+        // the same way by the server.
+        //
+        vector<Test::ByteS> seqs;
+        for(int i = 0; i < 200; ++i)
+        {
+            Test::ByteS seq(static_cast<size_t>((i * 7919) % 65536 + i));
+            for(size_t j = 0; j < seq.size(); ++j)
+            {
+                seq[j] = Ice::Byte((static_cast<size_t>(i) + j) % 251);
+            }
+            seqs.push_back(seq);
+        }
+
+        vector<decltype(p->opByteSAsync(Test::ByteS(), Test::ByteS()))> futures;
+        for(vector<Test::ByteS>::const_iterator q = seqs.begin(); q != seqs.end(); ++q)
+        {
+            futures.push_back(p->opByteSAsync(*q, Test::ByteS()));
+        }
+
+        for(size_t i = 0; i < futures.size(); ++i)
+        {
+            auto r = futures[i].get();
+            test(r.returnValue == seqs[i]);
+            test(r.p3.size() == seqs[i].size() && equal(r.p3.rbegin(), r.p3.rend(), seqs[i].begin()));
+        }
+    }
 }
@@ -0,0 +1,24 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# The client and server thread pools split in several event loops, each
+# event loop gets its share of the thread pool threads.
+#
+eventLoops = {
+    "Ice.ThreadPool.Client.EventLoops" : 2,
+    "Ice.ThreadPool.Client.Size" : 2,
+    "Ice.ThreadPool.Client.SizeMax" : 4,
+    "Ice.ThreadPool.Server.EventLoops" : 3,
+    "Ice.ThreadPool.Server.Size" : 3,
+    "Ice.ThreadPool.Server.SizeMax" : 6,
+}
+
+TestSuite(__file__, [
+    ClientServerTestCase(),
+    ClientAMDServerTestCase(),
+    CollocatedTestCase(),
+    ClientServerTestCase(name="client/server with event loops", props=eventLoops),
+    ClientAMDServerTestCase(name="client/amd server with event loops", props=eventLoops)
+])
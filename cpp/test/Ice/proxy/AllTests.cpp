@@ -242,6 +242,27 @@ allTests(Test::TestHelper* helper)
     b1 = communicator->stringToProxy("test:udp --sourceAddress \"::1\" --interface \"0:0:0:0:0:0:0:1%lo\"");
     test(Ice::targetEqualTo(b1, communicator->stringToProxy(b1->ice_toString())));
 
+    try
+    {
+        b1 = communicator->stringToProxy("test:ws -p 10000 --deflate 12");
+        test(b1->ice_toString().find("--deflate 12") != string::npos);
+        test(Ice::targetEqualTo(b1, communicator->stringToProxy(b1->ice_toString())));
+        test(!Ice::targetEqualTo(b1, communicator->stringToProxy("test:ws -p 10000")));
+    }
+    catch(const Ice::EndpointParseException&)
+    {
+        // Ice built without zlib.
+    }
+
+    try
+    {
+        communicator->stringToProxy("test:ws -p 10000 --deflate 16");
+        test(false);
+    }
+    catch(const Ice::EndpointParseException&)
+    {
+    }
+
     try
     {
         communicator->stringToProxy("test:tcp@adapterId");
@@ -831,6 +852,13 @@ allTests(Test::TestHelper* helper)
     Ice::EndpointSeq endpts3 =  communicator->stringToProxy("foo:tcp -h 127.0.0.1 -p 10000")->ice_getEndpoints();
     test(endpts1.size() == endpts3.size() && equal(endpts1.begin(), endpts1.end(), endpts3.begin(), Ice::TargetCompare<shared_ptr<Ice::Endpoint>, std::equal_to>()));
 
+    //
+    // Equal proxy endpoints are interned and shared.
+    //
+    test(endpts1.size() == endpts3.size() && endpts1[0] == endpts3[0]);
+    test(communicator->stringToProxy(communicator->proxyToString(compObj1))->ice_getEndpoints() ==
+         compObj1->ice_getEndpoints());
+
     test(Ice::targetEqualTo(compObj1->ice_encodingVersion(Ice::Encoding_1_0), compObj1->ice_encodingVersion(Ice::Encoding_1_0)));
     test(Ice::targetNotEqualTo(compObj1->ice_encodingVersion(Ice::Encoding_1_0), compObj1->ice_encodingVersion(Ice::Encoding_1_1)));
     test(Ice::targetLess(compObj->ice_encodingVersion(Ice::Encoding_1_0), compObj->ice_encodingVersion(Ice::Encoding_1_1)));
@@ -0,0 +1,700 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <Ice/Network.h>
+#include <Ice/Protocol.h>
+#include <Ice/ReplyStatus.h>
+#include <IceUtil/Random.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+#ifdef ICE_HAS_ZLIB
+#   include <zlib.h>
+#endif
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+//
+// Records the permessage-deflate statistics traced by the WebSocket
+// transceiver when a connection is closed with Ice.Trace.Network=2.
+//
+class LoggerI : public Ice::Logger, public enable_shared_from_this<LoggerI>, private IceUtil::Mutex
+{
+public:
+
+    struct Stats
+    {
+        Ice::Long sent;
+        Ice::Long sentCompressed;
+        Ice::Long receivedCompressed;
+        Ice::Long received;
+    };
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string&, const string& message)
+    {
+        if(message.find("permessage-deflate: ") != 0)
+        {
+            return;
+        }
+
+        Stats s;
+        s.sent = parse(message, "sent ");
+        s.sentCompressed = parse(message, "compressed to ");
+        s.receivedCompressed = parse(message, "received ");
+        s.received = parse(message, "decompressed to ");
+
+        Lock sync(*this);
+        _stats.push_back(s);
+    }
+
+    virtual void
+    warning(const string&)
+    {
+    }
+
+    virtual void
+    error(const string&)
+    {
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return shared_from_this();
+    }
+
+    vector<Stats>
+    stats()
+    {
+        Lock sync(*this);
+        return _stats;
+    }
+
+private:
+
+    static Ice::Long
+    parse(const string& message, const string& key)
+    {
+        string::size_type pos = message.find(key);
+        test(pos != string::npos);
+        return strtoll(message.c_str() + pos + key.size(), 0, 10);
+    }
+
+    vector<Stats> _stats;
+};
+using LoggerIPtr = shared_ptr<LoggerI>;
+
+Ice::CommunicatorPtr
+createCommunicator(TestHelper* helper, const LoggerIPtr& logger)
+{
+    Ice::InitializationData initData;
+    initData.properties = helper->communicator()->getProperties()->clone();
+    initData.properties->setProperty("Ice.Trace.Network", "2");
+    initData.logger = logger;
+    return Ice::initialize(initData);
+}
+
+Ice::ByteSeq
+compressibleSeq(size_t size)
+{
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>((i / 16) % 32);
+    }
+    return seq;
+}
+
+Ice::ByteSeq
+randomSeq(size_t size)
+{
+    Ice::ByteSeq seq(size);
+    if(size > 0)
+    {
+        IceUtilInternal::generateRandom(reinterpret_cast<char*>(&seq[0]), seq.size());
+    }
+    return seq;
+}
+
+#ifdef ICE_HAS_ZLIB
+
+//
+// WebSocket opcodes and flags, see WSTransceiver.cpp.
+//
+const Ice::Byte opCont = 0x0;
+const Ice::Byte opData = 0x2;
+const Ice::Byte opClose = 0x8;
+const Ice::Byte flagFinal = 0x80;
+const Ice::Byte flagCompressed = 0x40;
+
+const Ice::Byte trailer[] = { 0x00, 0x00, 0xff, 0xff };
+
+const Ice::Byte magic[] = { 0x49, 0x63, 0x65, 0x50 }; // 'I', 'c', 'e', 'P'
+
+void
+writeBytes(SOCKET fd, const vector<Ice::Byte>& bytes)
+{
+    size_t pos = 0;
+    while(pos < bytes.size())
+    {
+        ssize_t ret = ::send(fd, reinterpret_cast<const char*>(&bytes[pos]), static_cast<int>(bytes.size() - pos), 0);
+        test(ret > 0);
+        pos += static_cast<size_t>(ret);
+    }
+}
+
+bool
+readBytes(SOCKET fd, vector<Ice::Byte>& bytes, size_t size)
+{
+    bytes.resize(size);
+    size_t pos = 0;
+    while(pos < size)
+    {
+        ssize_t ret = ::recv(fd, reinterpret_cast<char*>(&bytes[pos]), static_cast<int>(size - pos), 0);
+        if(ret <= 0)
+        {
+            return false; // Connection closed by the peer.
+        }
+        pos += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+Ice::Int
+readInt(const vector<Ice::Byte>& bytes, size_t pos)
+{
+    return static_cast<Ice::Int>(bytes[pos] | (bytes[pos + 1] << 8) | (bytes[pos + 2] << 16) | (bytes[pos + 3] << 24));
+}
+
+vector<Ice::Byte>
+createRequest(const Ice::CommunicatorPtr& communicator, Ice::Int requestId, const Ice::ByteSeq& seq)
+{
+    Ice::OutputStream os(communicator);
+    os.writeBlob(magic, sizeof(magic));
+    os.write(Ice::currentProtocol);
+    os.write(Ice::currentProtocolEncoding);
+    os.write(IceInternal::requestMsg);
+    os.write(static_cast<Ice::Byte>(0));
+    os.write(IceInternal::headerSize);
+    os.write(requestId);
+    os.write(Ice::stringToIdentity("test"));
+    os.write(vector<string>());
+    os.write(string("echo"));
+    os.write(static_cast<Ice::Byte>(Ice::OperationMode::Normal));
+    os.write(Ice::Context());
+    os.startEncapsulation();
+    os.write(seq);
+    os.endEncapsulation();
+    os.rewrite(static_cast<Ice::Int>(os.b.size()), 10);
+    return vector<Ice::Byte>(os.b.begin(), os.b.end());
+}
+
+Ice::ByteSeq
+readReply(const Ice::CommunicatorPtr& communicator, const vector<Ice::Byte>& message, Ice::Int requestId)
+{
+    test(message.size() >= static_cast<size_t>(IceInternal::headerSize));
+    test(message[8] == IceInternal::replyMsg);
+    test(static_cast<size_t>(readInt(message, 10)) == message.size());
+
+    Ice::InputStream is(communicator, make_pair(&message[0] + IceInternal::headerSize, &message[0] + message.size()));
+    Ice::Int id;
+    is.read(id);
+    test(id == requestId);
+    Ice::Byte status;
+    is.read(status);
+    test(status == IceInternal::replyOK);
+    Ice::ByteSeq seq;
+    is.startEncapsulation();
+    is.read(seq);
+    is.endEncapsulation();
+    return seq;
+}
+
+//
+// A raw WebSocket client which sends Ice requests in fragmented messages,
+// compressed with permessage-deflate if the server accepts the extension.
+// The deflate and inflate streams are reset after each message if the
+// server accepted the no context takeover parameters.
+//
+class WebSocketClient
+{
+public:
+
+    WebSocketClient(TestHelper* helper, int port, const string& extensions) :
+        _fd(INVALID_SOCKET),
+        _deflateInitialized(false),
+        _inflateInitialized(false),
+        _lastCompressedSize(0)
+    {
+        IceInternal::Address addr = IceInternal::getAddressForServer(helper->getTestHost(), port,
+                                                                      IceInternal::EnableBoth, false, true);
+        _fd = IceInternal::createSocket(false, addr);
+        IceInternal::setBlock(_fd, true);
+        IceInternal::doConnect(_fd, addr, IceInternal::Address());
+
+        ostringstream os;
+        os << "GET / HTTP/1.1\r\n"
+           << "Host: " << helper->getTestHost() << ":" << port << "\r\n"
+           << "Upgrade: websocket\r\n"
+           << "Connection: Upgrade\r\n"
+           << "Sec-WebSocket-Protocol: ice.zeroc.com\r\n"
+           << "Sec-WebSocket-Version: 13\r\n"
+           << "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n";
+        if(!extensions.empty())
+        {
+            os << "Sec-WebSocket-Extensions: " << extensions << "\r\n";
+        }
+        os << "\r\n";
+        const string request = os.str();
+        writeBytes(_fd, vector<Ice::Byte>(request.begin(), request.end()));
+
+        string response;
+        vector<Ice::Byte> ch;
+        while(response.size() < 4 || response.compare(response.size() - 4, 4, "\r\n\r\n") != 0)
+        {
+            test(readBytes(_fd, ch, 1));
+            response += static_cast<char>(ch[0]);
+        }
+        test(response.find("HTTP/1.1 101 ") == 0);
+
+        const string header = "Sec-WebSocket-Extensions: ";
+        string::size_type pos = response.find(header);
+        if(pos != string::npos)
+        {
+            pos += header.size();
+            _extensions = response.substr(pos, response.find("\r\n", pos) - pos);
+
+            memset(&_deflate, 0, sizeof(_deflate));
+            test(deflateInit2(&_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+            _deflateInitialized = true;
+            memset(&_inflate, 0, sizeof(_inflate));
+            test(inflateInit2(&_inflate, -15) == Z_OK);
+            _inflateInitialized = true;
+        }
+
+        vector<Ice::Byte> message;
+        test(readMessage(message));
+        test(message.size() == static_cast<size_t>(IceInternal::headerSize));
+        test(message[8] == IceInternal::validateConnectionMsg);
+    }
+
+    ~WebSocketClient()
+    {
+        if(_deflateInitialized)
+        {
+            deflateEnd(&_deflate);
+        }
+        if(_inflateInitialized)
+        {
+            inflateEnd(&_inflate);
+        }
+        IceInternal::closeSocketNoThrow(_fd);
+    }
+
+    const string&
+    extensions() const
+    {
+        return _extensions;
+    }
+
+    //
+    // The size of the compressed payload of the last message read, 0 if
+    // it wasn't compressed.
+    //
+    size_t
+    lastCompressedSize() const
+    {
+        return _lastCompressedSize;
+    }
+
+    //
+    // Sends the message in the given number of frames, the message is
+    // compressed if permessage-deflate is negotiated.
+    //
+    void
+    sendMessage(const vector<Ice::Byte>& message, size_t frames)
+    {
+        vector<Ice::Byte> payload = _deflateInitialized ? deflateMessage(message) : message;
+        size_t frameSize = max<size_t>((payload.size() + frames - 1) / frames, 1);
+        size_t pos = 0;
+        do
+        {
+            size_t n = min(frameSize, payload.size() - pos);
+            Ice::Byte opCode = pos == 0 ? opData : opCont;
+            if(pos == 0 && _deflateInitialized)
+            {
+                opCode |= flagCompressed;
+            }
+            if(pos + n == payload.size())
+            {
+                opCode |= flagFinal;
+            }
+            sendFrame(opCode, payload.empty() ? 0 : &payload[pos], n);
+            pos += n;
+        }
+        while(pos < payload.size());
+    }
+
+    void
+    sendFrame(Ice::Byte opCode, const Ice::Byte* payload, size_t size)
+    {
+        vector<Ice::Byte> frame;
+        frame.push_back(opCode);
+        if(size < 126)
+        {
+            frame.push_back(static_cast<Ice::Byte>(0x80 | size));
+        }
+        else if(size <= 0xffff)
+        {
+            frame.push_back(0x80 | 126);
+            frame.push_back(static_cast<Ice::Byte>(size >> 8));
+            frame.push_back(static_cast<Ice::Byte>(size));
+        }
+        else
+        {
+            frame.push_back(0x80 | 127);
+            for(int i = 7; i >= 0; --i)
+            {
+                frame.push_back(static_cast<Ice::Byte>(static_cast<Ice::Long>(size) >> (i * 8)));
+            }
+        }
+
+        //
+        // Client frames are masked.
+        //
+        Ice::Byte mask[4];
+        IceUtilInternal::generateRandom(reinterpret_cast<char*>(mask), sizeof(mask));
+        frame.insert(frame.end(), mask, mask + sizeof(mask));
+        for(size_t i = 0; i < size; ++i)
+        {
+            frame.push_back(payload[i] ^ mask[i % 4]);
+        }
+        writeBytes(_fd, frame);
+    }
+
+    //
+    // Reads the frames of the next message, the message is decompressed
+    // if the RSV1 bit of its first frame is set. Returns false if the
+    // server closed the connection.
+    //
+    bool
+    readMessage(vector<Ice::Byte>& message)
+    {
+        message.clear();
+        bool compressed = false;
+        bool first = true;
+        while(true)
+        {
+            vector<Ice::Byte> header;
+            if(!readBytes(_fd, header, 2))
+            {
+                return false;
+            }
+            test((header[1] & 0x80) == 0); // Server frames aren't masked.
+
+            size_t size = header[1] & 0x7f;
+            if(size >= 126)
+            {
+                vector<Ice::Byte> length;
+                if(!readBytes(_fd, length, size == 126 ? 2 : 8))
+                {
+                    return false;
+                }
+                size = 0;
+                for(vector<Ice::Byte>::const_iterator p = length.begin(); p != length.end(); ++p)
+                {
+                    size = (size << 8) | *p;
+                }
+            }
+
+            vector<Ice::Byte> payload;
+            if(!readBytes(_fd, payload, size))
+            {
+                return false;
+            }
+
+            Ice::Byte opCode = header[0] & 0x0f;
+            if(opCode == opClose)
+            {
+                return false;
+            }
+            else if(first)
+            {
+                test(opCode == opData);
+                compressed = (header[0] & flagCompressed) != 0;
+                test(!compressed || _inflateInitialized);
+                first = false;
+            }
+            else
+            {
+                test(opCode == opCont);
+                test((header[0] & flagCompressed) == 0);
+            }
+            message.insert(message.end(), payload.begin(), payload.end());
+
+            if((header[0] & flagFinal) != 0)
+            {
+                break;
+            }
+        }
+
+        _lastCompressedSize = compressed ? message.size() : 0;
+        if(compressed)
+        {
+            inflateMessage(message);
+        }
+        return true;
+    }
+
+private:
+
+    vector<Ice::Byte>
+    deflateMessage(const vector<Ice::Byte>& message)
+    {
+        vector<Ice::Byte> payload(deflateBound(&_deflate, static_cast<uLong>(message.size())) + 64);
+        _deflate.next_in = const_cast<Bytef*>(message.empty() ? 0 : &message[0]);
+        _deflate.avail_in = static_cast<uInt>(message.size());
+        _deflate.next_out = &payload[0];
+        _deflate.avail_out = static_cast<uInt>(payload.size());
+        test(::deflate(&_deflate, Z_SYNC_FLUSH) == Z_OK);
+        test(_deflate.avail_in == 0 && _deflate.avail_out > 0);
+        payload.resize(payload.size() - _deflate.avail_out);
+
+        //
+        // Strip the empty deflate block of the flush.
+        //
+        test(payload.size() >= sizeof(trailer) && equal(trailer, trailer + sizeof(trailer), payload.end() - 4));
+        payload.resize(payload.size() - sizeof(trailer));
+
+        if(_extensions.find("client_no_context_takeover") != string::npos)
+        {
+            test(deflateReset(&_deflate) == Z_OK);
+        }
+        return payload;
+    }
+
+    void
+    inflateMessage(vector<Ice::Byte>& message)
+    {
+        message.insert(message.end(), trailer, trailer + sizeof(trailer));
+        vector<Ice::Byte> result;
+        _inflate.next_in = &message[0];
+        _inflate.avail_in = static_cast<uInt>(message.size());
+        bool full;
+        do
+        {
+            size_t pos = result.size();
+            result.resize(pos + 64 * 1024);
+            _inflate.next_out = &result[pos];
+            _inflate.avail_out = 64 * 1024;
+            int ret = ::inflate(&_inflate, Z_SYNC_FLUSH);
+            test(ret == Z_OK || ret == Z_BUF_ERROR);
+            full = _inflate.avail_out == 0;
+            result.resize(result.size() - _inflate.avail_out);
+        }
+        while(_inflate.avail_in > 0 || full);
+        message.swap(result);
+
+        if(_extensions.find("server_no_context_takeover") != string::npos)
+        {
+            test(inflateReset(&_inflate) == Z_OK);
+        }
+    }
+
+    SOCKET _fd;
+    string _extensions;
+    z_stream _deflate;
+    bool _deflateInitialized;
+    z_stream _inflate;
+    bool _inflateInitialized;
+    size_t _lastCompressedSize;
+};
+
+#endif
+
+}
+
+void
+allTests(TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+    string ref = "test:" + helper->getTestEndpoint(0, "ws") + " --deflate";
+    try
+    {
+        communicator->stringToProxy(ref);
+    }
+    catch(const Ice::EndpointParseException&)
+    {
+        cout << "permessage-deflate not supported, skipping test" << endl;
+        Ice::uncheckedCast<TestIntfPrx>(communicator->stringToProxy("test:" + helper->getTestEndpoint(0, "ws")))->shutdown();
+        return;
+    }
+
+    //
+    // Compressible and incompressible sequences of sizes around the
+    // compression threshold of 64 bytes and larger than the read buffer.
+    //
+    vector<Ice::ByteSeq> seqs;
+    const size_t sizes[] = { 0, 10, 63, 64, 65, 1000, 100 * 1024, 512 * 1024 };
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i)
+    {
+        seqs.push_back(compressibleSeq(sizes[i]));
+        seqs.push_back(randomSeq(sizes[i]));
+    }
+
+    cout << "testing permessage-deflate... " << flush;
+    {
+        const string endpoints[] = { "", " 9", " 12" };
+        for(size_t i = 0; i < sizeof(endpoints) / sizeof(string); ++i)
+        {
+            LoggerIPtr logger = make_shared<LoggerI>();
+            Ice::CommunicatorPtr com = createCommunicator(helper, logger);
+            auto p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy(ref + endpoints[i]));
+            for(vector<Ice::ByteSeq>::const_iterator q = seqs.begin(); q != seqs.end(); ++q)
+            {
+                test(p->echo(*q) == *q);
+            }
+            com->destroy();
+
+            //
+            // The client compressed its requests and decompressed the server
+            // replies.
+            //
+            vector<LoggerI::Stats> stats = logger->stats();
+            test(stats.size() == 1);
+            test(stats[0].sentCompressed > 0 && stats[0].sentCompressed < stats[0].sent);
+            test(stats[0].receivedCompressed > 0 && stats[0].receivedCompressed < stats[0].received);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing peers without permessage-deflate... " << flush;
+    {
+        //
+        // A client with permessage-deflate and a server without, and a client
+        // without permessage-deflate and a server with.
+        //
+        const string refs[] = { "test:" + helper->getTestEndpoint(1, "ws") + " --deflate", "test:" + helper->getTestEndpoint(0, "ws") };
+        for(size_t i = 0; i < sizeof(refs) / sizeof(string); ++i)
+        {
+            LoggerIPtr logger = make_shared<LoggerI>();
+            Ice::CommunicatorPtr com = createCommunicator(helper, logger);
+            auto p = Ice::uncheckedCast<TestIntfPrx>(com->stringToProxy(refs[i]));
+            for(vector<Ice::ByteSeq>::const_iterator q = seqs.begin(); q != seqs.end(); ++q)
+            {
+                test(p->echo(*q) == *q);
+            }
+            com->destroy();
+            test(logger->stats().empty());
+        }
+    }
+    cout << "ok" << endl;
+
+#ifdef ICE_HAS_ZLIB
+    cout << "testing fragmented compressed messages... " << flush;
+    {
+        const string extensions = "permessage-deflate; server_no_context_takeover; client_no_context_takeover";
+        WebSocketClient client(helper, helper->getTestPort(), extensions);
+        test(client.extensions() == extensions);
+
+        //
+        // Each sequence is sent twice: the server inflates the requests and
+        // the client inflates the replies with streams reset after each
+        // message, which fails if the peer kept its compression context.
+        //
+        Ice::Int requestId = 1;
+        const size_t frames[] = { 1, 3, 7 };
+        for(vector<Ice::ByteSeq>::const_iterator q = seqs.begin(); q != seqs.end(); ++q)
+        {
+            for(size_t i = 0; i < sizeof(frames) / sizeof(size_t); ++i)
+            {
+                client.sendMessage(createRequest(communicator, requestId, *q), frames[i]);
+                vector<Ice::Byte> reply;
+                test(client.readMessage(reply));
+                test(readReply(communicator, reply, requestId) == *q);
+                test((client.lastCompressedSize() > 0) == (reply.size() >= 64));
+                ++requestId;
+            }
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing permessage-deflate context takeover... " << flush;
+    {
+        WebSocketClient client(helper, helper->getTestPort(), "permessage-deflate");
+        test(client.extensions() == "permessage-deflate");
+
+        //
+        // The second request and reply reference the first message, the
+        // second reply is much smaller than the first one.
+        //
+        Ice::ByteSeq seq = randomSeq(16 * 1024);
+        size_t compressedSizes[2];
+        for(Ice::Int requestId = 1; requestId <= 2; ++requestId)
+        {
+            client.sendMessage(createRequest(communicator, requestId, seq), 3);
+            vector<Ice::Byte> reply;
+            test(client.readMessage(reply));
+            test(readReply(communicator, reply, requestId) == seq);
+            compressedSizes[requestId - 1] = client.lastCompressedSize();
+        }
+        test(compressedSizes[0] > seq.size() && compressedSizes[1] > 0 && compressedSizes[1] < compressedSizes[0] / 4);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing WebSocket peers without permessage-deflate... " << flush;
+    {
+        //
+        // A client which doesn't offer the extension and a server which
+        // ignores it, messages are never compressed.
+        //
+        const int ports[] = { helper->getTestPort(), helper->getTestPort(1) };
+        const string extensions[] = { "", "permessage-deflate" };
+        for(int i = 0; i < 2; ++i)
+        {
+            WebSocketClient client(helper, ports[i], extensions[i]);
+            test(client.extensions().empty());
+            Ice::Int requestId = 1;
+            for(vector<Ice::ByteSeq>::const_iterator q = seqs.begin(); q != seqs.end(); ++q)
+            {
+                client.sendMessage(createRequest(communicator, requestId, *q), 3);
+                vector<Ice::Byte> reply;
+                test(client.readMessage(reply));
+                test(client.lastCompressedSize() == 0);
+                test(readReply(communicator, reply, requestId) == *q);
+                ++requestId;
+            }
+
+            //
+            // A compressed frame is a protocol error if the extension isn't
+            // negotiated, the server closes the connection.
+            //
+            vector<Ice::Byte> request = createRequest(communicator, requestId, seqs.back());
+            client.sendFrame(opData | flagFinal | flagCompressed, &request[0], request.size());
+            vector<Ice::Byte> reply;
+            test(!client.readMessage(reply));
+        }
+    }
+    cout << "ok" << endl;
+#endif
+
+    Ice::uncheckedCast<TestIntfPrx>(communicator->stringToProxy(ref))->shutdown();
+}
@@ -0,0 +1,15 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_cppflags                := -I$(srcdir)
+
+#
+# The raw WebSocket peers compress and decompress their messages with zlib.
+#
+ifeq ($(shell pkg-config --exists zlib 2> /dev/null && echo yes),yes)
+$(test)_cppflags                += -DICE_HAS_ZLIB $(shell pkg-config --cflags zlib)
+$(test)_ldflags                 += $(shell pkg-config --libs zlib)
+endif
+
+tests += $(test)
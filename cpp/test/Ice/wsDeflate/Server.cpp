@@ -0,0 +1,55 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+    properties->setProperty("Ice.Warn.Connections", "0");
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+
+    //
+    // The permessage-deflate adapter, the --deflate option isn't supported
+    // if Ice is built without zlib and the client skips the test.
+    //
+    Ice::ObjectAdapterPtr adapter;
+    try
+    {
+        communicator->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint(0, "ws") + " --deflate");
+        adapter = communicator->createObjectAdapter("TestAdapter");
+    }
+    catch(const Ice::EndpointParseException&)
+    {
+        communicator->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint(0, "ws"));
+        adapter = communicator->createObjectAdapter("TestAdapter");
+    }
+    adapter->add(std::make_shared<TestIntfI>(), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    //
+    // A server without permessage-deflate.
+    //
+    communicator->getProperties()->setProperty("OldAdapter.Endpoints", getTestEndpoint(1, "ws"));
+    Ice::ObjectAdapterPtr oldAdapter = communicator->createObjectAdapter("OldAdapter");
+    oldAdapter->add(std::make_shared<TestIntfI>(), Ice::stringToIdentity("test"));
+    oldAdapter->activate();
+
+    serverReady();
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
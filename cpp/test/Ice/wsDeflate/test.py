@@ -0,0 +1,9 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# The test always uses ws endpoints, the permessage-deflate extension is
+# only supported by the WebSocket transports.
+#
+TestSuite(__file__, options={ "transport" : ["tcp"], "compress" : [False], "serialize" : [False], "mx" : [False] })
@@ -37,6 +37,13 @@
 #   include <IceSSL/OpenSSL.h>
 #endif
 
+#if defined(ICE_USE_OPENSSL) && !defined(_WIN32)
+#   include <Ice/Protocol.h>
+#   include <openssl/ssl.h>
+#   include <openssl/err.h>
+#   include <mutex>
+#endif
+
 using namespace std;
 using namespace Ice;
 
@@ -386,6 +393,209 @@ private:
 };
 ICE_DEFINE_PTR(CertificateVerifierIPtr, CertificateVerifierI);
 
+#if defined(ICE_USE_OPENSSL) && !defined(_WIN32)
+//
+// Records the kernel TLS offload and the session resumption of the outgoing
+// connections traced by the OpenSSL transceiver with IceSSL.Trace.Security=1.
+//
+class SecurityLoggerI final : public Ice::Logger, public std::enable_shared_from_this<SecurityLoggerI>
+{
+public:
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string&, const string& message)
+    {
+        const string key = "kernel TLS = ";
+        string::size_type pos = message.find(key);
+        lock_guard<mutex> lock(_mutex);
+        if(message.find("SSL summary for outgoing connection") == 0)
+        {
+            _resumed.push_back(message.find("resumed session") != string::npos);
+        }
+        if(pos != string::npos)
+        {
+            pos += key.size();
+            _offload.push_back(message.substr(pos, message.find('\n', pos) - pos));
+        }
+        else if(message.find("kernel TLS isn't supported") != string::npos)
+        {
+            _unsupported = true;
+        }
+    }
+
+    virtual void
+    warning(const string&)
+    {
+    }
+
+    virtual void
+    error(const string&)
+    {
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return shared_from_this();
+    }
+
+    vector<string>
+    offload()
+    {
+        lock_guard<mutex> lock(_mutex);
+        return _offload;
+    }
+
+    bool
+    unsupported()
+    {
+        lock_guard<mutex> lock(_mutex);
+        return _unsupported;
+    }
+
+    vector<bool>
+    resumed()
+    {
+        lock_guard<mutex> lock(_mutex);
+        return _resumed;
+    }
+
+private:
+
+    mutex _mutex;
+    vector<string> _offload;
+    bool _unsupported = false;
+    vector<bool> _resumed;
+};
+
+//
+// Counts the handshake messages received by the raw OpenSSL client.
+//
+void
+countHandshakeMessages(int writeP, int, int contentType, const void* buf, size_t len, SSL*, void* arg)
+{
+    if(!writeP && contentType == SSL3_RT_HANDSHAKE && len > 0)
+    {
+        map<int, int>& counts = *reinterpret_cast<map<int, int>*>(arg);
+        ++counts[static_cast<const unsigned char*>(buf)[0]];
+    }
+}
+
+bool
+readSSLBytes(SSL* ssl, vector<Ice::Byte>& bytes, size_t size)
+{
+    bytes.resize(size);
+    size_t pos = 0;
+    while(pos < size)
+    {
+        int ret = SSL_read(ssl, &bytes[pos], static_cast<int>(size - pos));
+        if(ret <= 0)
+        {
+            return false;
+        }
+        pos += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+//
+// Reads an Ice protocol message, returns the message type or -1 if the
+// read failed. The message body is returned in message.
+//
+int
+readIceMessage(SSL* ssl, vector<Ice::Byte>& message)
+{
+    vector<Ice::Byte> header;
+    if(!readSSLBytes(ssl, header, IceInternal::headerSize))
+    {
+        return -1;
+    }
+    Ice::Int size = header[10] | (header[11] << 8) | (header[12] << 16) | (header[13] << 24);
+    test(size >= IceInternal::headerSize);
+    if(!readSSLBytes(ssl, message, static_cast<size_t>(size - IceInternal::headerSize)))
+    {
+        return -1;
+    }
+    return header[8];
+}
+
+//
+// Connects a raw OpenSSL client to the given server and reads the validate
+// connection message.
+//
+SSL*
+connectWithSSL(SSL_CTX* ctx, const Ice::IPEndpointInfoPtr& info)
+{
+    ostringstream port;
+    port << info->port;
+    BIO* bio = BIO_new(BIO_s_connect());
+    BIO_set_conn_hostname(bio, info->host.c_str());
+    BIO_set_conn_port(bio, port.str().c_str());
+    test(BIO_do_connect(bio) > 0);
+
+    SSL* ssl = SSL_new(ctx);
+    SSL_set_bio(ssl, bio, bio);
+    test(SSL_connect(ssl) == 1);
+
+    vector<Ice::Byte> message;
+    test(readIceMessage(ssl, message) == IceInternal::validateConnectionMsg);
+    return ssl;
+}
+
+//
+// Sends an ice_ping request and checks its reply, returns false if the
+// connection failed.
+//
+bool
+pingWithSSL(const CommunicatorPtr& communicator, SSL* ssl, const Ice::Identity& identity, Ice::Int requestId)
+{
+    static const Ice::Byte magic[] = { 0x49, 0x63, 0x65, 0x50 }; // 'I', 'c', 'e', 'P'
+
+    Ice::OutputStream os(communicator);
+    os.writeBlob(magic, sizeof(magic));
+    os.write(Ice::currentProtocol);
+    os.write(Ice::currentProtocolEncoding);
+    os.write(IceInternal::requestMsg);
+    os.write(static_cast<Ice::Byte>(0));
+    os.write(IceInternal::headerSize);
+    os.write(requestId);
+    os.write(identity);
+    os.write(vector<string>());
+    os.write(string("ice_ping"));
+    os.write(static_cast<Ice::Byte>(Ice::OperationMode::Nonmutating));
+    os.write(Ice::Context());
+    os.writeEmptyEncapsulation(Ice::currentEncoding);
+    os.rewrite(static_cast<Ice::Int>(os.b.size()), 10);
+    if(SSL_write(ssl, &os.b[0], static_cast<int>(os.b.size())) <= 0)
+    {
+        return false;
+    }
+
+    vector<Ice::Byte> reply;
+    int type = readIceMessage(ssl, reply);
+    if(type < 0)
+    {
+        return false;
+    }
+    test(type == IceInternal::replyMsg);
+    test(reply.size() > 4);
+    test((reply[0] | (reply[1] << 8) | (reply[2] << 16) | (reply[3] << 24)) == requestId);
+    test(reply[4] == 0); // Reply status OK
+    return true;
+}
+#endif
+
 int keychainN = 0;
 
 static PropertiesPtr
@@ -404,6 +614,10 @@ createClientProps(const Ice::PropertiesPtr& defaultProps, bool p12)
     {
         result->setProperty("Ice.IPv6", defaultProps->getProperty("Ice.IPv6"));
     }
+    if(!defaultProps->getProperty("IceSSL.KTLS").empty())
+    {
+        result->setProperty("IceSSL.KTLS", defaultProps->getProperty("IceSSL.KTLS"));
+    }
     if(p12)
     {
         result->setProperty("IceSSL.Password", "password");
@@ -435,6 +649,10 @@ createServerProps(const Ice::PropertiesPtr& defaultProps, bool p12)
     {
         result["Ice.IPv6"] = defaultProps->getProperty("Ice.IPv6");
     }
+    if(!defaultProps->getProperty("IceSSL.KTLS").empty())
+    {
+        result["IceSSL.KTLS"] = defaultProps->getProperty("IceSSL.KTLS");
+    }
     if(p12)
     {
         result["IceSSL.Password"] = "password";
@@ -3805,6 +4023,204 @@ allTests(Test::TestHelper* helper, const string& /*testDir*/, bool p12)
 #endif
     }
 
+#if defined(ICE_USE_OPENSSL) && !defined(_WIN32)
+    cout << "testing kernel TLS... " << flush;
+    {
+        //
+        // The security trace of a client with IceSSL.KTLS shows the offloaded
+        // directions. OpenSSL doesn't offload CBC ciphers, the connection falls
+        // back to SSL_read and SSL_write. The kernel may also refuse the offload
+        // of the default ciphers (e.g. without the tls module).
+        //
+        const char* ciphers[] = { "", "AES128-SHA256" };
+        for(int i = 0; i < 2; ++i)
+        {
+            auto logger = make_shared<SecurityLoggerI>();
+            InitializationData initData;
+            initData.properties = createClientProps(defaultProps, p12);
+            initData.properties->setProperty("IceSSL.VerifyPeer", "0");
+            initData.properties->setProperty("IceSSL.KTLS", "1");
+            initData.properties->setProperty("IceSSL.Trace.Security", "1");
+            if(*ciphers[i])
+            {
+                initData.properties->setProperty("IceSSL.Protocols", "tls1_2");
+                initData.properties->setProperty("IceSSL.Ciphers", ciphers[i]);
+            }
+            initData.logger = logger;
+            CommunicatorPtr comm = initialize(initData);
+            Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+            Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "");
+            d["IceSSL.VerifyPeer"] = "0";
+            d["IceSSL.KTLS"] = "1";
+            Test::ServerPrxPtr server = fact->createServer(d);
+            for(int j = 0; j < 10; ++j)
+            {
+                server->ice_ping();
+            }
+            if(*ciphers[i])
+            {
+                server->checkCipher(ciphers[i]);
+            }
+
+            vector<string> offload = logger->offload();
+            if(logger->unsupported())
+            {
+                test(offload.empty());
+            }
+            else
+            {
+                test(offload.size() == 1); // The server connection, the factory uses tcp
+                if(*ciphers[i])
+                {
+                    test(offload.back() == "none");
+                }
+                else
+                {
+                    test(offload.back() == "none" || offload.back().find("send") == 0);
+                }
+            }
+            fact->destroyServer(server);
+            comm->destroy();
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing session resumption... " << flush;
+    {
+        //
+        // A client with a single entry session cache connects to two servers:
+        // the connections resume the session of the last connection to the same
+        // server, the connection to the other server evicts it. With TLS 1.3,
+        // the ticket of the previous connection is replaced by the tickets the
+        // server sent to the resumed connection.
+        //
+        const char* protocols[] = { "tls1_2", "tls1_3" };
+        for(int i = 0; i < 2; ++i)
+        {
+            auto logger = make_shared<SecurityLoggerI>();
+            InitializationData initData;
+            initData.properties = createClientProps(defaultProps, p12);
+            initData.properties->setProperty("IceSSL.VerifyPeer", "0");
+            initData.properties->setProperty("IceSSL.Protocols", protocols[i]);
+            initData.properties->setProperty("IceSSL.SessionCacheSize", "1");
+            initData.properties->setProperty("IceSSL.Trace.Security", "1");
+            initData.properties->setProperty("Ice.Admin.Enabled", "1");
+            initData.properties->setProperty("IceMX.Metrics.View.GroupBy", "id");
+            initData.logger = logger;
+            CommunicatorPtr comm = initialize(initData);
+
+            Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "");
+            d["IceSSL.VerifyPeer"] = "0";
+            d["IceSSL.Protocols"] = protocols[i];
+            Test::ServerPrxPtr servers[] = { factory->createServer(d), factory->createServer(d) };
+
+            const int connections[] = { 0, 0, 0, 1, 0, 0 };
+            const bool resumed[] = { false, true, true, false, false, true };
+            for(int j = 0; j < 6; ++j)
+            {
+                ostringstream id;
+                id << j;
+                Ice::ObjectPrxPtr prx = comm->stringToProxy(communicator->proxyToString(servers[connections[j]]));
+                prx->ice_connectionId(id.str())->ice_ping();
+                test(logger->resumed().size() == static_cast<size_t>(j + 1));
+                test(logger->resumed().back() == resumed[j]);
+            }
+
+            auto metrics = ICE_DYNAMIC_CAST(IceMX::MetricsAdmin, comm->findAdminFacet("Metrics"));
+            test(metrics);
+            long long timestamp;
+            IceMX::MetricsView view = metrics->getMetricsView("View", timestamp, Ice::emptyCurrent);
+            map<string, IceMX::MetricsPtr> sessions;
+            for(IceMX::MetricsMap::const_iterator p = view["SSLSession"].begin(); p != view["SSLSession"].end(); ++p)
+            {
+                sessions[(*p)->id] = *p;
+            }
+            test(sessions.size() == 2);
+            test(sessions["hit"]->total == 3 && sessions["hit"]->current == 0);
+            test(sessions["miss"]->total == 3 && sessions["miss"]->current == 0);
+
+            comm->destroy();
+            factory->destroyServer(servers[0]);
+            factory->destroyServer(servers[1]);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing key update and renegotiation... " << flush;
+    {
+        //
+        // A raw OpenSSL client updates the TLS 1.3 keys or renegotiates the TLS 1.2
+        // session between Ice requests. The server answers each key update request
+        // with its own key update, with IceSSL.KTLS its transceiver must send it with
+        // SSL_write before writing to the socket again.
+        //
+        const char* protocols[] = { "tls1_3", "tls1_2" };
+        for(int i = 0; i < 2; ++i)
+        {
+            Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "");
+            d["IceSSL.VerifyPeer"] = "0";
+            d["IceSSL.Protocols"] = protocols[i];
+            Test::ServerPrxPtr server = factory->createServer(d);
+
+            Ice::IPEndpointInfoPtr ipInfo;
+            for(Ice::EndpointInfoPtr p = server->ice_getEndpoints()[0]->getInfo(); p && !ipInfo; p = p->underlying)
+            {
+                ipInfo = ICE_DYNAMIC_CAST(Ice::IPEndpointInfo, p);
+            }
+            test(ipInfo);
+
+            SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+            SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, 0);
+            map<int, int> received;
+            SSL_CTX_set_msg_callback(ctx, countHandshakeMessages);
+            SSL_CTX_set_msg_callback_arg(ctx, &received);
+
+            SSL* ssl = connectWithSSL(ctx, ipInfo);
+            test(SSL_version(ssl) == (i == 0 ? TLS1_3_VERSION : TLS1_2_VERSION));
+            for(int j = 0; j < 5; ++j)
+            {
+                if(i == 0)
+                {
+                    if(j > 0)
+                    {
+                        test(SSL_key_update(ssl, SSL_KEY_UPDATE_REQUESTED) == 1);
+                    }
+                    test(pingWithSSL(communicator, ssl, server->ice_getIdentity(), j + 1));
+                    test(received[SSL3_MT_KEY_UPDATE] == j);
+                }
+                else
+                {
+                    if(j > 0)
+                    {
+                        test(SSL_renegotiate(ssl) == 1);
+                    }
+                    if(!pingWithSSL(communicator, ssl, server->ice_getIdentity(), j + 1))
+                    {
+                        //
+                        // OpenSSL 3 servers refuse client initiated renegotiation
+                        // by default. The connection fails but the server keeps
+                        // accepting new connections.
+                        //
+                        test(j > 0 && ERR_GET_REASON(ERR_peek_last_error()) == SSL_R_NO_RENEGOTIATION);
+                        ERR_clear_error();
+                        SSL_free(ssl);
+                        ssl = connectWithSSL(ctx, ipInfo);
+                        test(pingWithSSL(communicator, ssl, server->ice_getIdentity(), 1));
+                        break;
+                    }
+                    test(!SSL_renegotiate_pending(ssl));
+                    test(received[SSL3_MT_SERVER_HELLO] == j + 1);
+                }
+            }
+
+            SSL_free(ssl);
+            SSL_CTX_free(ctx);
+            factory->destroyServer(server);
+        }
+    }
+    cout << "ok" << endl;
+#endif
+
 #if !defined(_AIX) && !(defined(_WIN32) && defined(ICE_USE_OPENSSL))
     //
     // On AIX 6.1, the default root certificates don't validate demo.zeroc.com.
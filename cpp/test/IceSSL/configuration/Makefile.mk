@@ -11,6 +11,13 @@ ifneq ($(linux_id),)
     $(test)_cppflags += $(if $(filter yes,$(OPTIMIZE)),-fno-var-tracking-assignments)
 endif
 
+#
+# The key update and renegotiation tests use a raw OpenSSL client
+#
+ifneq ($(linux_id),)
+    $(test)_system_libs = $(IceSSL_system_libs)
+endif
+
 # Need to load certificates with functions from src/IceSSL/Util.h
 $(test)[iphoneos]_cppflags              := -Isrc
 $(test)[iphonesimulator]_cppflags       := -Isrc
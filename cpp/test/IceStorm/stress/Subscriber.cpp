@@ -169,6 +169,55 @@ private:
 
 atomic_int ErraticEventI::_remaining = 0;
 
+//
+// Many subscribers receiving the same events, each subscriber checks that it
+// receives the events in order. The communicator is shut down once all the
+// subscribers received all the events.
+//
+class FanOutEventI final : public EventI
+{
+public:
+
+    FanOutEventI(shared_ptr<Communicator> communicator, int total) :
+        EventI(move(communicator), total)
+    {
+        ++_remaining;
+    }
+
+    void
+    pub(int counter, const Ice::Current&) override
+    {
+        lock_guard<mutex> lg(_mutex);
+        if(counter != _count && !_failed)
+        {
+            cerr << "failed! expected event: " << _count << " received event: " << counter << endl;
+            _failed = true;
+        }
+
+        if(++_count == _total && --_remaining == 0)
+        {
+            _communicator->shutdown();
+        }
+    }
+
+    void
+    check(const Subscription&) override
+    {
+        lock_guard<mutex> lg(_mutex);
+        if(_failed)
+        {
+            throw invalid_argument("events received out of order");
+        }
+    }
+
+private:
+
+    static atomic_int _remaining;
+    bool _failed = false;
+};
+
+atomic_int FanOutEventI::_remaining = 0;
+
 class MaxQueueEventI final : public EventI
 {
 public:
@@ -278,6 +327,7 @@ Subscriber::run(int argc, char** argv)
     opts.addOpt("", "erratic", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "maxQueueDropEvents", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "maxQueueRemoveSub", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "fanout", IceUtilInternal::Options::NeedArg);
 
     try
     {
@@ -321,6 +371,7 @@ Subscriber::run(int argc, char** argv)
     bool slow = opts.isSet("slow");
     int maxQueueDropEvents = opts.isSet("maxQueueDropEvents") ? atoi(opts.optArg("maxQueueDropEvents").c_str()) : 0;
     int maxQueueRemoveSub = opts.isSet("maxQueueRemoveSub") ? atoi(opts.optArg("maxQueueRemoveSub").c_str()) : 0;
+    int fanout = opts.isSet("fanout") ? atoi(opts.optArg("fanout").c_str()) : 0;
     bool erratic = false;
     int erraticNum = 0;
     s = opts.optArg("erratic");
@@ -378,6 +429,18 @@ Subscriber::run(int argc, char** argv)
         item.qos = cmdLineQos;
         subs.push_back(item);
     }
+    else if(fanout > 0)
+    {
+        auto adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", "default");
+        for(int i = 0; i < fanout; ++i)
+        {
+            Subscription item;
+            item.adapter = adapter;
+            item.servant = make_shared<FanOutEventI>(communicator.communicator(), events);
+            item.qos = cmdLineQos;
+            subs.push_back(item);
+        }
+    }
     else if(maxQueueDropEvents || maxQueueRemoveSub)
     {
         Subscription item1;
@@ -138,6 +138,21 @@ class IceStormStressTestCase(IceStormTestCase):
             s.stop(current, True)
         current.writeln("ok")
 
+        #
+        # With publish workers, the subscribers are split in shards delivered
+        # by different threads. Each subscriber must still receive all the
+        # events in order.
+        #
+        current.write("Sending 1000 ordered events to 100 subscribers with publish workers... ")
+        opts = " --IceStorm.Publish.Workers=4"
+        for s in icestorm1:
+            s.start(current, args=opts.split(" "))
+        doTest(("TestIceStorm1", '--events 1000 --fanout 100 --qos "reliability,ordered"'), '--events 1000')
+        for s in icestorm1:
+            s.shutdown(current)
+            s.stop(current, True)
+        current.writeln("ok")
+
 TestSuite(__file__, [
 
     IceStormStressTestCase("persistent", icestorm=[IceStorm("TestIceStorm1", quiet=True),
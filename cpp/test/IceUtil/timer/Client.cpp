@@ -6,6 +6,7 @@
 #include <IceUtil/Random.h>
 #include <TestHelper.h>
 
+#include <limits>
 #include <vector>
 
 using namespace IceUtil;
@@ -147,6 +148,55 @@ private:
 };
 ICE_DEFINE_PTR(DestroyTaskPtr, DestroyTask);
 
+class CancelTask : public IceUtil::TimerTask, public std::enable_shared_from_this<CancelTask>,
+                   IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    CancelTask(const IceUtil::TimerPtr& timer, int count) : _timer(timer), _count(count), _run(0)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        Lock sync(*this);
+        if(++_run == _count)
+        {
+            test(_timer->cancel(shared_from_this()));
+            notify();
+        }
+    }
+
+    int
+    waitForCancel()
+    {
+        Lock sync(*this);
+        while(_run < _count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(10)))
+            {
+                test(false); // Timeout.
+            }
+        }
+        return _run;
+    }
+
+    int
+    getCount() const
+    {
+        Lock sync(*this);
+        return _run;
+    }
+
+private:
+
+    IceUtil::TimerPtr _timer;
+    const int _count;
+    int _run;
+};
+ICE_DEFINE_PTR(CancelTaskPtr, CancelTask);
+
 class Client : public Test::TestHelper
 {
 public:
@@ -243,6 +293,157 @@ Client::run(int, char*[])
     }
     cout << "ok" << endl;
 
+    cout << "testing timer wheel levels... " << flush;
+    {
+        IceUtil::TimerPtr timer = new IceUtil::Timer();
+
+        //
+        // Delays around the boundaries of the first wheel levels (64ms and
+        // 4096ms), the tasks must not run before their scheduled time and
+        // must run in order.
+        //
+        vector<TestTaskPtr> tasks;
+        const int delays[] = { 1, 2, 63, 64, 65, 127, 128, 129, 500, 1000, 4095, 4096, 4097 };
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i)
+        {
+            tasks.push_back(std::make_shared<TestTask>(IceUtil::Time::milliSeconds(delays[i])));
+        }
+
+        IceUtilInternal::shuffle(tasks.begin(), tasks.end());
+        vector<TestTaskPtr>::const_iterator p;
+        for(p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            timer->schedule(*p, (*p)->getScheduledTime());
+        }
+
+        for(p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            (*p)->waitForRun();
+            test((*p)->getRunTime() - start >= (*p)->getScheduledTime());
+            test((*p)->getCount() == 1);
+        }
+
+        sort(tasks.begin(), tasks.end(), TargetLess<shared_ptr<TestTask>>());
+        for(p = tasks.begin(); p + 1 != tasks.end(); ++p)
+        {
+            test((*p)->getRunTime() <= (*(p + 1))->getRunTime());
+        }
+
+        timer->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing timer cancel and reschedule... " << flush;
+    {
+        IceUtil::TimerPtr timer = new IceUtil::Timer();
+
+        {
+            //
+            // Reschedule a canceled task with a shorter and a longer delay.
+            //
+            TestTaskPtr task = std::make_shared<TestTask>();
+            timer->schedule(task, IceUtil::Time::seconds(10));
+            test(timer->cancel(task));
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            timer->schedule(task, IceUtil::Time::milliSeconds(50));
+            task->waitForRun();
+            test(task->getRunTime() - start >= IceUtil::Time::milliSeconds(50));
+            test(task->getCount() == 1);
+            test(!timer->cancel(task));
+
+            task->clear();
+            timer->schedule(task, IceUtil::Time::milliSeconds(10));
+            test(timer->cancel(task));
+            timer->schedule(task, IceUtil::Time::milliSeconds(200));
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+            test(!task->hasRun());
+            task->waitForRun();
+            test(task->getCount() == 1);
+        }
+
+        {
+            //
+            // Cancel half of many tasks scheduled in the same slots.
+            //
+            vector<TestTaskPtr> tasks;
+            for(int i = 0; i < 200; ++i)
+            {
+                tasks.push_back(std::make_shared<TestTask>());
+                timer->schedule(tasks.back(), IceUtil::Time::milliSeconds(100 + i % 10));
+            }
+            for(size_t i = 0; i < tasks.size(); i += 2)
+            {
+                test(timer->cancel(tasks[i]));
+            }
+            for(size_t i = 1; i < tasks.size(); i += 2)
+            {
+                tasks[i]->waitForRun();
+            }
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+            for(size_t i = 0; i < tasks.size(); ++i)
+            {
+                test(tasks[i]->getCount() == (i % 2 ? 1 : 0));
+            }
+        }
+
+        {
+            //
+            // A repeated task canceling itself doesn't run again.
+            //
+            CancelTaskPtr task = std::make_shared<CancelTask>(timer, 3);
+            timer->scheduleRepeated(task, IceUtil::Time::milliSeconds(10));
+            test(task->waitForCancel() == 3);
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+            test(task->getCount() == 3);
+            test(!timer->cancel(task));
+
+            //
+            // A canceled repeated task can be scheduled again.
+            //
+            TestTaskPtr repeated = std::make_shared<TestTask>();
+            timer->scheduleRepeated(repeated, IceUtil::Time::milliSeconds(10));
+            repeated->waitForRun();
+            test(timer->cancel(repeated));
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(50));
+            repeated->clear();
+            timer->scheduleRepeated(repeated, IceUtil::Time::milliSeconds(10));
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+            test(repeated->getCount() > 1);
+            test(timer->cancel(repeated));
+        }
+
+        {
+            //
+            // Huge delays are beyond the range of the wheel, the tasks must not
+            // run and must be cancelable. The timer must keep running the other
+            // tasks.
+            //
+            const IceUtil::Time max = IceUtil::Time::microSeconds(numeric_limits<IceUtil::Int64>::max()) -
+                IceUtil::Time::now(IceUtil::Time::Monotonic) - IceUtil::Time::seconds(1);
+            TestTaskPtr task = std::make_shared<TestTask>();
+            TestTaskPtr repeated = std::make_shared<TestTask>();
+            timer->schedule(task, max);
+            timer->scheduleRepeated(repeated, max / 2);
+
+            TestTaskPtr other = std::make_shared<TestTask>();
+            timer->schedule(other, IceUtil::Time::milliSeconds(10));
+            other->waitForRun();
+
+            test(!task->hasRun() && !repeated->hasRun());
+            test(timer->cancel(task));
+            test(timer->cancel(repeated));
+            test(!timer->cancel(task));
+
+            other->clear();
+            timer->schedule(other, IceUtil::Time::milliSeconds(10));
+            other->waitForRun();
+        }
+
+        timer->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "testing timer destroy... " << flush;
     {
         {
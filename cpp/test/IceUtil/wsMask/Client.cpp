@@ -0,0 +1,138 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/WSTransceiver.h>
+#include <TestHelper.h>
+
+#include <random>
+
+using namespace std;
+
+namespace
+{
+
+//
+// The byte by byte masking of the WebSocket specification.
+//
+void
+applyMaskScalar(Ice::Byte* dst, const Ice::Byte* src, size_t n, const unsigned char* mask, size_t offset)
+{
+    for(size_t i = 0; i < n; ++i)
+    {
+        dst[i] = src[i] ^ mask[(offset + i) % 4];
+    }
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    virtual void run(int argc, char* argv[]);
+};
+
+void
+Client::run(int, char*[])
+{
+    mt19937 rng(1234);
+    uniform_int_distribution<int> byte(0, 255);
+
+    const unsigned char mask[4] = { 0x37, 0xfa, 0x21, 0x3d };
+    vector<Ice::Byte> data(1024 + 64);
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<Ice::Byte>(byte(rng));
+    }
+
+    cout << "testing masking at unaligned offsets... " << flush;
+    {
+        //
+        // The source and destination start at any alignment, the lengths cover
+        // the vector blocks, the 8 bytes blocks and the remaining bytes, and
+        // the mask offset covers the 4 key rotations.
+        //
+        const size_t lengths[] = { 0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 63, 64, 65, 100, 255, 1024 };
+        for(size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+        {
+            const size_t n = lengths[l];
+            for(size_t srcOff = 0; srcOff < 32; ++srcOff)
+            {
+                for(size_t dstOff = 0; dstOff < 32; dstOff += 5)
+                {
+                    for(size_t offset = 0; offset < 9; ++offset)
+                    {
+                        vector<Ice::Byte> expected(n + 32, 0xAB);
+                        vector<Ice::Byte> result(n + 64, 0xAB);
+                        applyMaskScalar(&expected[0], &data[srcOff], n, mask, offset);
+                        IceInternal::applyMask(&result[dstOff], &data[srcOff], n, mask, offset);
+                        test(equal(expected.begin(), expected.begin() + static_cast<ptrdiff_t>(n),
+                                   result.begin() + static_cast<ptrdiff_t>(dstOff)));
+
+                        //
+                        // The bytes around the destination are not modified.
+                        //
+                        for(size_t i = 0; i < dstOff; ++i)
+                        {
+                            test(result[i] == 0xAB);
+                        }
+                        for(size_t i = dstOff + n; i < result.size(); ++i)
+                        {
+                            test(result[i] == 0xAB);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing masking in place... " << flush;
+    {
+        for(size_t n = 0; n < 200; ++n)
+        {
+            for(size_t off = 0; off < 16; ++off)
+            {
+                vector<Ice::Byte> expected(data.begin(), data.end());
+                vector<Ice::Byte> result(data.begin(), data.end());
+                applyMaskScalar(&expected[off], &expected[off], n, mask, n + off);
+                IceInternal::applyMask(&result[off], &result[off], n, mask, n + off);
+                test(expected == result);
+
+                //
+                // Masking twice restores the data.
+                //
+                IceInternal::applyMask(&result[off], &result[off], n, mask, n + off);
+                test(result == data);
+            }
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing masking in chunks... " << flush;
+    {
+        //
+        // Masking a payload in chunks of any size with the payload offset of
+        // each chunk gives the same result as masking the whole payload.
+        //
+        vector<Ice::Byte> expected(data.size());
+        applyMaskScalar(&expected[0], &data[0], data.size(), mask, 0);
+        uniform_int_distribution<size_t> chunk(1, 70);
+        for(int i = 0; i < 100; ++i)
+        {
+            vector<Ice::Byte> result(data.size());
+            size_t pos = 0;
+            while(pos < data.size())
+            {
+                size_t n = min(chunk(rng), data.size() - pos);
+                IceInternal::applyMask(&result[pos], &data[pos], n, mask, pos);
+                pos += n;
+            }
+            test(expected == result);
+        }
+    }
+    cout << "ok" << endl;
+}
+
+DEFINE_TEST(Client)
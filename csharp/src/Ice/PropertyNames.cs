@@ -1,6 +1,6 @@
 // Copyright (c) ZeroC, Inc. All rights reserved.
 
-// Generated by makeprops.py from file config/PropertyNames.xml, Mon Oct 12 15:41:02 2020
+// Generated by makeprops.py from file config/PropertyNames.xml, Sat Oct 17 03:02:15 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -57,6 +57,7 @@ namespace ZeroC.Ice
              new (@"^Ice\.Admin\.Router\.Router$"),
              new (@"^Ice\.Admin\.Router$"),
              new (@"^Ice\.Admin\.ProxyOptions$"),
+             new (@"^Ice\.Admin\.ThreadPool\.EventLoops$"),
              new (@"^Ice\.Admin\.ThreadPool\.Size$"),
              new (@"^Ice\.Admin\.ThreadPool\.SizeMax$"),
              new (@"^Ice\.Admin\.ThreadPool\.SizeWarn$"),
@@ -80,9 +81,16 @@ namespace ZeroC.Ice
              new (@"^Ice\.ClassGraphDepthMax$"),
              new (@"^Ice\.ClientAccessPolicyProtocol$"),
              new (@"^Ice\.CloseTimeout$"),
+             new (@"^Ice\.Compression\.Codecs$"),
+             new (@"^Ice\.Compression\.Level$"),
+             new (@"^Ice\.Compression\.LZ4\.Acceleration$"),
+             new (@"^Ice\.Compression\.Zstd\.Dictionary$"),
+             new (@"^Ice\.Compression\.Zstd\.Level$"),
              new (@"^Ice\.CompressionLevel$"),
              new (@"^Ice\.CompressionMinSize$"),
+             new (@"^Ice\.ConnectAttemptDelay$"),
              new (@"^Ice\.ConnectTimeout$"),
+             new (@"^Ice\.ConnectionPoolSize$"),
              new (@"^Ice\.CollectObjects$"),
              new (@"^Ice\.Config$"),
              new (@"^Ice\.ConsoleListener$"),
@@ -132,9 +140,12 @@ namespace ZeroC.Ice
              new (@"^Ice\.InitPlugins$"),
              new (@"^Ice\.IPv4$"),
              new (@"^Ice\.IPv6$"),
+             new (@"^Ice\.LocatorCacheRefreshThreshold$"),
              new (@"^Ice\.LogFile$"),
              new (@"^Ice\.LogFile\.SizeMax$"),
              new (@"^Ice\.LogStdErr\.Convert$"),
+             new (@"^Ice\.MessageBufferPool\.CacheSize$"),
+             new (@"^Ice\.MessageBufferPool\.SizeMax$"),
              new (@"^Ice\.MessageSizeMax$"),
              new (@"^Ice\.Nohup$"),
              new (@"^Ice\.NullHandleAbort$"),
@@ -161,6 +172,7 @@ namespace ZeroC.Ice
              new (@"^Ice\.StdErr$"),
              new (@"^Ice\.StdOut$"),
              new (@"^Ice\.SyslogFacility$"),
+             new (@"^Ice\.ThreadPool\.Client\.EventLoops$"),
              new (@"^Ice\.ThreadPool\.Client\.Size$"),
              new (@"^Ice\.ThreadPool\.Client\.SizeMax$"),
              new (@"^Ice\.ThreadPool\.Client\.SizeWarn$"),
@@ -168,6 +180,7 @@ namespace ZeroC.Ice
              new (@"^Ice\.ThreadPool\.Client\.Serialize$"),
              new (@"^Ice\.ThreadPool\.Client\.ThreadIdleTime$"),
              new (@"^Ice\.ThreadPool\.Client\.ThreadPriority$"),
+             new (@"^Ice\.ThreadPool\.Server\.EventLoops$"),
              new (@"^Ice\.ThreadPool\.Server\.Size$"),
              new (@"^Ice\.ThreadPool\.Server\.SizeMax$"),
              new (@"^Ice\.ThreadPool\.Server\.SizeWarn$"),
@@ -176,6 +189,7 @@ namespace ZeroC.Ice
              new (@"^Ice\.ThreadPool\.Server\.ThreadIdleTime$"),
              new (@"^Ice\.ThreadPool\.Server\.ThreadPriority$"),
              new (@"^Ice\.ThreadPriority$"),
+             new (@"^Ice\.TimerThreads$"),
              new (@"^Ice\.ToStringMode$"),
              new (@"^Ice\.Trace\.Admin\.Properties$"),
              new (@"^Ice\.Trace\.Admin\.Logger$"),
@@ -186,6 +200,8 @@ namespace ZeroC.Ice
              new (@"^Ice\.Trace\.Slicing$"),
              new (@"^Ice\.Trace\.ThreadPool$"),
              new (@"^Ice\.Trace\.Transport$"),
+             new (@"^Ice\.UDP\.GSO$"),
+             new (@"^Ice\.UDP\.RcvBatch$"),
              new (@"^Ice\.UDP\.RcvSize$"),
              new (@"^Ice\.UDP\.SndSize$"),
              new (@"^Ice\.TCP\.Backlog$"),
@@ -210,10 +226,12 @@ namespace ZeroC.Ice
         internal static readonly Property[] IceMXProps =
         {
              new (@"^IceMX\.Metrics\.[^\s]+\.GroupBy$"),
+             new (@"^IceMX\.Metrics\.[^\s]+\.Histogram$"),
              new (@"^IceMX\.Metrics\.[^\s]+\.Map$"),
              new (@"^IceMX\.Metrics\.[^\s]+\.RetainDetached$"),
              new (@"^IceMX\.Metrics\.[^\s]+\.Accept$"),
              new (@"^IceMX\.Metrics\.[^\s]+\.Reject$"),
+             new (@"^IceMX\.Metrics\.[^\s]+\.Shards$"),
              new (@"^IceMX\.Metrics\.[^\s]+$"),
         };
 
@@ -251,6 +269,7 @@ namespace ZeroC.Ice
              new (@"^IceDiscovery\.Multicast\.Router\.Router$"),
              new (@"^IceDiscovery\.Multicast\.Router$"),
              new (@"^IceDiscovery\.Multicast\.ProxyOptions$"),
+             new (@"^IceDiscovery\.Multicast\.ThreadPool\.EventLoops$"),
              new (@"^IceDiscovery\.Multicast\.ThreadPool\.Size$"),
              new (@"^IceDiscovery\.Multicast\.ThreadPool\.SizeMax$"),
              new (@"^IceDiscovery\.Multicast\.ThreadPool\.SizeWarn$"),
@@ -291,6 +310,7 @@ namespace ZeroC.Ice
              new (@"^IceDiscovery\.Reply\.Router\.Router$"),
              new (@"^IceDiscovery\.Reply\.Router$"),
              new (@"^IceDiscovery\.Reply\.ProxyOptions$"),
+             new (@"^IceDiscovery\.Reply\.ThreadPool\.EventLoops$"),
              new (@"^IceDiscovery\.Reply\.ThreadPool\.Size$"),
              new (@"^IceDiscovery\.Reply\.ThreadPool\.SizeMax$"),
              new (@"^IceDiscovery\.Reply\.ThreadPool\.SizeWarn$"),
@@ -331,6 +351,7 @@ namespace ZeroC.Ice
              new (@"^IceDiscovery\.Locator\.Router\.Router$"),
              new (@"^IceDiscovery\.Locator\.Router$"),
              new (@"^IceDiscovery\.Locator\.ProxyOptions$"),
+             new (@"^IceDiscovery\.Locator\.ThreadPool\.EventLoops$"),
              new (@"^IceDiscovery\.Locator\.ThreadPool\.Size$"),
              new (@"^IceDiscovery\.Locator\.ThreadPool\.SizeMax$"),
              new (@"^IceDiscovery\.Locator\.ThreadPool\.SizeWarn$"),
@@ -383,6 +404,7 @@ namespace ZeroC.Ice
              new (@"^IceLocatorDiscovery\.Reply\.Router\.Router$"),
              new (@"^IceLocatorDiscovery\.Reply\.Router$"),
              new (@"^IceLocatorDiscovery\.Reply\.ProxyOptions$"),
+             new (@"^IceLocatorDiscovery\.Reply\.ThreadPool\.EventLoops$"),
              new (@"^IceLocatorDiscovery\.Reply\.ThreadPool\.Size$"),
              new (@"^IceLocatorDiscovery\.Reply\.ThreadPool\.SizeMax$"),
              new (@"^IceLocatorDiscovery\.Reply\.ThreadPool\.SizeWarn$"),
@@ -423,6 +445,7 @@ namespace ZeroC.Ice
              new (@"^IceLocatorDiscovery\.Locator\.Router\.Router$"),
              new (@"^IceLocatorDiscovery\.Locator\.Router$"),
              new (@"^IceLocatorDiscovery\.Locator\.ProxyOptions$"),
+             new (@"^IceLocatorDiscovery\.Locator\.ThreadPool\.EventLoops$"),
              new (@"^IceLocatorDiscovery\.Locator\.ThreadPool\.Size$"),
              new (@"^IceLocatorDiscovery\.Locator\.ThreadPool\.SizeMax$"),
              new (@"^IceLocatorDiscovery\.Locator\.ThreadPool\.SizeWarn$"),
@@ -512,6 +535,7 @@ namespace ZeroC.Ice
              new (@"^IceBridge\.Source\.Router\.Router$"),
              new (@"^IceBridge\.Source\.Router$"),
              new (@"^IceBridge\.Source\.ProxyOptions$"),
+             new (@"^IceBridge\.Source\.ThreadPool\.EventLoops$"),
              new (@"^IceBridge\.Source\.ThreadPool\.Size$"),
              new (@"^IceBridge\.Source\.ThreadPool\.SizeMax$"),
              new (@"^IceBridge\.Source\.ThreadPool\.SizeWarn$"),
@@ -566,6 +590,7 @@ namespace ZeroC.Ice
              new (@"^IceGridAdmin\.Server\.Router\.Router$"),
              new (@"^IceGridAdmin\.Server\.Router$"),
              new (@"^IceGridAdmin\.Server\.ProxyOptions$"),
+             new (@"^IceGridAdmin\.Server\.ThreadPool\.EventLoops$"),
              new (@"^IceGridAdmin\.Server\.ThreadPool\.Size$"),
              new (@"^IceGridAdmin\.Server\.ThreadPool\.SizeMax$"),
              new (@"^IceGridAdmin\.Server\.ThreadPool\.SizeWarn$"),
@@ -609,6 +634,7 @@ namespace ZeroC.Ice
              new (@"^IceGridAdmin\.Discovery\.Reply\.Router\.Router$"),
              new (@"^IceGridAdmin\.Discovery\.Reply\.Router$"),
              new (@"^IceGridAdmin\.Discovery\.Reply\.ProxyOptions$"),
+             new (@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.EventLoops$"),
              new (@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.Size$"),
              new (@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.SizeMax$"),
              new (@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.SizeWarn$"),
@@ -649,6 +675,7 @@ namespace ZeroC.Ice
              new (@"^IceGridAdmin\.Discovery\.Locator\.Router\.Router$"),
              new (@"^IceGridAdmin\.Discovery\.Locator\.Router$"),
              new (@"^IceGridAdmin\.Discovery\.Locator\.ProxyOptions$"),
+             new (@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.EventLoops$"),
              new (@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.Size$"),
              new (@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.SizeMax$"),
              new (@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.SizeWarn$"),
@@ -695,6 +722,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.AdminRouter\.Router\.Router$"),
              new (@"^IceGrid\.AdminRouter\.Router$"),
              new (@"^IceGrid\.AdminRouter\.ProxyOptions$"),
+             new (@"^IceGrid\.AdminRouter\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.AdminRouter\.ThreadPool\.Size$"),
              new (@"^IceGrid\.AdminRouter\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.AdminRouter\.ThreadPool\.SizeWarn$"),
@@ -736,6 +764,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.Node\.Router\.Router$"),
              new (@"^IceGrid\.Node\.Router$"),
              new (@"^IceGrid\.Node\.ProxyOptions$"),
+             new (@"^IceGrid\.Node\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.Node\.ThreadPool\.Size$"),
              new (@"^IceGrid\.Node\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.Node\.ThreadPool\.SizeWarn$"),
@@ -819,6 +848,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.Registry\.AdminSessionManager\.Router\.Router$"),
              new (@"^IceGrid\.Registry\.AdminSessionManager\.Router$"),
              new (@"^IceGrid\.Registry\.AdminSessionManager\.ProxyOptions$"),
+             new (@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.Size$"),
              new (@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.SizeWarn$"),
@@ -870,6 +900,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.Registry\.Client\.Router\.Router$"),
              new (@"^IceGrid\.Registry\.Client\.Router$"),
              new (@"^IceGrid\.Registry\.Client\.ProxyOptions$"),
+             new (@"^IceGrid\.Registry\.Client\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.Registry\.Client\.ThreadPool\.Size$"),
              new (@"^IceGrid\.Registry\.Client\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.Registry\.Client\.ThreadPool\.SizeWarn$"),
@@ -912,6 +943,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.Registry\.Discovery\.Router\.Router$"),
              new (@"^IceGrid\.Registry\.Discovery\.Router$"),
              new (@"^IceGrid\.Registry\.Discovery\.ProxyOptions$"),
+             new (@"^IceGrid\.Registry\.Discovery\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.Registry\.Discovery\.ThreadPool\.Size$"),
              new (@"^IceGrid\.Registry\.Discovery\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.Registry\.Discovery\.ThreadPool\.SizeWarn$"),
@@ -957,6 +989,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.Registry\.Internal\.Router\.Router$"),
              new (@"^IceGrid\.Registry\.Internal\.Router$"),
              new (@"^IceGrid\.Registry\.Internal\.ProxyOptions$"),
+             new (@"^IceGrid\.Registry\.Internal\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.Registry\.Internal\.ThreadPool\.Size$"),
              new (@"^IceGrid\.Registry\.Internal\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.Registry\.Internal\.ThreadPool\.SizeWarn$"),
@@ -1015,6 +1048,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.Registry\.Server\.Router\.Router$"),
              new (@"^IceGrid\.Registry\.Server\.Router$"),
              new (@"^IceGrid\.Registry\.Server\.ProxyOptions$"),
+             new (@"^IceGrid\.Registry\.Server\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.Registry\.Server\.ThreadPool\.Size$"),
              new (@"^IceGrid\.Registry\.Server\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.Registry\.Server\.ThreadPool\.SizeWarn$"),
@@ -1056,6 +1090,7 @@ namespace ZeroC.Ice
              new (@"^IceGrid\.Registry\.SessionManager\.Router\.Router$"),
              new (@"^IceGrid\.Registry\.SessionManager\.Router$"),
              new (@"^IceGrid\.Registry\.SessionManager\.ProxyOptions$"),
+             new (@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.EventLoops$"),
              new (@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.Size$"),
              new (@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.SizeMax$"),
              new (@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.SizeWarn$"),
@@ -1118,6 +1153,7 @@ namespace ZeroC.Ice
              new (@"^IceSSL\.Keystore$"),
              new (@"^IceSSL\.KeystorePassword$"),
              new (@"^IceSSL\.KeystoreType$"),
+             new (@"^IceSSL\.KTLS$"),
              new (@"^IceSSL\.Password$"),
              new (@"^IceSSL\.PasswordCallback$"),
              new (@"^IceSSL\.PasswordRetryMax$"),
@@ -1126,6 +1162,7 @@ namespace ZeroC.Ice
              new (@"^IceSSL\.ProtocolVersionMin$"),
              new (@"^IceSSL\.Random$"),
              new (@"^IceSSL\.SchannelStrongCrypto$"),
+             new (@"^IceSSL\.SessionCacheSize$"),
              new (@"^IceSSL\.Trace\.Security$"),
              new (@"^IceSSL\.TrustOnly$"),
              new (@"^IceSSL\.TrustOnly\.Client$"),
@@ -1187,6 +1224,7 @@ namespace ZeroC.Ice
              new (@"^Glacier2\.Client\.Router\.Router$"),
              new (@"^Glacier2\.Client\.Router$"),
              new (@"^Glacier2\.Client\.ProxyOptions$"),
+             new (@"^Glacier2\.Client\.ThreadPool\.EventLoops$"),
              new (@"^Glacier2\.Client\.ThreadPool\.Size$"),
              new (@"^Glacier2\.Client\.ThreadPool\.SizeMax$"),
              new (@"^Glacier2\.Client\.ThreadPool\.SizeWarn$"),
@@ -1196,7 +1234,9 @@ namespace ZeroC.Ice
              new (@"^Glacier2\.Client\.ThreadPool\.ThreadPriority$"),
              new (@"^Glacier2\.Client\.MessageSizeMax$"),
              new (@"^Glacier2\.Client\.Buffered$"),
+             new (@"^Glacier2\.Client\.FlushThreshold$"),
              new (@"^Glacier2\.Client\.ForwardContext$"),
+             new (@"^Glacier2\.Client\.QueueThreads$"),
              new (@"^Glacier2\.Client\.SleepTime$"),
              new (@"^Glacier2\.Client\.Trace\.Override$"),
              new (@"^Glacier2\.Client\.Trace\.Reject$"),
@@ -1266,6 +1306,7 @@ namespace ZeroC.Ice
              new (@"^Glacier2\.Server\.Router\.Router$"),
              new (@"^Glacier2\.Server\.Router$"),
              new (@"^Glacier2\.Server\.ProxyOptions$"),
+             new (@"^Glacier2\.Server\.ThreadPool\.EventLoops$"),
              new (@"^Glacier2\.Server\.ThreadPool\.Size$"),
              new (@"^Glacier2\.Server\.ThreadPool\.SizeMax$"),
              new (@"^Glacier2\.Server\.ThreadPool\.SizeWarn$"),
@@ -1275,7 +1316,9 @@ namespace ZeroC.Ice
              new (@"^Glacier2\.Server\.ThreadPool\.ThreadPriority$"),
              new (@"^Glacier2\.Server\.MessageSizeMax$"),
              new (@"^Glacier2\.Server\.Buffered$"),
+             new (@"^Glacier2\.Server\.FlushThreshold$"),
              new (@"^Glacier2\.Server\.ForwardContext$"),
+             new (@"^Glacier2\.Server\.QueueThreads$"),
              new (@"^Glacier2\.Server\.SleepTime$"),
              new (@"^Glacier2\.Server\.Trace\.Override$"),
              new (@"^Glacier2\.Server\.Trace\.Request$"),
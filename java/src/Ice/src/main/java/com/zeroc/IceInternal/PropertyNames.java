@@ -1,6 +1,6 @@
 // Copyright (c) ZeroC, Inc. All rights reserved.
 
-// Generated by makeprops.py from file config/PropertyNames.xml, Mon Oct 12 15:41:02 2020
+// Generated by makeprops.py from file config/PropertyNames.xml, Sat Oct 17 03:02:15 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -57,6 +57,7 @@ public final class PropertyNames
         new Property("Ice\\.Admin\\.Router\\.Router", false, null),
         new Property("Ice\\.Admin\\.Router", false, null),
         new Property("Ice\\.Admin\\.ProxyOptions", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.EventLoops", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.Size", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.SizeMax", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.SizeWarn", false, null),
@@ -80,9 +81,16 @@ public final class PropertyNames
         new Property("Ice\\.ClassGraphDepthMax", false, null),
         new Property("Ice\\.ClientAccessPolicyProtocol", false, null),
         new Property("Ice\\.CloseTimeout", false, null),
+        new Property("Ice\\.Compression\\.Codecs", false, null),
+        new Property("Ice\\.Compression\\.Level", false, null),
+        new Property("Ice\\.Compression\\.LZ4\\.Acceleration", false, null),
+        new Property("Ice\\.Compression\\.Zstd\\.Dictionary", false, null),
+        new Property("Ice\\.Compression\\.Zstd\\.Level", false, null),
         new Property("Ice\\.CompressionLevel", false, null),
         new Property("Ice\\.CompressionMinSize", false, null),
+        new Property("Ice\\.ConnectAttemptDelay", false, null),
         new Property("Ice\\.ConnectTimeout", false, null),
+        new Property("Ice\\.ConnectionPoolSize", false, null),
         new Property("Ice\\.CollectObjects", false, null),
         new Property("Ice\\.Config", false, null),
         new Property("Ice\\.ConsoleListener", false, null),
@@ -132,9 +140,12 @@ public final class PropertyNames
         new Property("Ice\\.InitPlugins", false, null),
         new Property("Ice\\.IPv4", false, null),
         new Property("Ice\\.IPv6", false, null),
+        new Property("Ice\\.LocatorCacheRefreshThreshold", false, null),
         new Property("Ice\\.LogFile", false, null),
         new Property("Ice\\.LogFile\\.SizeMax", false, null),
         new Property("Ice\\.LogStdErr\\.Convert", false, null),
+        new Property("Ice\\.MessageBufferPool\\.CacheSize", false, null),
+        new Property("Ice\\.MessageBufferPool\\.SizeMax", false, null),
         new Property("Ice\\.MessageSizeMax", false, null),
         new Property("Ice\\.Nohup", false, null),
         new Property("Ice\\.NullHandleAbort", false, null),
@@ -161,6 +172,7 @@ public final class PropertyNames
         new Property("Ice\\.StdErr", false, null),
         new Property("Ice\\.StdOut", false, null),
         new Property("Ice\\.SyslogFacility", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.EventLoops", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.Size", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.SizeMax", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.SizeWarn", false, null),
@@ -168,6 +180,7 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Client\\.Serialize", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadPriority", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.EventLoops", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.Size", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeMax", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeWarn", false, null),
@@ -176,6 +189,7 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadPriority", false, null),
         new Property("Ice\\.ThreadPriority", false, null),
+        new Property("Ice\\.TimerThreads", false, null),
         new Property("Ice\\.ToStringMode", false, null),
         new Property("Ice\\.Trace\\.Admin\\.Properties", false, null),
         new Property("Ice\\.Trace\\.Admin\\.Logger", false, null),
@@ -186,6 +200,8 @@ public final class PropertyNames
         new Property("Ice\\.Trace\\.Slicing", false, null),
         new Property("Ice\\.Trace\\.ThreadPool", false, null),
         new Property("Ice\\.Trace\\.Transport", false, null),
+        new Property("Ice\\.UDP\\.GSO", false, null),
+        new Property("Ice\\.UDP\\.RcvBatch", false, null),
         new Property("Ice\\.UDP\\.RcvSize", false, null),
         new Property("Ice\\.UDP\\.SndSize", false, null),
         new Property("Ice\\.TCP\\.Backlog", false, null),
@@ -211,10 +227,12 @@ public final class PropertyNames
     public static final Property IceMXProps[] =
     {
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.GroupBy", false, null),
+        new Property("IceMX\\.Metrics\\.[^\\s]+\\.Histogram", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Map", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.RetainDetached", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Accept", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Reject", false, null),
+        new Property("IceMX\\.Metrics\\.[^\\s]+\\.Shards", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+", false, null),
         null
     };
@@ -253,6 +271,7 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Multicast\\.Router\\.Router", false, null),
         new Property("IceDiscovery\\.Multicast\\.Router", false, null),
         new Property("IceDiscovery\\.Multicast\\.ProxyOptions", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Size", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.SizeWarn", false, null),
@@ -293,6 +312,7 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Reply\\.Router\\.Router", false, null),
         new Property("IceDiscovery\\.Reply\\.Router", false, null),
         new Property("IceDiscovery\\.Reply\\.ProxyOptions", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Size", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
@@ -333,6 +353,7 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Locator\\.Router\\.Router", false, null),
         new Property("IceDiscovery\\.Locator\\.Router", false, null),
         new Property("IceDiscovery\\.Locator\\.ProxyOptions", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Size", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
@@ -386,6 +407,7 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Reply\\.Router\\.Router", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.Router", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ProxyOptions", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.Size", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
@@ -426,6 +448,7 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Locator\\.Router\\.Router", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.Router", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ProxyOptions", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.Size", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
@@ -518,6 +541,7 @@ public final class PropertyNames
         new Property("IceBridge\\.Source\\.Router\\.Router", false, null),
         new Property("IceBridge\\.Source\\.Router", false, null),
         new Property("IceBridge\\.Source\\.ProxyOptions", false, null),
+        new Property("IceBridge\\.Source\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.Size", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.SizeWarn", false, null),
@@ -573,6 +597,7 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Server\\.Router\\.Router", false, null),
         new Property("IceGridAdmin\\.Server\\.Router", false, null),
         new Property("IceGridAdmin\\.Server\\.ProxyOptions", false, null),
+        new Property("IceGridAdmin\\.Server\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.Size", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.SizeWarn", false, null),
@@ -616,6 +641,7 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.Router\\.Router", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.Router", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ProxyOptions", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Size", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
@@ -656,6 +682,7 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.Router\\.Router", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.Router", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ProxyOptions", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.Size", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
@@ -703,6 +730,7 @@ public final class PropertyNames
         new Property("IceGrid\\.AdminRouter\\.Router\\.Router", false, null),
         new Property("IceGrid\\.AdminRouter\\.Router", false, null),
         new Property("IceGrid\\.AdminRouter\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.SizeWarn", false, null),
@@ -744,6 +772,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Node\\.Router\\.Router", false, null),
         new Property("IceGrid\\.Node\\.Router", false, null),
         new Property("IceGrid\\.Node\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.SizeWarn", false, null),
@@ -827,6 +856,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Router\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.SizeWarn", false, null),
@@ -878,6 +908,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Client\\.Router\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.SizeWarn", false, null),
@@ -920,6 +951,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Discovery\\.Router\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.SizeWarn", false, null),
@@ -965,6 +997,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Internal\\.Router\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.SizeWarn", false, null),
@@ -1023,6 +1056,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Server\\.Router\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.SizeWarn", false, null),
@@ -1064,6 +1098,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.SessionManager\\.Router\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.Router", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ProxyOptions", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.EventLoops", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Size", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.SizeMax", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.SizeWarn", false, null),
@@ -1127,6 +1162,7 @@ public final class PropertyNames
         new Property("IceSSL\\.Keystore", false, null),
         new Property("IceSSL\\.KeystorePassword", false, null),
         new Property("IceSSL\\.KeystoreType", false, null),
+        new Property("IceSSL\\.KTLS", false, null),
         new Property("IceSSL\\.Password", false, null),
         new Property("IceSSL\\.PasswordCallback", false, null),
         new Property("IceSSL\\.PasswordRetryMax", false, null),
@@ -1135,6 +1171,7 @@ public final class PropertyNames
         new Property("IceSSL\\.ProtocolVersionMin", false, null),
         new Property("IceSSL\\.Random", false, null),
         new Property("IceSSL\\.SchannelStrongCrypto", false, null),
+        new Property("IceSSL\\.SessionCacheSize", false, null),
         new Property("IceSSL\\.Trace\\.Security", false, null),
         new Property("IceSSL\\.TrustOnly", false, null),
         new Property("IceSSL\\.TrustOnly\\.Client", false, null),
@@ -1199,6 +1236,7 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.Router\\.Router", false, null),
         new Property("Glacier2\\.Client\\.Router", false, null),
         new Property("Glacier2\\.Client\\.ProxyOptions", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.EventLoops", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.Size", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.SizeMax", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.SizeWarn", false, null),
@@ -1208,7 +1246,9 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("Glacier2\\.Client\\.MessageSizeMax", false, null),
         new Property("Glacier2\\.Client\\.Buffered", false, null),
+        new Property("Glacier2\\.Client\\.FlushThreshold", false, null),
         new Property("Glacier2\\.Client\\.ForwardContext", false, null),
+        new Property("Glacier2\\.Client\\.QueueThreads", false, null),
         new Property("Glacier2\\.Client\\.SleepTime", false, null),
         new Property("Glacier2\\.Client\\.Trace\\.Override", false, null),
         new Property("Glacier2\\.Client\\.Trace\\.Reject", false, null),
@@ -1278,6 +1318,7 @@ public final class PropertyNames
         new Property("Glacier2\\.Server\\.Router\\.Router", false, null),
         new Property("Glacier2\\.Server\\.Router", false, null),
         new Property("Glacier2\\.Server\\.ProxyOptions", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.EventLoops", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.Size", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.SizeMax", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.SizeWarn", false, null),
@@ -1287,7 +1328,9 @@ public final class PropertyNames
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("Glacier2\\.Server\\.MessageSizeMax", false, null),
         new Property("Glacier2\\.Server\\.Buffered", false, null),
+        new Property("Glacier2\\.Server\\.FlushThreshold", false, null),
         new Property("Glacier2\\.Server\\.ForwardContext", false, null),
+        new Property("Glacier2\\.Server\\.QueueThreads", false, null),
         new Property("Glacier2\\.Server\\.SleepTime", false, null),
         new Property("Glacier2\\.Server\\.Trace\\.Override", false, null),
         new Property("Glacier2\\.Server\\.Trace\\.Request", false, null),
@@ -1,6 +1,6 @@
 // Copyright (c) ZeroC, Inc. All rights reserved.
 
-// Generated by makeprops.py from file config/PropertyNames.xml, Mon Oct 12 15:41:02 2020
+// Generated by makeprops.py from file config/PropertyNames.xml, Sat Oct 17 03:02:15 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -60,6 +60,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.Router\.Router/", false, null),
     new Property("/^Ice\.Admin\.Router/", false, null),
     new Property("/^Ice\.Admin\.ProxyOptions/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.EventLoops/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.Size/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.SizeMax/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.SizeWarn/", false, null),
@@ -83,9 +84,16 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ClassGraphDepthMax/", false, null),
     new Property("/^Ice\.ClientAccessPolicyProtocol/", false, null),
     new Property("/^Ice\.CloseTimeout/", false, null),
+    new Property("/^Ice\.Compression\.Codecs/", false, null),
+    new Property("/^Ice\.Compression\.Level/", false, null),
+    new Property("/^Ice\.Compression\.LZ4\.Acceleration/", false, null),
+    new Property("/^Ice\.Compression\.Zstd\.Dictionary/", false, null),
+    new Property("/^Ice\.Compression\.Zstd\.Level/", false, null),
     new Property("/^Ice\.CompressionLevel/", false, null),
     new Property("/^Ice\.CompressionMinSize/", false, null),
+    new Property("/^Ice\.ConnectAttemptDelay/", false, null),
     new Property("/^Ice\.ConnectTimeout/", false, null),
+    new Property("/^Ice\.ConnectionPoolSize/", false, null),
     new Property("/^Ice\.CollectObjects/", false, null),
     new Property("/^Ice\.Config/", false, null),
     new Property("/^Ice\.ConsoleListener/", false, null),
@@ -135,9 +143,12 @@ PropertyNames.IceProps =
     new Property("/^Ice\.InitPlugins/", false, null),
     new Property("/^Ice\.IPv4/", false, null),
     new Property("/^Ice\.IPv6/", false, null),
+    new Property("/^Ice\.LocatorCacheRefreshThreshold/", false, null),
     new Property("/^Ice\.LogFile/", false, null),
     new Property("/^Ice\.LogFile\.SizeMax/", false, null),
     new Property("/^Ice\.LogStdErr\.Convert/", false, null),
+    new Property("/^Ice\.MessageBufferPool\.CacheSize/", false, null),
+    new Property("/^Ice\.MessageBufferPool\.SizeMax/", false, null),
     new Property("/^Ice\.MessageSizeMax/", false, null),
     new Property("/^Ice\.Nohup/", false, null),
     new Property("/^Ice\.NullHandleAbort/", false, null),
@@ -164,6 +175,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.StdErr/", false, null),
     new Property("/^Ice\.StdOut/", false, null),
     new Property("/^Ice\.SyslogFacility/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.EventLoops/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.Size/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.SizeMax/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.SizeWarn/", false, null),
@@ -171,6 +183,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Client\.Serialize/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadPriority/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.EventLoops/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Size/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeMax/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeWarn/", false, null),
@@ -179,6 +192,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Server\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadPriority/", false, null),
     new Property("/^Ice\.ThreadPriority/", false, null),
+    new Property("/^Ice\.TimerThreads/", false, null),
     new Property("/^Ice\.ToStringMode/", false, null),
     new Property("/^Ice\.Trace\.Admin\.Properties/", false, null),
     new Property("/^Ice\.Trace\.Admin\.Logger/", false, null),
@@ -189,6 +203,8 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Trace\.Slicing/", false, null),
     new Property("/^Ice\.Trace\.ThreadPool/", false, null),
     new Property("/^Ice\.Trace\.Transport/", false, null),
+    new Property("/^Ice\.UDP\.GSO/", false, null),
+    new Property("/^Ice\.UDP\.RcvBatch/", false, null),
     new Property("/^Ice\.UDP\.RcvSize/", false, null),
     new Property("/^Ice\.UDP\.SndSize/", false, null),
     new Property("/^Ice\.TCP\.Backlog/", false, null),
@@ -26,8 +26,28 @@ traceProps = {
     "Ice.Trace.Retry": 1,
 }
 
+#
+# In buffered mode, the requests of a session are forwarded in the order they
+# are dispatched: the router dispatches the requests of a connection in order
+# with a serialized thread pool.
+#
 def buffered(enabled):
-    return { "Glacier2.Client.Buffered": enabled, "Glacier2.Server.Buffered": enabled }
+    props = { "Glacier2.Client.Buffered": enabled, "Glacier2.Server.Buffered": enabled }
+    if enabled:
+        props["Ice.ThreadPool.Server.Serialize"] = 1
+    return props
+
+def sharded():
+    props = buffered(True)
+    props.update({ "Glacier2.Client.QueueThreads": 4, "Glacier2.Server.QueueThreads": 4,
+                   "Glacier2.Client.SleepTime": 50, "Glacier2.Server.SleepTime": 50,
+                   "Glacier2.Client.FlushThreshold": 10, "Glacier2.Server.FlushThreshold": 10 })
+    return props
+
+def threshold():
+    props = sharded()
+    props.update({ "Glacier2.Client.SleepTime": 3000, "Glacier2.Server.SleepTime": 3000 })
+    return props
 
 Glacier2TestSuite(__name__, routerProps, [
                   ClientServerTestCase(name="client/server with router in unbuffered mode",
@@ -36,5 +56,13 @@ Glacier2TestSuite(__name__, routerProps, [
                                        traceProps=traceProps),
                   ClientServerTestCase(name="client/server with router in buffered mode",
                                        servers=[Glacier2Router(passwords=passwords, props=buffered(True)), Server()],
-                                       clients=[Client(), Client(args=["--shutdown"])],
+                                       clients=[Client(args=["--ordered"]), Client(args=["--shutdown"])],
+                                       traceProps=traceProps),
+                  ClientServerTestCase(name="client/server with router in buffered mode with several queue threads",
+                                       servers=[Glacier2Router(passwords=passwords, props=sharded()), Server()],
+                                       clients=[Client(args=["--ordered"]), Client(args=["--shutdown"])],
+                                       traceProps=traceProps),
+                  ClientServerTestCase(name="client/server with router in buffered mode with flush threshold",
+                                       servers=[Glacier2Router(passwords=passwords, props=threshold()), Server()],
+                                       client=Client(args=["--threshold"]),
                                        traceProps=traceProps)])
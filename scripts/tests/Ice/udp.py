@@ -23,4 +23,14 @@ class UdpTestCase(ClientServerTestCase):
 #
 options=lambda current: { "transport": ["tcp", "ws"] } if current.config.uwp else {}
 
-TestSuite(__name__, [ UdpTestCase() ], multihost=False, options=options)
+testcases = [ UdpTestCase() ]
+
+#
+# With C++, also run with batched datagram receive (recvmmsg) and segmentation
+# offload (UDP_SEGMENT) enabled, the properties are ignored where unsupported.
+#
+if isinstance(Mapping.getByPath(__name__), CppMapping):
+    testcases.append(UdpTestCase(name="client/server with batched datagram I/O",
+                                 props={ "Ice.UDP.RcvBatch": 16, "Ice.UDP.GSO": 1 }))
+
+TestSuite(__name__, testcases, multihost=False, options=options)
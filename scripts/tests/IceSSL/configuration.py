@@ -83,7 +83,21 @@ outfilters = [ lambda x: re.sub("-! .* warning: deprecated property: IceSSL.KeyF
 #
 options=lambda current: { "transport": ["ssl", "wss"] } if current.config.uwp else {}
 
-TestSuite(__name__, [
+testcases = [
    ConfigurationTestCase(client=IceSSLConfigurationClient(outfilters=outfilters, args=['"{testdir}"']),
                          server=IceSSLConfigurationServer(outfilters=outfilters, args=['"{testdir}"']))
-], multihost=False, options=options)
+]
+
+#
+# With C++ on Linux (OpenSSL), also run with kernel TLS offload enabled, the
+# client passes IceSSL.KTLS to the servers it creates.
+#
+if isinstance(Mapping.getByPath(__name__), CppMapping) and isinstance(platform, Linux):
+    testcases.append(ConfigurationTestCase(name="client/server with kernel TLS",
+                                           client=IceSSLConfigurationClient(outfilters=outfilters,
+                                                                            args=['"{testdir}"'],
+                                                                            props={ "IceSSL.KTLS": 1 }),
+                                           server=IceSSLConfigurationServer(outfilters=outfilters,
+                                                                            args=['"{testdir}"'])))
+
+TestSuite(__name__, testcases, multihost=False, options=options)